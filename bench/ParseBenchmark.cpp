@@ -0,0 +1,484 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Micro benchmark for the parser and friends over a corpus of URIs,
+// one per line. Reports the best of several rounds per workload
+// so that numbers of two builds (e.g. with and without
+// URIPARSER_UNITY_BUILD) can be compared with little noise.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+struct Corpus {
+	std::vector<std::string> lines;  // one URI each
+	std::string text;  // all URIs, one per line
+	std::vector<UriUriA> uris;  // lines parsed, where possible
+	UriPublicSuffixList * psl;
+	std::vector<unsigned int> serialized;  // uris serialized, 4-byte aligned
+	UriCompressedSetA * set;  // lines, sorted
+#ifdef URI_ENABLE_CHAR16_T
+	std::vector<std::u16string> lines16;  // same as lines, as UTF-16
+#endif
+
+	Corpus() : psl(NULL), set(NULL) {}
+};
+
+
+
+typedef unsigned long (*Workload)(const Corpus & corpus);
+
+
+
+// Used unless environment variable URIPARSER_BENCHMARK_PSL names
+// a local copy of https://publicsuffix.org/list/public_suffix_list.dat
+const char * const defaultPublicSuffixRules =
+		"com\norg\nnet\nedu\ngov\nio\nde\nfr\njp\nuk\nco.uk\norg.uk\n"
+		"ac.jp\nco.jp\n*.kobe.jp\n!city.kobe.jp\n*.ck\n!www.ck\n"
+		"blogspot.com\ngithub.io\nappspot.com\ns3.amazonaws.com\n";
+
+
+
+unsigned long parse(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	for (size_t i = 0; i < corpus.lines.size(); i++) {
+		const char * const first = corpus.lines[i].c_str();
+		UriUriA uri;
+		if (uriParseSingleUriExA(&uri, first, first + corpus.lines[i].size(), NULL)
+				== URI_SUCCESS) {
+			checksum += (unsigned long)(uri.hostText.afterLast - uri.hostText.first);
+			uriFreeUriMembersA(&uri);
+		}
+	}
+	return checksum;
+}
+
+
+
+#ifdef URI_ENABLE_CHAR16_T
+unsigned long parseU16(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	for (size_t i = 0; i < corpus.lines16.size(); i++) {
+		const char16_t * const first = corpus.lines16[i].c_str();
+		UriUriU16 uri;
+		if (uriParseSingleUriExU16(&uri, first, first + corpus.lines16[i].size(), NULL)
+				== URI_SUCCESS) {
+			checksum += (unsigned long)(uri.hostText.afterLast - uri.hostText.first);
+			uriFreeUriMembersU16(&uri);
+		}
+	}
+	return checksum;
+}
+#endif
+
+
+
+unsigned long normalize(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	for (size_t i = 0; i < corpus.lines.size(); i++) {
+		const char * const first = corpus.lines[i].c_str();
+		UriUriA uri;
+		if (uriParseSingleUriExA(&uri, first, first + corpus.lines[i].size(), NULL)
+				== URI_SUCCESS) {
+			checksum += (unsigned long)uriNormalizeSyntaxA(&uri);
+			uriFreeUriMembersA(&uri);
+		}
+	}
+	return checksum;
+}
+
+
+
+unsigned long dissectQuery(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	for (size_t i = 0; i < corpus.lines.size(); i++) {
+		const char * const first = corpus.lines[i].c_str();
+		UriUriA uri;
+		if (uriParseSingleUriExA(&uri, first, first + corpus.lines[i].size(), NULL)
+				== URI_SUCCESS) {
+			if (uri.query.first != NULL) {
+				UriQueryListA * queryList = NULL;
+				int itemCount = 0;
+				if (uriDissectQueryMallocA(&queryList, &itemCount,
+						uri.query.first, uri.query.afterLast) == URI_SUCCESS) {
+					checksum += (unsigned long)itemCount;
+					uriFreeQueryListA(queryList);
+				}
+			}
+			uriFreeUriMembersA(&uri);
+		}
+	}
+	return checksum;
+}
+
+
+
+UriBool addHostLength(void * userData, const UriUriA * uri, const char *,
+		const char *, int errorCode, const char *) {
+	if (errorCode == URI_SUCCESS) {
+		*static_cast<unsigned long *>(userData)
+				+= (unsigned long)(uri->hostText.afterLast - uri->hostText.first);
+	}
+	return URI_TRUE;
+}
+
+
+
+unsigned long parseList(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	const char * const first = corpus.text.c_str();
+	uriParseUriListExA(first, first + corpus.text.size(), URI_LIST_LINES,
+			addHostLength, &checksum);
+	return checksum;
+}
+
+
+
+unsigned long registrableDomain(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	for (size_t i = 0; i < corpus.uris.size(); i++) {
+		UriTextRangeA domain;
+		if ((uriRegistrableDomainA(&corpus.uris[i], NULL, corpus.psl, &domain,
+				NULL) == URI_SUCCESS) && (domain.first != NULL)) {
+			checksum += (unsigned long)(domain.afterLast - domain.first);
+		}
+	}
+	return checksum;
+}
+
+
+
+unsigned long shardByOrigin(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	for (size_t i = 0; i < corpus.uris.size(); i++) {
+		UriUint64 hash;
+		if (uriOriginHashA(&corpus.uris[i], 0, &hash) == URI_SUCCESS) {
+			checksum += (unsigned long)uriJumpConsistentHash(hash, 64);
+		}
+	}
+	return checksum;
+}
+
+
+
+unsigned long deserialize(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	const unsigned char * walker
+			= reinterpret_cast<const unsigned char *>(&corpus.serialized[0]);
+	int remaining = (int)(corpus.serialized.size() * sizeof(unsigned int));
+	UriUriA uri;
+	int bytesRead;
+	while ((remaining > 0)
+			&& (uriDeserializeUriA(&uri, walker, remaining, &bytesRead)
+				== URI_SUCCESS)) {
+		checksum += (unsigned long)(uri.hostText.afterLast - uri.hostText.first);
+		uriFreeUriMembersA(&uri);
+		walker += bytesRead;
+		remaining -= bytesRead;
+	}
+	return checksum;
+}
+
+
+
+unsigned long batch(const Corpus & corpus) {
+	UriBatchA batch;
+	uriInitBatchA(&batch, URI_BATCH_DICTIONARY_SCHEME | URI_BATCH_DICTIONARY_HOST);
+	for (size_t i = 0; i < corpus.lines.size(); i++) {
+		const char * const first = corpus.lines[i].c_str();
+		uriParseIntoBatchA(&batch, first, first + corpus.lines[i].size(), NULL);
+	}
+	const unsigned long checksum = (unsigned long)batch.count
+			+ (unsigned long)batch.columns[URI_COLUMN_HOST].dictionaryCount;
+	uriFreeBatchMembersA(&batch);
+	return checksum;
+}
+
+
+
+unsigned long setLookup(const Corpus & corpus) {
+	unsigned long checksum = 0;
+	for (size_t i = 0; i < corpus.lines.size(); i++) {
+		const char * const first = corpus.lines[i].c_str();
+		int rank = 0;
+		uriCompressedSetRankA(corpus.set, first, first + corpus.lines[i].size(),
+				&rank, NULL);
+		checksum += (unsigned long)rank;
+	}
+	return checksum;
+}
+
+
+
+// Inserts the normalized hashes of a slice of the URIs, then looks
+// them up; the checksum does not depend on how threads interleave
+unsigned long seenFilterSlice(const Corpus & corpus, UriSeenFilter * filter,
+		size_t offset, size_t stride) {
+	unsigned long checksum = 0;
+	for (size_t i = offset; i < corpus.uris.size(); i += stride) {
+		UriUint64 hash;
+		if (uriNormalizedHashA(&corpus.uris[i], 0, &hash) == URI_SUCCESS) {
+			uriSeenFilterInsert(filter, hash);
+		}
+	}
+	for (size_t i = offset; i < corpus.uris.size(); i += stride) {
+		UriUint64 hash;
+		if (uriNormalizedHashA(&corpus.uris[i], 0, &hash) == URI_SUCCESS) {
+			checksum += (unsigned long)uriSeenFilterContains(filter, hash);
+		}
+	}
+	return checksum;
+}
+
+
+
+unsigned long seenFilter(const Corpus & corpus) {
+	UriSeenFilter * filter = NULL;
+	uriCreateSeenFilter(&filter, corpus.uris.size(), 0.01);
+	const unsigned long checksum = seenFilterSlice(corpus, filter, 0, 1);
+	uriFreeSeenFilter(filter);
+	return checksum;
+}
+
+
+
+// Same as seenFilter, with one thread per core sharing the filter
+unsigned long seenFilterThreads(const Corpus & corpus) {
+	const size_t threadCount = std::max(2U, std::thread::hardware_concurrency());
+	UriSeenFilter * filter = NULL;
+	uriCreateSeenFilter(&filter, corpus.uris.size(), 0.01);
+	std::vector<unsigned long> checksums(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < threadCount; t++) {
+		threads.push_back(std::thread([&corpus, filter, &checksums, t, threadCount]() {
+			checksums[t] = seenFilterSlice(corpus, filter, t, threadCount);
+		}));
+	}
+	unsigned long checksum = 0;
+	for (size_t t = 0; t < threadCount; t++) {
+		threads[t].join();
+		checksum += checksums[t];
+	}
+	uriFreeSeenFilter(filter);
+	return checksum;
+}
+
+
+
+struct Benchmark {
+	const char * name;
+	Workload workload;
+};
+
+const Benchmark benchmarks[] = {
+	{"parse", parse},
+	{"normalize", normalize},
+	{"dissect-query", dissectQuery},
+	{"parse-list", parseList},
+	{"psl-lookup", registrableDomain},
+	{"origin-shard", shardByOrigin},
+	{"deserialize", deserialize},
+	{"batch", batch},
+	{"set-lookup", setLookup},
+	{"seen-filter", seenFilter},
+	{"seen-filter-mt", seenFilterThreads},
+#ifdef URI_ENABLE_CHAR16_T
+	{"parse-u16", parseU16},
+#endif
+};
+
+
+
+void usage() {
+	std::printf("Usage: uriparser_benchmark CORPUS [ROUNDS [WORKLOAD]]\n");
+	std::printf("\n");
+	std::printf("Workloads:\n");
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+		std::printf("  %s\n", benchmarks[i].name);
+	}
+}
+
+}  // namespace
+
+
+
+int main(int argc, char * argv[]) {
+	Corpus corpus;
+	size_t corpusBytes = 0;
+	int rounds = 20;
+	const char * only = NULL;
+
+	if ((argc < 2) || (argc > 4)) {
+		usage();
+		return EXIT_FAILURE;
+	}
+	if (argc >= 3) {
+		rounds = std::atoi(argv[2]);
+		if (rounds < 1) {
+			usage();
+			return EXIT_FAILURE;
+		}
+	}
+	if (argc >= 4) {
+		only = argv[3];
+	}
+
+	std::ifstream input(argv[1]);
+	if (!input) {
+		std::fprintf(stderr, "Cannot read corpus file \"%s\".\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	std::string line;
+	while (std::getline(input, line)) {
+		if (!line.empty() && (line[line.size() - 1] == '\r')) {
+			line.erase(line.size() - 1);
+		}
+		if (!line.empty()) {
+			corpusBytes += line.size();
+			corpus.lines.push_back(line);
+			corpus.text += line;
+			corpus.text += '\n';
+#ifdef URI_ENABLE_CHAR16_T
+			// Widened byte by byte, fine for URIs as they are ASCII
+			corpus.lines16.push_back(std::u16string(line.begin(), line.end()));
+#endif
+		}
+	}
+	if (corpus.lines.empty()) {
+		std::fprintf(stderr, "Corpus file \"%s\" holds no URIs.\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	std::string publicSuffixRules = defaultPublicSuffixRules;
+	const char * const pslPath = std::getenv("URIPARSER_BENCHMARK_PSL");
+	if (pslPath != NULL) {
+		std::ifstream pslInput(pslPath);
+		if (!pslInput) {
+			std::fprintf(stderr, "Cannot read public suffix list \"%s\".\n", pslPath);
+			return EXIT_FAILURE;
+		}
+		publicSuffixRules.assign(std::istreambuf_iterator<char>(pslInput),
+				std::istreambuf_iterator<char>());
+	}
+	if (uriCompilePublicSuffixList(&corpus.psl, publicSuffixRules.c_str(),
+			NULL, NULL) != URI_SUCCESS) {
+		std::fprintf(stderr, "Cannot compile public suffix list.\n");
+		return EXIT_FAILURE;
+	}
+	for (size_t i = 0; i < corpus.lines.size(); i++) {
+		UriUriA uri;
+		if (uriParseSingleUriA(&uri, corpus.lines[i].c_str(), NULL) == URI_SUCCESS) {
+			corpus.uris.push_back(uri);
+		}
+	}
+	for (size_t i = 0; i < corpus.uris.size(); i++) {
+		int bytes = 0;
+		uriSerializeUriBytesRequiredA(&corpus.uris[i], &bytes);
+		const size_t offset = corpus.serialized.size();
+		corpus.serialized.resize(offset + bytes / sizeof(unsigned int));
+		uriSerializeUriA(&corpus.serialized[offset], &corpus.uris[i], bytes, NULL);
+	}
+	std::vector<std::string> sorted = corpus.lines;
+	std::sort(sorted.begin(), sorted.end());
+	std::vector<UriTextRangeA> ranges(sorted.size());
+	for (size_t i = 0; i < sorted.size(); i++) {
+		ranges[i].first = sorted[i].c_str();
+		ranges[i].afterLast = sorted[i].c_str() + sorted[i].size();
+	}
+	if (uriBuildCompressedSetA(&corpus.set, &ranges[0], (int)ranges.size(), NULL)
+			!= URI_SUCCESS) {
+		std::fprintf(stderr, "Cannot build compressed set.\n");
+		return EXIT_FAILURE;
+	}
+
+	std::printf("Corpus: %lu URIs, %lu bytes, best of %d rounds\n",
+			(unsigned long)corpus.lines.size(), (unsigned long)corpusBytes, rounds);
+
+	bool found = false;
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+		const Benchmark & benchmark = benchmarks[i];
+		if ((only != NULL) && (std::string(only) != benchmark.name)) {
+			continue;
+		}
+		found = true;
+
+		double bestSeconds = -1;
+		unsigned long checksum = 0;
+		for (int round = 0; round < rounds; round++) {
+			const std::chrono::steady_clock::time_point start
+					= std::chrono::steady_clock::now();
+			checksum += benchmark.workload(corpus);
+			const std::chrono::duration<double> seconds
+					= std::chrono::steady_clock::now() - start;
+			if ((bestSeconds < 0) || (seconds.count() < bestSeconds)) {
+				bestSeconds = seconds.count();
+			}
+		}
+
+		std::printf("%-16s %8.1f ns/URI %8.1f MB/s  (checksum %lu)\n",
+				benchmark.name,
+				bestSeconds * 1e9 / (double)corpus.lines.size(),
+				(double)corpusBytes / bestSeconds / 1e6,
+				checksum);
+	}
+
+	for (size_t i = 0; i < corpus.uris.size(); i++) {
+		uriFreeUriMembersA(&corpus.uris[i]);
+	}
+	uriFreePublicSuffixList(corpus.psl);
+	uriFreeCompressedSetA(corpus.set);
+
+	if (!found) {
+		usage();
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -41,16 +41,25 @@
 /**
  * @file Uri.h
  * Holds the RFC 3986 %URI parser interface.
- * NOTE: This header includes itself twice.
+ * NOTE: This header includes itself once per encoding.
  */
 
 #if (defined(URI_PASS_ANSI) && !defined(URI_H_ANSI)) \
 	|| (defined(URI_PASS_UNICODE) && !defined(URI_H_UNICODE)) \
-	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_H_CHAR16_T)) \
+	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
 /* What encodings are enabled? */
 #include "UriDefsConfig.h"
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding; char16_t goes first so that
+ * URI_CHAR and friends keep their former meaning after inclusion */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "Uri.h"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "Uri.h"
@@ -64,13 +73,18 @@
 /* Only one pass for each encoding */
 #elif (defined(URI_PASS_ANSI) && !defined(URI_H_ANSI) \
 	&& defined(URI_ENABLE_ANSI)) || (defined(URI_PASS_UNICODE) \
-	&& !defined(URI_H_UNICODE) && defined(URI_ENABLE_UNICODE))
+	&& !defined(URI_H_UNICODE) && defined(URI_ENABLE_UNICODE)) \
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_H_CHAR16_T) \
+	&& defined(URI_ENABLE_CHAR16_T))
 # ifdef URI_PASS_ANSI
 #  define URI_H_ANSI 1
 #  include "UriDefsAnsi.h"
-# else
+# elif defined(URI_PASS_UNICODE)
 #  define URI_H_UNICODE 1
 #  include "UriDefsUnicode.h"
+# else
+#  define URI_H_CHAR16_T 1
+#  include "UriDefsChar16.h"
 # endif
 
 
@@ -172,205 +186,1485 @@ typedef struct URI_TYPE(UriStruct) {
 
 
 /**
- * Represents a state of the %URI parser.
- * Missing components can be NULL to reflect
- * a components absence.
+ * Represents the authority of a %URI (<c>"[userinfo@]host[:port]"</c>)
+ * parsed on its own, e.g. from a Host header field or the
+ * authority-form request-target of CONNECT.
+ * All text ranges point into the parsed input and
+ * structured host data is stored inline, so there
+ * is nothing to free.
+ *
+ * @see uriParseAuthorityExA
+ * @since 0.9.10
+ */
+typedef struct URI_TYPE(AuthorityStruct) {
+	URI_TYPE(TextRange) userInfo; /**< User info (e.g. "user:pass"), {NULL, NULL} if absent */
+	URI_TYPE(TextRange) hostText; /**< Host text (excluding square brackets) */
+	URI_TYPE(TextRange) portText; /**< Port (e.g. "80"), {NULL, NULL} if absent */
+	UriHostType hostType; /**< Type of host */
+	UriIp4 ip4; /**< IPv4 address, only valid for URI_HOST_TYPE_IP4 */
+	UriIp6 ip6; /**< IPv6 address, only valid for URI_HOST_TYPE_IP6 */
+} URI_TYPE(Authority); /**< @copydoc UriAuthorityStructA */
+
+
+
+/**
+ * Represents a state of the %URI parser.
+ * Missing components can be NULL to reflect
+ * a components absence.
+ *
+ * @see uriFreeUriMembersA
+ * @see uriFreeUriMembersMmA
+ * @since 0.3.0
+ */
+typedef struct URI_TYPE(ParserStateStruct) {
+	URI_TYPE(Uri) * uri; /**< Plug in the %URI structure to be filled while parsing here */
+	int errorCode; /**< Code identifying the error which occurred */
+	const URI_CHAR * errorPos; /**< Pointer to position in case of a syntax error */
+
+	void * reserved; /**< Reserved to the parser */
+} URI_TYPE(ParserState); /**< @copydoc UriParserStateStructA */
+
+
+
+/**
+ * Represents a query element.
+ * More precisely it is a node in a linked
+ * list of query elements.
+ *
+ * @since 0.7.0
+ */
+typedef struct URI_TYPE(QueryListStruct) {
+	const URI_CHAR * key; /**< Key of the query element */
+	const URI_CHAR * value; /**< Value of the query element, can be NULL */
+
+	struct URI_TYPE(QueryListStruct) * next; /**< Pointer to the next key/value pair in the list, can be NULL if last already */
+} URI_TYPE(QueryList); /**< @copydoc UriQueryListStructA */
+
+
+
+/**
+ * Represents the state of iterating the segments of a raw path text.
+ * Members are internal; the iterator holds no memory of its own.
+ *
+ * @see uriPathIteratorInitA
+ * @see uriPathIteratorNextA
+ * @since 0.9.10
+ */
+typedef struct URI_TYPE(PathIteratorStruct) {
+	const URI_CHAR * next; /**< Start of the next segment, NULL when done */
+	const URI_CHAR * afterLast; /**< Pointer to character after the last one of the path */
+} URI_TYPE(PathIterator); /**< @copydoc UriPathIteratorStructA */
+
+
+
+/**
+ * Represents the state of iterating the key/value pairs of a raw query text.
+ * Members are internal; the iterator holds no memory of its own.
+ *
+ * @see uriQueryIteratorInitA
+ * @see uriQueryIteratorNextA
+ * @since 0.9.10
+ */
+typedef struct URI_TYPE(QueryIteratorStruct) {
+	const URI_CHAR * next; /**< Start of the next pair, NULL when done */
+	const URI_CHAR * afterLast; /**< Pointer to character after the last one of the query */
+} URI_TYPE(QueryIterator); /**< @copydoc UriQueryIteratorStructA */
+
+
+
+/**
+ * Holds one column of a UriBatchA in the layout of an
+ * <a href="https://arrow.apache.org/docs/format/Columnar.html">Apache Arrow</a>
+ * string array, so that columnar engines can take the buffers as-is:
+ * value <c>i</c> spans from <c>values + offsets[i]</c> to
+ * <c>values + offsets[i + 1]</c>, and bit <c>i % 8</c> of
+ * <c>validity[i / 8]</c> is set unless row <c>i</c> is null.
+ * Dictionary-encoded columns hold each distinct value once, in order
+ * of first appearance, with <c>indices</c> mapping rows to values
+ * (like an Arrow dictionary array with int32 indices).
+ * Members are read-only; buffers are NULL until the first row
+ * and move as rows are appended.
+ *
+ * @see UriBatchA
+ * @since 0.9.10
+ */
+typedef struct URI_TYPE(BatchColumnStruct) {
+	int * offsets; /**< Start of each value in .values, then the end of the last;
+						one per row (or per distinct value if dictionary-encoded) plus one */
+	URI_CHAR * values; /**< Values back to back, not terminated */
+	unsigned char * validity; /**< Validity bitmap, least significant bit first */
+	int * indices; /**< Index of the value of each row (0 for null rows),
+						NULL unless dictionary-encoded */
+	int nullCount; /**< Number of null rows */
+	int dictionaryCount; /**< Number of distinct values, 0 unless dictionary-encoded */
+
+	int offsetsCapacity; /**< Internal */
+	int valuesCapacity; /**< Internal */
+	int * slots; /**< Internal: hash table of dictionary values */
+	int slotCount; /**< Internal */
+} URI_TYPE(BatchColumn); /**< @copydoc UriBatchColumnStructA */
+
+
+
+/**
+ * Holds the components of many URIs column by column,
+ * one UriBatchColumnA per component, e.g. for analytics.
+ *
+ * @see uriInitBatchA
+ * @see uriBatchAppendUriA
+ * @see uriParseIntoBatchA
+ * @see uriFreeBatchMembersA
+ * @since 0.9.10
+ */
+typedef struct URI_TYPE(BatchStruct) {
+	int count; /**< Number of rows */
+	URI_TYPE(BatchColumn) columns[URI_COLUMN_COUNT]; /**< Columns, indexed by UriBatchColumnId */
+
+	int rowCapacity; /**< Internal */
+	int flags; /**< Internal, see UriBatchFlags */
+	UriMemoryManager * memory; /**< Internal */
+} URI_TYPE(Batch); /**< @copydoc UriBatchStructA */
+
+
+
+/**
+ * Static set of %URI strings, front-coded for compactness.
+ * Members are internal.
+ *
+ * @see uriBuildCompressedSetA
+ * @since 0.9.10
+ */
+typedef struct URI_TYPE(CompressedSetStruct) URI_TYPE(CompressedSet); /**< @copydoc UriCompressedSetStructA */
+
+
+
+/**
+ * Receives the strings of a UriCompressedSetA that start with a prefix,
+ * one call per string, in order.
+ *
+ * @param userData    <b>IN</b>: Pointer passed to uriCompressedSetEnumeratePrefixA
+ * @param first       <b>IN</b>: Pointer to the first character of the string;
+ *                               only valid during the call
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the string
+ * @param rank        <b>IN</b>: Position of the string in the set
+ * @return            <c>URI_TRUE</c> to continue, <c>URI_FALSE</c> to stop
+ *
+ * @see uriCompressedSetEnumeratePrefixA
+ * @since 0.9.10
+ */
+typedef UriBool (*URI_TYPE(CompressedSetCallback))(void * userData,
+		const URI_CHAR * first, const URI_CHAR * afterLast, int rank);
+
+
+
+/**
+ * Receives the items of a %URI list, one call per item.
+ *
+ * @param userData    <b>IN</b>: Pointer passed to uriParseUriListExA
+ * @param uri         <b>IN</b>: Parsed %URI, NULL if errorCode is not 0;
+ *                               only valid during the call,
+ *                               use uriCopyUriA to keep it
+ * @param first       <b>IN</b>: Pointer to the first character of the item
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the item
+ * @param errorCode   <b>IN</b>: 0 if the item parsed fine, URI_ERROR_SYNTAX otherwise
+ * @param errorPos    <b>IN</b>: First character causing the syntax error, NULL if errorCode is 0
+ * @return            <c>URI_TRUE</c> to continue, <c>URI_FALSE</c> to stop
+ *
+ * @see uriParseUriListExA
+ * @since 0.9.10
+ */
+typedef UriBool (*URI_TYPE(ParseUriListCallback))(void * userData,
+		const URI_TYPE(Uri) * uri, const URI_CHAR * first,
+		const URI_CHAR * afterLast, int errorCode, const URI_CHAR * errorPos);
+
+
+/**
+ * Checks if a URI has the host component set.
+ *
+ * @param uri <b>IN</b>: %URI to check
+ * @return <c>URI_TRUE</c> when host is set, <c>URI_FALSE</c> otherwise
+ *
+ * @since 0.9.9
+ */
+URI_PUBLIC UriBool URI_FUNC(HasHost)(const URI_TYPE(Uri) * uri);
+
+
+
+/**
+ * Converts an IPv6 text representation into 16 bytes.
+ *
+ * Uses default libc-based memory manager.
+ *
+ * @param output       <b>OUT</b>: Output destination, can be <c>NULL</c>
+ * @param first        <b>IN</b>: First character of IPv6 text to parse
+ * @param afterLast    <b>IN</b>: Position to stop parsing at
+ * @return Error code or <c>URI_SUCCESS</c> on success
+ *
+ * @see uriParseIpFourAddressA
+ * @see uriParseIpSixAddressMmA
+ * @see uriIsWellFormedHostIp6A
+ * @since 0.9.9
+ */
+URI_PUBLIC int URI_FUNC(ParseIpSixAddress)(UriIp6 * output,
+		const URI_CHAR * first,
+		const URI_CHAR * afterLast);
+
+
+
+/**
+ * Converts an IPv6 text representation into 16 bytes.
+ *
+ * @param output       <b>OUT</b>: Output destination, can be <c>NULL</c>
+ * @param first        <b>IN</b>: First character of IPv6 text to parse
+ * @param afterLast    <b>IN</b>: Position to stop parsing at
+ * @param memory       <b>IN</b>: Memory manager to use, <c>NULL</c> for default libc
+ * @return Error code or <c>URI_SUCCESS</c> on success
+ *
+ * @see uriParseIpFourAddressA
+ * @see uriParseIpSixAddressA
+ * @see uriIsWellFormedHostIp6MmA
+ * @since 0.9.9
+ */
+URI_PUBLIC int URI_FUNC(ParseIpSixAddressMm)(UriIp6 * output,
+		const URI_CHAR * first,
+		const URI_CHAR * afterLast,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Parses a RFC 3986 %URI.
+ * Uses default libc-based memory manager.
+ *
+ * @param state       <b>INOUT</b>: Parser state with set output %URI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse, must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to parse, must not be NULL
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseUriA
+ * @see uriParseSingleUriA
+ * @see uriParseSingleUriExA
+ * @see uriToStringA
+ * @since 0.3.0
+ * @deprecated Deprecated since 0.9.0, please migrate to uriParseSingleUriExA (with "Single").
+ */
+URI_PUBLIC int URI_FUNC(ParseUriEx)(URI_TYPE(ParserState) * state,
+		const URI_CHAR * first, const URI_CHAR * afterLast);
+
+
+
+/**
+ * Parses a RFC 3986 %URI.
+ * Uses default libc-based memory manager.
+ *
+ * @param state   <b>INOUT</b>: Parser state with set output %URI, must not be NULL
+ * @param text    <b>IN</b>: Text to parse, must not be NULL
+ * @return        0 on success, error code otherwise
+ *
+ * @see uriParseUriExA
+ * @see uriParseSingleUriA
+ * @see uriParseSingleUriExA
+ * @see uriToStringA
+ * @since 0.3.0
+ * @deprecated Deprecated since 0.9.0, please migrate to uriParseSingleUriA (with "Single").
+ */
+URI_PUBLIC int URI_FUNC(ParseUri)(URI_TYPE(ParserState) * state,
+		const URI_CHAR * text);
+
+
+
+/**
+ * Parses a single RFC 3986 %URI.
+ * Uses default libc-based memory manager.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, must not be NULL
+ * @param text        <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseSingleUriExA
+ * @see uriParseSingleUriExMmA
+ * @see uriToStringA
+ * @since 0.9.0
+ */
+URI_PUBLIC int URI_FUNC(ParseSingleUri)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * text, const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Parses a single RFC 3986 %URI.
+ * Uses default libc-based memory manager.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, can be NULL
+ *                               (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseSingleUriA
+ * @see uriParseSingleUriExMmA
+ * @see uriToStringA
+ * @since 0.9.0
+ */
+URI_PUBLIC int URI_FUNC(ParseSingleUriEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Parses a single RFC 3986 %URI.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, can be NULL
+ *                               (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseSingleUriA
+ * @see uriParseSingleUriExA
+ * @see uriToStringA
+ * @since 0.9.0
+ */
+URI_PUBLIC int URI_FUNC(ParseSingleUriExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory);
+
+
+
+/**
+ * Parses a single RFC 3986 %URI like uriParseSingleUriExA
+ * and additionally reports facts collected while parsing,
+ * e.g. the well-known scheme of the %URI.
+ * Uses default libc-based memory manager.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, can be NULL
+ *                               (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @param info        <b>OUT</b>: Facts about the %URI, can be NULL;
+ *                                only meaningful on success
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseSingleUriExA
+ * @see uriParseSingleUriInfoExMmA
+ * @see uriIdentifySchemeA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseSingleUriInfoEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriParseInfo * info);
+
+
+
+/**
+ * Parses a single RFC 3986 %URI like uriParseSingleUriExMmA
+ * and additionally reports facts collected while parsing,
+ * e.g. the well-known scheme of the %URI.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, must not be NULL
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @param info        <b>OUT</b>: Facts about the %URI, can be NULL;
+ *                                only meaningful on success
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseSingleUriExMmA
+ * @see uriParseSingleUriInfoExA
+ * @see uriIdentifySchemeA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseSingleUriInfoExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriParseInfo * info,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Parses a single RFC 3987 IRI like uriParseSingleUriExA, i.e.
+ * additionally accepts non-ASCII characters of the <c>ucschar</c>
+ * production anywhere but in the scheme and, in the query only,
+ * characters of the <c>iprivate</c> production.
+ * The text is expected in UTF-8 for the ANSI variant and in UTF-16
+ * (or UTF-32, depending on the size of <c>wchar_t</c>) for the wide
+ * variant; ill-formed sequences are reported as syntax errors.
+ * The resulting components hold the original, unescaped characters;
+ * use uriIriToUriStringA for a URI that plain RFC 3986 consumers accept.
+ * Uses default libc-based memory manager.
+ *
+ * @param uri         <b>OUT</b>: Output IRI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, can be NULL
+ *                               (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseSingleIriExMmA
+ * @see uriParseSingleUriExA
+ * @see uriIriToUriStringA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseSingleIriEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Parses a single RFC 3987 IRI like uriParseSingleIriExA.
+ *
+ * @param uri         <b>OUT</b>: Output IRI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, must not be NULL
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseSingleIriExA
+ * @see uriParseSingleUriExMmA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseSingleIriExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory);
+
+
+
+/**
+ * Parses an HTTP request-target in origin-form
+ * (e.g. <c>"/path?query"</c>, RFC 9112 section 3.2.1)
+ * or asterisk-form (i.e. <c>"*"</c>, RFC 9112 section 3.2.4)
+ * straight into path segments and query, without looking for
+ * scheme or authority.
+ * Uses default libc-based memory manager.
+ *
+ * Origin-form results have <c>absolutePath</c> set and are identical
+ * to those of uriParseSingleUriExA except for targets starting with
+ * <c>"//"</c>: these yield an empty first path segment rather than
+ * an authority.  Asterisk-form yields a single path segment <c>"*"</c>.
+ * Fragments are rejected as request-targets cannot carry them.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, can be NULL
+ *                               (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseOriginFormExMmA
+ * @see uriParseSingleUriExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseOriginFormEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Parses an HTTP request-target in origin-form or asterisk-form,
+ * see uriParseOriginFormExA for details.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, must not be NULL
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseOriginFormExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseOriginFormExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory);
+
+
+
+/**
+ * Parses a standalone authority <c>"[userinfo@]host[:port]"</c>
+ * as found in HTTP Host header fields and the authority-form
+ * request-target of CONNECT (RFC 9112 section 3.2.3),
+ * using the same grammar as the authority part of uriParseSingleUriExA.
+ * Does not allocate memory and does not copy the input.
+ * An empty input yields an empty registered name,
+ * callers that require a host need to check for that.
+ * Uses default libc-based memory manager.
+ *
+ * @param authority   <b>OUT</b>: Output authority, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, can be NULL
+ *                               (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseAuthorityExMmA
+ * @see uriParsePortValueA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseAuthorityEx)(URI_TYPE(Authority) * authority,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Parses a standalone authority <c>"[userinfo@]host[:port]"</c>,
+ * see uriParseAuthorityExA for details.
+ * Host data is kept in inline scratch storage, the memory manager
+ * is only there as a fallback and not expected to be called.
+ *
+ * @param authority   <b>OUT</b>: Output authority, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character to parse,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last to
+ *                               parse, must not be NULL
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseAuthorityExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseAuthorityExMm)(URI_TYPE(Authority) * authority,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory);
+
+
+
+/**
+ * Finds the first %URI in free text such as log lines, e-mails or
+ * HTML, and parses it in the same go.
+ * Candidates are either <c>scheme "://" ...</c> or start
+ * with <c>"www."</c>; they end before the first character not allowed in
+ * URIs, minus trailing punctuation like full stops, commas or unbalanced
+ * closing parentheses, and are then validated with the regular grammar.
+ * Invalid trailing parts are cut off, e.g. <c>"http://example.org/%zz"</c>
+ * is found as <c>"http://example.org/"</c>.
+ * Candidates starting with <c>"www."</c> are parsed as if preceded by
+ * <c>"//"</c>, i.e. with a host but no scheme.
+ *
+ * To find all URIs, call again with <c>first</c> set to
+ * <c>found->afterLast</c> until <c>found->first</c> is NULL.
+ * Uses default libc-based memory manager.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, can be NULL; if not NULL
+ *                                and a %URI was found, it needs to be freed
+ *                                using uriFreeUriMembersA
+ * @param first       <b>IN</b>: Pointer to the first character of the text,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last
+ *                               of the text, can be NULL
+ *                               (to use first + strlen(first))
+ * @param found       <b>OUT</b>: Range of the %URI found,
+ *                                {NULL, NULL} if there was none,
+ *                                must not be NULL
+ * @return            0 on success (whether or not a %URI was found),
+ *                    error code otherwise
+ *
+ * @see uriFindUriExMmA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(FindUriEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_TYPE(TextRange) * found);
+
+
+
+/**
+ * Finds the first %URI in free text and parses it,
+ * see uriFindUriExA for details.
+ *
+ * @param uri         <b>OUT</b>: Output %URI, can be NULL; if not NULL
+ *                                and a %URI was found, it needs to be freed
+ *                                using uriFreeUriMembersMmA
+ * @param first       <b>IN</b>: Pointer to the first character of the text,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last
+ *                               of the text, must not be NULL
+ * @param found       <b>OUT</b>: Range of the %URI found,
+ *                                {NULL, NULL} if there was none,
+ *                                must not be NULL
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            0 on success (whether or not a %URI was found),
+ *                    error code otherwise
+ *
+ * @see uriFindUriExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(FindUriExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_TYPE(TextRange) * found, UriMemoryManager * memory);
+
+
+
+/**
+ * Parses a buffer of many URIs, e.g. a log file, splitting and parsing
+ * in a single pass without copying.  Empty items are skipped,
+ * invalid items are reported to the callback rather than ending
+ * the run.
+ * Uses default libc-based memory manager.
+ *
+ * @param first       <b>IN</b>: Pointer to the first character of the buffer,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last
+ *                               of the buffer, can be NULL
+ *                               (to use first + strlen(first))
+ * @param delimiter   <b>IN</b>: How items are separated
+ * @param callback    <b>IN</b>: Function to receive each item, must not be NULL
+ * @param userData    <b>IN</b>: Pointer to pass to the callback, can be NULL
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseUriListExMmA
+ * @see uriParseSingleUriExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseUriListEx)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, UriListDelimiter delimiter,
+		URI_TYPE(ParseUriListCallback) callback, void * userData);
+
+
+
+/**
+ * Parses a buffer of many URIs, see uriParseUriListExA for details.
+ *
+ * @param first       <b>IN</b>: Pointer to the first character of the buffer,
+ *                               must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last
+ *                               of the buffer, must not be NULL
+ * @param delimiter   <b>IN</b>: How items are separated
+ * @param callback    <b>IN</b>: Function to receive each item, must not be NULL
+ * @param userData    <b>IN</b>: Pointer to pass to the callback, can be NULL
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            0 on success, error code otherwise
+ *
+ * @see uriParseUriListExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseUriListExMm)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, UriListDelimiter delimiter,
+		URI_TYPE(ParseUriListCallback) callback, void * userData,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Encodes a single label of Unicode text to Punycode as described in
+ * <a href="https://datatracker.ietf.org/doc/html/rfc3492">RFC 3492</a>,
+ * e.g. <c>"bücher"</c> to <c>"bcher-kva"</c>.
+ * The <c>"xn--"</c> prefix is not added and no mapping
+ * (e.g. case folding or NFC) is applied to the input.
+ * The input is expected in UTF-8 for the ANSI variant and in UTF-16
+ * or UTF-32 (depending on the size of <c>wchar_t</c>) for the wide variant.
+ * Ill-formed input and labels of more than 63 code points,
+ * the DNS limit, are rejected with URI_ERROR_SYNTAX.
+ *
+ * @param dest           <b>OUT</b>: Output destination, must not be NULL
+ * @param first          <b>IN</b>: Pointer to the first character of the label, must not be NULL
+ * @param afterLast      <b>IN</b>: Pointer to the character after the last of the label,
+ *                                  can be NULL (to use first + strlen(first))
+ * @param maxChars       <b>IN</b>: Maximum number of characters to write <b>including</b> terminator
+ * @param charsWritten   <b>OUT</b>: Number of characters written including terminator, can be NULL
+ * @return               Error code or 0 on success
+ *
+ * @see uriPunycodeDecodeA
+ * @see uriNormalizeHostIdnaA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(PunycodeEncode)(URI_CHAR * dest,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		int maxChars, int * charsWritten);
+
+
+
+/**
+ * Decodes a single Punycode label (without <c>"xn--"</c> prefix)
+ * as described in <a href="https://datatracker.ietf.org/doc/html/rfc3492">RFC 3492</a>,
+ * e.g. <c>"bcher-kva"</c> to <c>"bücher"</c>.
+ * The output is written in UTF-8 for the ANSI variant and in UTF-16
+ * or UTF-32 (depending on the size of <c>wchar_t</c>) for the wide variant.
+ * Invalid Punycode and labels decoding to more than 63 code points
+ * are rejected with URI_ERROR_SYNTAX.
+ *
+ * @param dest           <b>OUT</b>: Output destination, must not be NULL
+ * @param first          <b>IN</b>: Pointer to the first character of the label, must not be NULL
+ * @param afterLast      <b>IN</b>: Pointer to the character after the last of the label,
+ *                                  can be NULL (to use first + strlen(first))
+ * @param maxChars       <b>IN</b>: Maximum number of characters to write <b>including</b> terminator
+ * @param charsWritten   <b>OUT</b>: Number of characters written including terminator, can be NULL
+ * @return               Error code or 0 on success
+ *
+ * @see uriPunycodeEncodeA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(PunycodeDecode)(URI_CHAR * dest,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		int maxChars, int * charsWritten);
+
+
+
+/**
+ * Converts the labels of a registered name host that hold non-ASCII
+ * characters to Punycode A-labels, e.g. <c>"b%C3%BCcher.example"</c>
+ * (or <c>"bücher.example"</c> from uriParseSingleIriExA)
+ * to <c>"xn--bcher-kva.example"</c>, as an opt-in step next to
+ * uriNormalizeSyntaxA. ASCII letters of converted labels are lowercased;
+ * no further mapping (e.g. Unicode case folding or NFC) is applied.
+ * Hosts that are IP literals, already ASCII, or not convertible
+ * (ill-formed UTF-8, labels over 63 or hosts over 253 characters
+ * once converted) are left unchanged.
+ *
+ * NOTE: If the host changes, the %URI becomes owner of all memory
+ * behind the text pointed to. Nothing is allocated for hosts that are
+ * left unchanged, and hosts of owning URIs that do not grow
+ * are converted in place.
+ * Uses default libc-based memory manager.
+ *
+ * @param uri    <b>INOUT</b>: %URI to normalize, must not be NULL
+ * @return       Error code or 0 on success
+ *
+ * @see uriNormalizeHostIdnaMmA
+ * @see uriPunycodeEncodeA
+ * @see uriNormalizeSyntaxA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(NormalizeHostIdna)(URI_TYPE(Uri) * uri);
+
+
+
+/**
+ * Converts the host of a %URI to Punycode A-labels
+ * like uriNormalizeHostIdnaA.
+ *
+ * @param uri    <b>INOUT</b>: %URI to normalize, must not be NULL
+ * @param memory <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return       Error code or 0 on success
+ *
+ * @see uriNormalizeHostIdnaA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(NormalizeHostIdnaMm)(URI_TYPE(Uri) * uri,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Computes in a single pass where the labels of a registered name host
+ * start, e.g. for <c>"www.example.com"</c> labels <c>"www"</c>,
+ * <c>"example"</c> and <c>"com"</c>. A trailing dot (as in
+ * <c>"example.com."</c>) does not add an empty label.
+ *
+ * @param uri      <b>IN</b>: %URI with a registered name host, must not be NULL
+ * @param labels   <b>OUT</b>: Label index, must not be NULL
+ * @return         Error code or 0 on success; URI_ERROR_HOST_NOT_REGNAME
+ *                 for URIs without host or with an IP literal host,
+ *                 URI_ERROR_OUTPUT_TOO_LARGE for hosts of more than
+ *                 URI_HOST_LABELS_MAX labels
+ *
+ * @see uriToReversedHostKeyA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(IndexHostLabels)(const URI_TYPE(Uri) * uri,
+		UriHostLabels * labels);
+
+
+
+/**
+ * Determines the number of characters needed by uriToReversedHostKeyA,
+ * <b>excluding</b> the terminator.
+ *
+ * @param uri            <b>IN</b>: %URI with a registered name host, must not be NULL
+ * @param labels         <b>IN</b>: Label index of <c>uri</c> from
+ *                                  uriIndexHostLabelsA, NULL to compute it here
+ * @param withPath       <b>IN</b>: Whether to append the path
+ * @param charsRequired  <b>OUT</b>: Length of the key, must not be NULL
+ * @return               Error code or 0 on success
+ *
+ * @see uriToReversedHostKeyA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ToReversedHostKeyCharsRequired)(
+		const URI_TYPE(Uri) * uri, const UriHostLabels * labels,
+		UriBool withPath, int * charsRequired);
+
+
+
+/**
+ * Writes the labels of a registered name host in reverse order,
+ * e.g. <c>"com.example.www"</c> for <c>"http://WWW.example.com./a/b?q"</c>,
+ * optionally followed by the path (<c>"com.example.www/a/b"</c>).
+ * Keys like these sort URIs of the same domain next to each other,
+ * e.g. for range-partitioned storage.  ASCII letters of the host are
+ * lowercased; the path is copied as-is and is <c>"/"</c> if empty.
+ * Query, fragment, port and user info are not part of the key.
+ *
+ * @param dest           <b>OUT</b>: Output destination, must not be NULL
+ * @param uri            <b>IN</b>: %URI with a registered name host, must not be NULL
+ * @param labels         <b>IN</b>: Label index of <c>uri</c> from
+ *                                  uriIndexHostLabelsA, NULL to compute it here
+ * @param withPath       <b>IN</b>: Whether to append the path
+ * @param maxChars       <b>IN</b>: Maximum number of characters to write <b>including</b> terminator
+ * @param charsWritten   <b>OUT</b>: Number of characters written including terminator, can be NULL
+ * @return               Error code or 0 on success
+ *
+ * @see uriToReversedHostKeyCharsRequiredA
+ * @see uriIndexHostLabelsA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ToReversedHostKey)(URI_CHAR * dest,
+		const URI_TYPE(Uri) * uri, const UriHostLabels * labels,
+		UriBool withPath, int maxChars, int * charsWritten);
+
+
+
+/**
+ * Determines the registrable domain ("eTLD+1") of a registered name
+ * host, i.e. its public suffix plus one more label, following the
+ * <a href="https://github.com/publicsuffix/list/wiki/Format#algorithm">algorithm
+ * of the public suffix list</a>, e.g. <c>"example.co.uk"</c> for
+ * <c>"www.example.co.uk"</c> with rule <c>"co.uk"</c>.
+ * Both ranges point into the host, without a trailing dot.
+ * Nothing is allocated.
+ *
+ * @param uri                <b>IN</b>: %URI with a registered name host, must not be NULL
+ * @param labels             <b>IN</b>: Label index of <c>uri</c> from
+ *                                      uriIndexHostLabelsA, NULL to compute it here
+ * @param psl                <b>IN</b>: Compiled public suffix list, must not be NULL
+ * @param registrableDomain  <b>OUT</b>: Registrable domain, must not be NULL;
+ *                                       set to NULL pointers if the host is a
+ *                                       public suffix itself (or empty)
+ * @param publicSuffix       <b>OUT</b>: Public suffix, can be NULL
+ * @return                   Error code or 0 on success;
+ *                           URI_ERROR_HOST_NOT_REGNAME for URIs without host
+ *                           or with an IP literal host
+ *
+ * @see uriCompilePublicSuffixList
+ * @see uriIndexHostLabelsA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(RegistrableDomain)(const URI_TYPE(Uri) * uri,
+		const UriHostLabels * labels, const UriPublicSuffixList * psl,
+		URI_TYPE(TextRange) * registrableDomain,
+		URI_TYPE(TextRange) * publicSuffix);
+
+
+
+/**
+ * Computes a stable, seeded 64-bit hash of the origin of a %URI,
+ * i.e. of its scheme, host and effective port, e.g. for partitioning
+ * URLs across nodes with uriJumpConsistentHash.
+ * Nothing is allocated and no string is built.
+ * Scheme and host are compared ignoring the case of ASCII letters,
+ * IP addresses by value (so <c>"[::1]"</c> equals <c>"[0::1]"</c>),
+ * and a missing port means the default port of the scheme
+ * (80 for http and ws, 443 for https and wss, 21 for ftp).
+ * The hash only depends on <c>seed</c> and the text of the %URI,
+ * not on platform or character type: all variants agree,
+ * with wide characters hashed as UTF-8.
+ * Percent-encoding is not normalized; consider uriNormalizeSyntaxA
+ * and uriNormalizeHostIdnaA beforehand.
+ *
+ * @param uri    <b>IN</b>: %URI with a host, must not be NULL
+ * @param seed   <b>IN</b>: Seed, e.g. to make hashes differ per deployment
+ * @param hash   <b>OUT</b>: Hash, must not be NULL
+ * @return       Error code or 0 on success;
+ *               URI_ERROR_HASH_HOST_NOT_SET for URIs without host,
+ *               URI_ERROR_PORT_OUT_OF_RANGE for ports beyond 65535
+ *
+ * @see uriSiteHashA
+ * @see uriJumpConsistentHash
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(OriginHash)(const URI_TYPE(Uri) * uri,
+		UriUint64 seed, UriUint64 * hash);
+
+
+
+/**
+ * Computes a stable, seeded 64-bit hash of the site of a %URI,
+ * i.e. of its scheme and registrable domain, so that e.g.
+ * <c>"https://a.example.co.uk"</c> and <c>"https://b.example.co.uk:8443"</c>
+ * hash the same. Hosts that are a public suffix themselves
+ * and IP addresses stand for themselves.
+ * Otherwise the same rules as for uriOriginHashA apply.
+ *
+ * @param uri    <b>IN</b>: %URI with a host, must not be NULL
+ * @param psl    <b>IN</b>: Compiled public suffix list, must not be NULL
+ * @param seed   <b>IN</b>: Seed, e.g. to make hashes differ per deployment
+ * @param hash   <b>OUT</b>: Hash, must not be NULL
+ * @return       Error code or 0 on success;
+ *               URI_ERROR_HASH_HOST_NOT_SET for URIs without host
+ *
+ * @see uriOriginHashA
+ * @see uriRegistrableDomainA
+ * @see uriJumpConsistentHash
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(SiteHash)(const URI_TYPE(Uri) * uri,
+		const UriPublicSuffixList * psl, UriUint64 seed, UriUint64 * hash);
+
+
+
+/**
+ * Computes a stable, seeded 64-bit hash of a %URI as normalized by
+ * uriNormalizeSyntaxA, e.g. as key for a UriSeenFilter when crawling,
+ * without normalizing, serializing or copying the %URI in most cases:
+ * scheme and host are compared ignoring case, IP addresses by value
+ * and ports by value with the default port of the scheme filled in
+ * (as with uriOriginHashA). Going beyond uriNormalizeSyntaxA,
+ * an empty path after a host equals <c>"/"</c> and the fragment
+ * is left out, so that e.g. <c>"HTTP://Example.com:80"</c> and
+ * <c>"http://example.com/#top"</c> hash the same. Only URIs with user
+ * info, host, path or query in need of normalization are copied.
+ * All variants agree, with wide characters hashed as UTF-8.
+ * Uses default libc-based memory manager.
+ *
+ * @param uri    <b>IN</b>: %URI to hash, must not be NULL
+ * @param seed   <b>IN</b>: Seed, e.g. to make hashes differ per deployment
+ * @param hash   <b>OUT</b>: Hash, must not be NULL
+ * @return       Error code or 0 on success;
+ *               URI_ERROR_PORT_OUT_OF_RANGE for ports beyond 65535
+ *
+ * @see uriNormalizedHashMmA
+ * @see uriSeenFilterInsert
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(NormalizedHash)(const URI_TYPE(Uri) * uri,
+		UriUint64 seed, UriUint64 * hash);
+
+
+
+/**
+ * Computes a stable, seeded 64-bit hash of a %URI as normalized,
+ * like uriNormalizedHashA.
+ *
+ * @param uri      <b>IN</b>: %URI to hash, must not be NULL
+ * @param seed     <b>IN</b>: Seed, e.g. to make hashes differ per deployment
+ * @param hash     <b>OUT</b>: Hash, must not be NULL
+ * @param memory   <b>IN</b>: Memory manager to use for the copy to normalize
+ *                            if needed, NULL for default libc
+ * @return         Error code or 0 on success
+ *
+ * @see uriNormalizedHashA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(NormalizedHashMm)(const URI_TYPE(Uri) * uri,
+		UriUint64 seed, UriUint64 * hash, UriMemoryManager * memory);
+
+
+
+/**
+ * Calculates the number of bytes needed to serialize a %URI
+ * with uriSerializeUriA.
+ *
+ * @param uri             <b>IN</b>: %URI to serialize, must not be NULL
+ * @param bytesRequired   <b>OUT</b>: Number of bytes required, must not be NULL
+ * @return                Error code or 0 on success
+ *
+ * @see uriSerializeUriA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(SerializeUriBytesRequired)(const URI_TYPE(Uri) * uri,
+		int * bytesRequired);
+
+
+
+/**
+ * Serializes a parsed %URI to a compact, relocatable binary form
+ * (component offsets, host data, path segment table, text) that
+ * uriDeserializeUriA turns back into a %URI without parsing,
+ * e.g. to store parsed URIs in a memory-mapped cache file.
+ * The size is a multiple of 4 so that serialized URIs can be
+ * concatenated and stay aligned. Numbers are stored little-endian;
+ * text is stored in native characters, so the output of the wide
+ * variants is specific to the size and byte order of their characters.
+ *
+ * @param dest           <b>OUT</b>: Output destination, must not be NULL
+ * @param uri            <b>IN</b>: %URI to serialize, must not be NULL
+ * @param maxBytes       <b>IN</b>: Size of <c>dest</c> in bytes
+ * @param bytesWritten   <b>OUT</b>: Number of bytes written, can be NULL
+ * @return               Error code or 0 on success
+ *
+ * @see uriSerializeUriBytesRequiredA
+ * @see uriDeserializeUriA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(SerializeUri)(void * dest, const URI_TYPE(Uri) * uri,
+		int maxBytes, int * bytesWritten);
+
+
+
+/**
+ * Restores a %URI serialized by uriSerializeUriA, pointing its text
+ * ranges right into <c>data</c> rather than copying or parsing:
+ * besides a bounds check per range, the only work is allocating
+ * the path segment list (and the IP address of IP hosts), so that
+ * the result works with all other functions and is released by
+ * uriFreeUriMembersA as usual. <c>data</c> must outlive the %URI
+ * and be aligned for the character type (e.g. memory-mapped or
+ * from malloc, plus multiples of 4).
+ * Uses default libc-based memory manager.
+ *
+ * @param uri         <b>OUT</b>: %URI to fill, must not be NULL
+ * @param data        <b>IN</b>: Serialized %URI, must not be NULL
+ * @param size        <b>IN</b>: Bytes available at <c>data</c>,
+ *                               may cover more serialized URIs after the first
+ * @param bytesRead   <b>OUT</b>: Size of the serialized %URI, i.e. the offset
+ *                                of the next one, can be NULL
+ * @return            Error code or 0 on success;
+ *                    URI_ERROR_DESERIALIZE_MALFORMED for data that is
+ *                    truncated, misaligned, inconsistent or of another variant
+ *
+ * @see uriDeserializeUriMmA
+ * @see uriSerializeUriA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(DeserializeUri)(URI_TYPE(Uri) * uri,
+		const void * data, int size, int * bytesRead);
+
+
+
+/**
+ * Restores a %URI serialized by uriSerializeUriA like uriDeserializeUriA.
+ *
+ * @param uri         <b>OUT</b>: %URI to fill, must not be NULL
+ * @param data        <b>IN</b>: Serialized %URI, must not be NULL
+ * @param size        <b>IN</b>: Bytes available at <c>data</c>
+ * @param bytesRead   <b>OUT</b>: Size of the serialized %URI, can be NULL
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return            Error code or 0 on success
+ *
+ * @see uriDeserializeUriA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(DeserializeUriMm)(URI_TYPE(Uri) * uri,
+		const void * data, int size, int * bytesRead,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Initializes an empty batch of URIs in columnar form.
+ * Nothing is allocated until the first row is appended.
+ * Uses default libc-based memory manager.
+ *
+ * @param batch   <b>OUT</b>: Batch to initialize, must not be NULL
+ * @param flags   <b>IN</b>: Columns to dictionary-encode, see UriBatchFlags,
+ *                           e.g. <c>URI_BATCH_DICTIONARY_SCHEME | URI_BATCH_DICTIONARY_HOST</c>
+ * @return        Error code or 0 on success
+ *
+ * @see uriInitBatchMmA
+ * @see uriBatchAppendUriA
+ * @see uriFreeBatchMembersA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(InitBatch)(URI_TYPE(Batch) * batch, int flags);
+
+
+
+/**
+ * Initializes an empty batch of URIs in columnar form like uriInitBatchA.
+ *
+ * @param batch    <b>OUT</b>: Batch to initialize, must not be NULL
+ * @param flags    <b>IN</b>: Columns to dictionary-encode, see UriBatchFlags
+ * @param memory   <b>IN</b>: Memory manager to use for the lifetime of
+ *                            the batch, NULL for default libc
+ * @return         Error code or 0 on success
+ *
+ * @see uriInitBatchA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(InitBatchMm)(URI_TYPE(Batch) * batch, int flags,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Appends the components of a parsed %URI to a batch as one more row,
+ * copying their text into the columns. If an error is returned,
+ * the rows of the batch are left as they were before the call
+ * (though a dictionary may keep a value that no row refers to).
+ *
+ * @param batch   <b>INOUT</b>: Batch to append to, must not be NULL
+ * @param uri     <b>IN</b>: %URI to append, must not be NULL
+ * @return        Error code or 0 on success
+ *
+ * @see uriParseIntoBatchA
+ * @see UriBatchColumnA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(BatchAppendUri)(URI_TYPE(Batch) * batch,
+		const URI_TYPE(Uri) * uri);
+
+
+
+/**
+ * Parses a single %URI like uriParseSingleUriExA, using the memory
+ * manager of the batch, and appends it to the batch as one more row.
+ * Text that fails to parse appends nothing.
+ *
+ * @param batch       <b>INOUT</b>: Batch to append to, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character of the %URI, must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the %URI,
+ *                               can be NULL (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
+ *                                causing a syntax error, can be NULL
+ * @return            Error code or 0 on success
+ *
+ * @see uriBatchAppendUriA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParseIntoBatch)(URI_TYPE(Batch) * batch,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Removes all rows from a batch but keeps its memory,
+ * so that the next batch of rows needs (next to) no allocations.
+ *
+ * @param batch   <b>INOUT</b>: Batch to clear, can be NULL
+ *
+ * @see uriFreeBatchMembersA
+ * @since 0.9.10
+ */
+URI_PUBLIC void URI_FUNC(ClearBatch)(URI_TYPE(Batch) * batch);
+
+
+
+/**
+ * Frees all memory of a batch, leaving it empty and ready for reuse.
+ *
+ * @param batch   <b>INOUT</b>: Batch to free the members of, can be NULL
+ *
+ * @see uriInitBatchA
+ * @see uriClearBatchA
+ * @since 0.9.10
+ */
+URI_PUBLIC void URI_FUNC(FreeBatchMembers)(URI_TYPE(Batch) * batch);
+
+
+
+/**
+ * Builds a static, compressed set of %URI strings, e.g. of a sitemap
+ * or crawl frontier, from strings sorted in ascending order (character
+ * by character as unsigned numbers, a prefix first, i.e. like
+ * <c>strcmp</c> and <c>std::string::compare</c> for UTF-8).
+ * Strings are front-coded in blocks of 16: all but the first of
+ * a block are stored as the length of the prefix they share with
+ * their predecessor and the rest, which shrinks lists with long
+ * common prefixes several-fold. Duplicates are stored once.
+ * Strings are taken as-is; consider normalizing them
+ * (e.g. with uriNormalizeSyntaxA and uriToStringA) before sorting.
+ * Uses default libc-based memory manager.
+ *
+ * @param set          <b>OUT</b>: Set built, to be freed with uriFreeCompressedSetA, must not be NULL
+ * @param uris         <b>IN</b>: Sorted strings, can be NULL if <c>count</c> is 0
+ * @param count        <b>IN</b>: Number of strings
+ * @param errorIndex   <b>OUT</b>: Index of the first string out of order, can be NULL;
+ *                                 only set when URI_ERROR_COMPRESSEDSET_NOT_SORTED was returned
+ * @return             Error code or 0 on success
+ *
+ * @see uriBuildCompressedSetMmA
+ * @see uriCompressedSetRankA
+ * @see uriCompressedSetEnumeratePrefixA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(BuildCompressedSet)(URI_TYPE(CompressedSet) ** set,
+		const URI_TYPE(TextRange) * uris, int count, int * errorIndex);
+
+
+
+/**
+ * Builds a static, compressed set of %URI strings like uriBuildCompressedSetA.
+ *
+ * @param set          <b>OUT</b>: Set built, to be freed with uriFreeCompressedSetA, must not be NULL
+ * @param uris         <b>IN</b>: Sorted strings, can be NULL if <c>count</c> is 0
+ * @param count        <b>IN</b>: Number of strings
+ * @param errorIndex   <b>OUT</b>: Index of the first string out of order, can be NULL
+ * @param memory       <b>IN</b>: Memory manager to use, NULL for default libc;
+ *                                also used by uriFreeCompressedSetA and
+ *                                uriCompressedSetEnumeratePrefixA
+ * @return             Error code or 0 on success
+ *
+ * @see uriBuildCompressedSetA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(BuildCompressedSetMm)(URI_TYPE(CompressedSet) ** set,
+		const URI_TYPE(TextRange) * uris, int count, int * errorIndex,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Frees a set built by uriBuildCompressedSetA.
+ *
+ * @param set   <b>INOUT</b>: Set to free, can be NULL
+ *
+ * @see uriBuildCompressedSetA
+ * @since 0.9.10
+ */
+URI_PUBLIC void URI_FUNC(FreeCompressedSet)(URI_TYPE(CompressedSet) * set);
+
+
+
+/**
+ * Returns the number of (distinct) strings in a set.
  *
- * @see uriFreeUriMembersA
- * @see uriFreeUriMembersMmA
- * @since 0.3.0
+ * @param set   <b>IN</b>: Set, can be NULL
+ * @return      Number of strings, 0 for NULL
+ *
+ * @see uriBuildCompressedSetA
+ * @since 0.9.10
  */
-typedef struct URI_TYPE(ParserStateStruct) {
-	URI_TYPE(Uri) * uri; /**< Plug in the %URI structure to be filled while parsing here */
-	int errorCode; /**< Code identifying the error which occurred */
-	const URI_CHAR * errorPos; /**< Pointer to position in case of a syntax error */
-
-	void * reserved; /**< Reserved to the parser */
-} URI_TYPE(ParserState); /**< @copydoc UriParserStateStructA */
+URI_PUBLIC int URI_FUNC(CompressedSetCount)(const URI_TYPE(CompressedSet) * set);
 
 
 
 /**
- * Represents a query element.
- * More precisely it is a node in a linked
- * list of query elements.
+ * Returns the number of bytes a set occupies in memory, in total.
  *
- * @since 0.7.0
+ * @param set   <b>IN</b>: Set, can be NULL
+ * @return      Size in bytes, 0 for NULL
+ *
+ * @see uriBuildCompressedSetA
+ * @since 0.9.10
  */
-typedef struct URI_TYPE(QueryListStruct) {
-	const URI_CHAR * key; /**< Key of the query element */
-	const URI_CHAR * value; /**< Value of the query element, can be NULL */
+URI_PUBLIC int URI_FUNC(CompressedSetByteSize)(const URI_TYPE(CompressedSet) * set);
 
-	struct URI_TYPE(QueryListStruct) * next; /**< Pointer to the next key/value pair in the list, can be NULL if last already */
-} URI_TYPE(QueryList); /**< @copydoc UriQueryListStructA */
 
 
 /**
- * Checks if a URI has the host component set.
+ * Determines the number of strings in a set that are less than
+ * the given one, and whether the set contains it, right on the
+ * compressed data: a binary search over the first strings of the
+ * blocks, then a scan of one block that compares prefix lengths
+ * and only looks at characters where needed. Nothing is allocated.
  *
- * @param uri <b>IN</b>: %URI to check
- * @return <c>URI_TRUE</c> when host is set, <c>URI_FALSE</c> otherwise
+ * @param set         <b>IN</b>: Set to search, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character of the string, must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the string,
+ *                               can be NULL (to use first + strlen(first))
+ * @param rank        <b>OUT</b>: Number of strings less than the given one,
+ *                                i.e. its position if contained, must not be NULL
+ * @param contained   <b>OUT</b>: Whether the set contains the string, can be NULL
+ * @return            Error code or 0 on success
  *
- * @since 0.9.9
+ * @see uriCompressedSetContainsA
+ * @see uriCompressedSetGetA
+ * @since 0.9.10
  */
-URI_PUBLIC UriBool URI_FUNC(HasHost)(const URI_TYPE(Uri) * uri);
+URI_PUBLIC int URI_FUNC(CompressedSetRank)(const URI_TYPE(CompressedSet) * set,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		int * rank, UriBool * contained);
 
 
 
 /**
- * Converts an IPv6 text representation into 16 bytes.
+ * Checks whether a set contains a string, see uriCompressedSetRankA.
  *
- * Uses default libc-based memory manager.
+ * @param set         <b>IN</b>: Set to search, can be NULL
+ * @param first       <b>IN</b>: Pointer to the first character of the string, can be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the string,
+ *                               can be NULL (to use first + strlen(first))
+ * @return            <c>URI_TRUE</c> if contained, <c>URI_FALSE</c> else
  *
- * @param output       <b>OUT</b>: Output destination, can be <c>NULL</c>
- * @param first        <b>IN</b>: First character of IPv6 text to parse
- * @param afterLast    <b>IN</b>: Position to stop parsing at
- * @return Error code or <c>URI_SUCCESS</c> on success
+ * @see uriCompressedSetRankA
+ * @since 0.9.10
+ */
+URI_PUBLIC UriBool URI_FUNC(CompressedSetContains)(const URI_TYPE(CompressedSet) * set,
+		const URI_CHAR * first, const URI_CHAR * afterLast);
+
+
+
+/**
+ * Copies the string at a position of a set to dest, decompressing
+ * at most one block. Nothing is allocated.
  *
- * @see uriParseIpFourAddressA
- * @see uriParseIpSixAddressMmA
- * @see uriIsWellFormedHostIp6A
- * @since 0.9.9
+ * @param set            <b>IN</b>: Set, must not be NULL
+ * @param index          <b>IN</b>: Position of the string, from 0 to count - 1
+ * @param dest           <b>OUT</b>: Output destination, must not be NULL
+ * @param maxChars       <b>IN</b>: Maximum number of characters to write <b>including</b> terminator
+ * @param charsWritten   <b>OUT</b>: Number of characters written including terminator, can be NULL
+ * @return               Error code or 0 on success;
+ *                       URI_ERROR_RANGE_INVALID for an index out of range
+ *
+ * @see uriCompressedSetRankA
+ * @since 0.9.10
  */
-URI_PUBLIC int URI_FUNC(ParseIpSixAddress)(UriIp6 * output,
-		const URI_CHAR * first,
-		const URI_CHAR * afterLast);
+URI_PUBLIC int URI_FUNC(CompressedSetGet)(const URI_TYPE(CompressedSet) * set,
+		int index, URI_CHAR * dest, int maxChars, int * charsWritten);
 
 
 
 /**
- * Converts an IPv6 text representation into 16 bytes.
+ * Passes all strings of a set that start with a prefix to a callback,
+ * in order, e.g. all URLs of a host or below a path. Finding the first
+ * works like uriCompressedSetRankA, the others are decoded one after
+ * another into a single buffer, allocated once per call with the
+ * memory manager of the set.
  *
- * @param output       <b>OUT</b>: Output destination, can be <c>NULL</c>
- * @param first        <b>IN</b>: First character of IPv6 text to parse
- * @param afterLast    <b>IN</b>: Position to stop parsing at
- * @param memory       <b>IN</b>: Memory manager to use, <c>NULL</c> for default libc
- * @return Error code or <c>URI_SUCCESS</c> on success
+ * @param set         <b>IN</b>: Set, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character of the prefix, must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the prefix,
+ *                               can be NULL (to use first + strlen(first))
+ * @param callback    <b>IN</b>: Function to call per string, must not be NULL
+ * @param userData    <b>IN</b>: Pointer to pass to the callback, can be NULL
+ * @return            Error code or 0 on success
  *
- * @see uriParseIpFourAddressA
- * @see uriParseIpSixAddressA
- * @see uriIsWellFormedHostIp6MmA
- * @since 0.9.9
+ * @see uriCompressedSetRankA
+ * @since 0.9.10
  */
-URI_PUBLIC int URI_FUNC(ParseIpSixAddressMm)(UriIp6 * output,
-		const URI_CHAR * first,
-		const URI_CHAR * afterLast,
-		UriMemoryManager * memory);
+URI_PUBLIC int URI_FUNC(CompressedSetEnumeratePrefix)(const URI_TYPE(CompressedSet) * set,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_TYPE(CompressedSetCallback) callback, void * userData);
 
 
 
 /**
- * Parses a RFC 3986 %URI.
- * Uses default libc-based memory manager.
+ * Identifies a well-known scheme, ignoring case,
+ * e.g. for dispatch on <c>uri.scheme</c> after uriSetSchemeA.
  *
- * @param state       <b>INOUT</b>: Parser state with set output %URI, must not be NULL
- * @param first       <b>IN</b>: Pointer to the first character to parse, must not be NULL
- * @param afterLast   <b>IN</b>: Pointer to the character after the last to parse, must not be NULL
- * @return            0 on success, error code otherwise
+ * @param first       <b>IN</b>: Pointer to the first character of the scheme,
+ *                               NULL for no scheme
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last
+ *                               of the scheme
+ * @return            Identified scheme, URI_SCHEME_UNKNOWN for others
  *
- * @see uriParseUriA
- * @see uriParseSingleUriA
- * @see uriParseSingleUriExA
- * @see uriToStringA
- * @since 0.3.0
- * @deprecated Deprecated since 0.9.0, please migrate to uriParseSingleUriExA (with "Single").
+ * @see uriParseSingleUriInfoExA
+ * @since 0.9.10
  */
-URI_PUBLIC int URI_FUNC(ParseUriEx)(URI_TYPE(ParserState) * state,
-		const URI_CHAR * first, const URI_CHAR * afterLast);
+URI_PUBLIC UriScheme URI_FUNC(IdentifyScheme)(const URI_CHAR * first,
+		const URI_CHAR * afterLast);
 
 
 
 /**
- * Parses a RFC 3986 %URI.
- * Uses default libc-based memory manager.
+ * Collects the component flags of a %URI (e.g. "contains percent-encodings"
+ * or "contains dot segments") into the flag members of <c>info</c>,
+ * leaving its other members untouched.  uriParseSingleUriInfoExA does this
+ * already; calling this function is only needed after modifying a %URI,
+ * e.g. after uriSetPathA or uriNormalizeSyntaxA.
  *
- * @param state   <b>INOUT</b>: Parser state with set output %URI, must not be NULL
- * @param text    <b>IN</b>: Text to parse, must not be NULL
- * @return        0 on success, error code otherwise
+ * @param uri    <b>IN</b>: %URI to inspect, must not be NULL
+ * @param info   <b>INOUT</b>: Info to update, must not be NULL
+ * @return       Error code or 0 on success
  *
- * @see uriParseUriExA
- * @see uriParseSingleUriA
- * @see uriParseSingleUriExA
- * @see uriToStringA
- * @since 0.3.0
- * @deprecated Deprecated since 0.9.0, please migrate to uriParseSingleUriA (with "Single").
+ * @see uriParseSingleUriInfoExA
+ * @see uriNormalizeSyntaxMaskFromInfoA
+ * @since 0.9.10
  */
-URI_PUBLIC int URI_FUNC(ParseUri)(URI_TYPE(ParserState) * state,
-		const URI_CHAR * text);
+URI_PUBLIC int URI_FUNC(CollectComponentFlags)(const URI_TYPE(Uri) * uri,
+		UriParseInfo * info);
 
 
 
 /**
- * Parses a single RFC 3986 %URI.
- * Uses default libc-based memory manager.
+ * Determines in constant time which components of a %URI may need
+ * normalization, based on the component flags of <c>info</c>.
+ * The result is a superset of what uriNormalizeSyntaxMaskRequiredExA
+ * reports, so components not in the result can be skipped safely.
  *
- * @param uri         <b>OUT</b>: Output %URI, must not be NULL
- * @param text        <b>IN</b>: Pointer to the first character to parse,
- *                               must not be NULL
- * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
- *                                causing a syntax error, can be NULL;
- *                                only set when URI_ERROR_SYNTAX was returned
- * @return            0 on success, error code otherwise
+ * @param uri    <b>IN</b>: %URI that <c>info</c> was collected for, must not be NULL
+ * @param info   <b>IN</b>: Info with component flags, must not be NULL
+ * @return       Normalization mask, see UriNormalizationMask
  *
- * @see uriParseSingleUriExA
- * @see uriParseSingleUriExMmA
- * @see uriToStringA
- * @since 0.9.0
+ * @see uriCollectComponentFlagsA
+ * @see uriNormalizeSyntaxExA
+ * @see uriNormalizeSyntaxMaskRequiredExA
+ * @since 0.9.10
  */
-URI_PUBLIC int URI_FUNC(ParseSingleUri)(URI_TYPE(Uri) * uri,
-		const URI_CHAR * text, const URI_CHAR ** errorPos);
+URI_PUBLIC unsigned int URI_FUNC(NormalizeSyntaxMaskFromInfo)(
+		const URI_TYPE(Uri) * uri, const UriParseInfo * info);
 
 
 
 /**
- * Parses a single RFC 3986 %URI.
+ * Normalizes a %URI like uriNormalizeSyntaxA, but only the components
+ * that the component flags of <c>info</c> point at (see
+ * uriNormalizeSyntaxMaskFromInfoA): a %URI without any returns in
+ * constant time, without scanning its components. If anything was
+ * normalized, the flags of <c>info</c> are collected anew.
  * Uses default libc-based memory manager.
  *
- * @param uri         <b>OUT</b>: Output %URI, must not be NULL
- * @param first       <b>IN</b>: Pointer to the first character to parse,
- *                               must not be NULL
- * @param afterLast   <b>IN</b>: Pointer to the character after the last to
- *                               parse, can be NULL
- *                               (to use first + strlen(first))
- * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
- *                                causing a syntax error, can be NULL;
- *                                only set when URI_ERROR_SYNTAX was returned
- * @return            0 on success, error code otherwise
+ * @param uri    <b>INOUT</b>: %URI to normalize, must not be NULL
+ * @param info   <b>INOUT</b>: Info with component flags for <c>uri</c>,
+ *                             e.g. from uriParseSingleUriInfoExA, must not be NULL
+ * @return       Error code or 0 on success
  *
- * @see uriParseSingleUriA
- * @see uriParseSingleUriExMmA
- * @see uriToStringA
- * @since 0.9.0
+ * @see uriNormalizeSyntaxInfoMmA
+ * @see uriNormalizeSyntaxExA
+ * @since 0.9.10
  */
-URI_PUBLIC int URI_FUNC(ParseSingleUriEx)(URI_TYPE(Uri) * uri,
-		const URI_CHAR * first, const URI_CHAR * afterLast,
-		const URI_CHAR ** errorPos);
+URI_PUBLIC int URI_FUNC(NormalizeSyntaxInfo)(URI_TYPE(Uri) * uri,
+		UriParseInfo * info);
 
 
 
 /**
- * Parses a single RFC 3986 %URI.
+ * Normalizes a %URI like uriNormalizeSyntaxInfoA.
  *
- * @param uri         <b>OUT</b>: Output %URI, must not be NULL
- * @param first       <b>IN</b>: Pointer to the first character to parse,
- *                               must not be NULL
- * @param afterLast   <b>IN</b>: Pointer to the character after the last to
- *                               parse, can be NULL
- *                               (to use first + strlen(first))
- * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character
- *                                causing a syntax error, can be NULL;
- *                                only set when URI_ERROR_SYNTAX was returned
- * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc
- * @return            0 on success, error code otherwise
+ * @param uri      <b>INOUT</b>: %URI to normalize, must not be NULL
+ * @param info     <b>INOUT</b>: Info with component flags for <c>uri</c>, must not be NULL
+ * @param memory   <b>IN</b>: Memory manager to use, NULL for default libc
+ * @return         Error code or 0 on success
  *
- * @see uriParseSingleUriA
- * @see uriParseSingleUriExA
- * @see uriToStringA
- * @since 0.9.0
+ * @see uriNormalizeSyntaxInfoA
+ * @see uriNormalizeSyntaxExMmA
+ * @since 0.9.10
  */
-URI_PUBLIC int URI_FUNC(ParseSingleUriExMm)(URI_TYPE(Uri) * uri,
-		const URI_CHAR * first, const URI_CHAR * afterLast,
-		const URI_CHAR ** errorPos, UriMemoryManager * memory);
+URI_PUBLIC int URI_FUNC(NormalizeSyntaxInfoMm)(URI_TYPE(Uri) * uri,
+		UriParseInfo * info, UriMemoryManager * memory);
 
 
 
@@ -670,6 +1964,54 @@ URI_PUBLIC UriBool URI_FUNC(EqualsUri)(const URI_TYPE(Uri) * a,
 
 
 
+/**
+ * Checks two URIs for the same origin, i.e. same scheme, host and
+ * effective port, as needed for CORS or redirect checks.
+ * Scheme and host are compared ignoring the case of ASCII letters,
+ * IP addresses by value (so <c>"[::1]"</c> equals <c>"[0::1]"</c>),
+ * and a missing port means the default port of the scheme
+ * (80 for http and ws, 443 for https and wss, 21 for ftp).
+ * URIs without host have an opaque origin that is not the same
+ * as any other. Nothing is allocated.
+ *
+ * @param a   <b>IN</b>: First %URI, can be NULL
+ * @param b   <b>IN</b>: Second %URI, can be NULL
+ * @return    <c>URI_TRUE</c> when of the same origin, <c>URI_FALSE</c> else
+ *            (including when a port exceeds 65535)
+ *
+ * @see uriIsUnderBaseA
+ * @see uriOriginHashA
+ * @since 0.9.10
+ */
+URI_PUBLIC UriBool URI_FUNC(SameOrigin)(const URI_TYPE(Uri) * a,
+		const URI_TYPE(Uri) * b);
+
+
+
+/**
+ * Checks whether a %URI lies under a base %URI, e.g. for redirect
+ * allow-lists: both must be of the same origin (see uriSameOriginA)
+ * and the path segments of the base must start the path of the %URI,
+ * compared segment by segment, so <c>"/docs"</c> covers <c>"/docs"</c>
+ * and <c>"/docs/a"</c> but not <c>"/docsx"</c>, and <c>"/docs/"</c>
+ * covers <c>"/docs/"</c> and <c>"/docs/a"</c> but not <c>"/docs"</c>.
+ * Query and fragment are ignored. Segments are compared as-is,
+ * consider uriNormalizeSyntaxA beforehand; dot segments like
+ * <c>".."</c> (even percent-encoded) make the result <c>URI_FALSE</c>
+ * to not let <c>"/docs/../admin"</c> pass. Nothing is allocated.
+ *
+ * @param uri    <b>IN</b>: %URI to check, can be NULL
+ * @param base   <b>IN</b>: Base %URI, can be NULL
+ * @return       <c>URI_TRUE</c> when under the base, <c>URI_FALSE</c> else
+ *
+ * @see uriSameOriginA
+ * @since 0.9.10
+ */
+URI_PUBLIC UriBool URI_FUNC(IsUnderBase)(const URI_TYPE(Uri) * uri,
+		const URI_TYPE(Uri) * base);
+
+
+
 /**
  * Calculates the number of characters needed to store the
  * string representation of the given %URI excluding the
@@ -709,6 +2051,94 @@ URI_PUBLIC int URI_FUNC(ToString)(URI_CHAR * dest, const URI_TYPE(Uri) * uri,
 
 
 
+/**
+ * Determines the number of characters needed to convert
+ * an IRI to a %URI using uriIriToUriStringA,
+ * <b>excluding</b> the terminator.
+ *
+ * @param first          <b>IN</b>: Pointer to the first character of the IRI, must not be NULL
+ * @param afterLast      <b>IN</b>: Pointer to the character after the last of the IRI,
+ *                                  can be NULL (to use first + strlen(first))
+ * @param charsRequired  <b>OUT</b>: Length of the %URI, must not be NULL
+ * @param errorPos       <b>OUT</b>: Pointer to a pointer to the first ill-formed
+ *                                   character, can be NULL;
+ *                                   only set when URI_ERROR_SYNTAX was returned
+ * @return               Error code or 0 on success
+ *
+ * @see uriIriToUriStringA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(IriToUriStringCharsRequired)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, int * charsRequired,
+		const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Converts an IRI to a %URI as described in
+ * <a href="https://datatracker.ietf.org/doc/html/rfc3987#section-3.1">section 3.1 of RFC 3987</a>:
+ * every non-ASCII character is encoded as UTF-8 and each of the
+ * resulting bytes is percent-encoded; ASCII characters are copied as-is.
+ * The encoding of the input (UTF-8 for the ANSI variant, UTF-16 or
+ * UTF-32 for the wide variant) is validated while converting.
+ * Host names are not converted to Punycode.
+ *
+ * @param dest           <b>OUT</b>: Output destination, must not be NULL
+ * @param first          <b>IN</b>: Pointer to the first character of the IRI, must not be NULL
+ * @param afterLast      <b>IN</b>: Pointer to the character after the last of the IRI,
+ *                                  can be NULL (to use first + strlen(first))
+ * @param maxChars       <b>IN</b>: Maximum number of characters to write <b>including</b> terminator
+ * @param charsWritten   <b>OUT</b>: Number of characters written including terminator, can be NULL
+ * @param errorPos       <b>OUT</b>: Pointer to a pointer to the first ill-formed
+ *                                   character, can be NULL;
+ *                                   only set when URI_ERROR_SYNTAX was returned
+ * @return               Error code or 0 on success
+ *
+ * @see uriIriToUriStringCharsRequiredA
+ * @see uriParseSingleIriExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(IriToUriString)(URI_CHAR * dest,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		int maxChars, int * charsWritten, const URI_CHAR ** errorPos);
+
+
+
+/**
+ * Splits an absolute %URI into the origin-form request-target
+ * <c>"/path?query"</c> (RFC 9112 section 3.2.1) and the value
+ * <c>"host[:port]"</c> of the Host header field, as done by forward
+ * proxies when passing on absolute-form requests.
+ * The fragment and user info are dropped.
+ *
+ * If the %URI is not the owner of its text and its components
+ * are adjacent in that text (which is true for
+ * fresh results of uriParseSingleUriExA), both ranges point
+ * into that text and the buffer is left untouched.
+ * Otherwise, e.g. after normalization or for URIs like
+ * <c>"http://example.org?query"</c> that need a slash inserted, both
+ * are written to the buffer, without terminator, and the ranges point
+ * into the buffer.  A buffer of one character more than reported
+ * by uriToStringCharsRequiredA is always sufficient.
+ *
+ * @param uri            <b>IN</b>: %URI to split, must have a host
+ * @param requestTarget  <b>OUT</b>: Request-target in origin-form
+ * @param host           <b>OUT</b>: Host with port, if any
+ * @param buffer         <b>OUT</b>: Buffer to use if needed, can be NULL
+ * @param maxChars       <b>IN</b>: Size of the buffer in characters
+ * @param charsWritten   <b>OUT</b>: Number of characters written to the buffer, can be NULL
+ * @return               Error code or 0 on success
+ *
+ * @see uriToStringA
+ * @see uriParseOriginFormExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ToOriginForm)(const URI_TYPE(Uri) * uri,
+		URI_TYPE(TextRange) * requestTarget, URI_TYPE(TextRange) * host,
+		URI_CHAR * buffer, int maxChars, int * charsWritten);
+
+
+
 /**
  * Copies a %URI structure.
  *
@@ -1197,6 +2627,108 @@ URI_PUBLIC int URI_FUNC(FreeQueryListMm)(URI_TYPE(QueryList) * queryList,
 
 
 
+/**
+ * Prepares iterating the segments of a raw path text,
+ * e.g. "/one/two/" for segments "one", "two" and "".
+ * A single leading slash is skipped; "" and "/" hold no segments.
+ * Other than walking the linked list of ::UriPathSegmentA,
+ * iteration neither allocates nor follows pointers.
+ *
+ * @param iterator   <b>OUT</b>: Iterator to initialize
+ * @param first      <b>IN</b>: Pointer to first character of the path, can be NULL together with <c>afterLast</c>
+ * @param afterLast  <b>IN</b>: Pointer to character after the last one still in
+ * @return           Error code or 0 on success
+ *
+ * @see uriPathIteratorNextA
+ * @see uriUnescapeRangeExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(PathIteratorInit)(URI_TYPE(PathIterator) * iterator,
+		const URI_CHAR * first, const URI_CHAR * afterLast);
+
+
+
+/**
+ * Advances to the next path segment.
+ * The segment text points into the path text
+ * and is not percent-decoded.
+ *
+ * @param iterator  <b>INOUT</b>: Iterator prepared by uriPathIteratorInitA
+ * @param segment   <b>OUT</b>: Raw segment text, possibly empty
+ * @return          <c>URI_TRUE</c> if a segment was found, <c>URI_FALSE</c> at the end
+ *
+ * @see uriPathIteratorInitA
+ * @since 0.9.10
+ */
+URI_PUBLIC UriBool URI_FUNC(PathIteratorNext)(URI_TYPE(PathIterator) * iterator,
+		URI_TYPE(TextRange) * segment);
+
+
+
+/**
+ * Prepares iterating the key/value pairs of a raw query text,
+ * e.g. of <c>uri.query</c>. Pairs are found by the same rules as
+ * uriDissectQueryMallocA but without any allocation.
+ *
+ * @param iterator   <b>OUT</b>: Iterator to initialize
+ * @param first      <b>IN</b>: Pointer to first character <b>after</b> '?', can be NULL together with <c>afterLast</c>
+ * @param afterLast  <b>IN</b>: Pointer to character after the last one still in
+ * @return           Error code or 0 on success
+ *
+ * @see uriQueryIteratorNextA
+ * @see uriDissectQueryMallocA
+ * @see uriUnescapeRangeExA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(QueryIteratorInit)(URI_TYPE(QueryIterator) * iterator,
+		const URI_CHAR * first, const URI_CHAR * afterLast);
+
+
+
+/**
+ * Advances to the next key/value pair of a query.
+ * Key and value point into the query text and are not percent-decoded.
+ * For pairs without '=', the value is a {NULL, NULL} range.
+ *
+ * @param iterator  <b>INOUT</b>: Iterator prepared by uriQueryIteratorInitA
+ * @param key       <b>OUT</b>: Raw key text, possibly empty
+ * @param value     <b>OUT</b>: Raw value text, {NULL, NULL} if missing
+ * @return          <c>URI_TRUE</c> if a pair was found, <c>URI_FALSE</c> at the end
+ *
+ * @see uriQueryIteratorInitA
+ * @since 0.9.10
+ */
+URI_PUBLIC UriBool URI_FUNC(QueryIteratorNext)(URI_TYPE(QueryIterator) * iterator,
+		URI_TYPE(TextRange) * key, URI_TYPE(TextRange) * value);
+
+
+
+/**
+ * Unescapes percent-encoded groups of a text range into a caller-provided
+ * buffer, e.g. to get a decoded view of a path segment or query value.
+ * Since decoding never grows text, <c>afterLast - first + 1</c> characters
+ * are always sufficient. The output is zero-terminated.
+ * A {NULL, NULL} source range results in a {NULL, NULL} view.
+ *
+ * @param source            <b>IN</b>: Text range to decode
+ * @param dest              <b>OUT</b>: Buffer to write the decoded text to
+ * @param maxChars          <b>IN</b>: Capacity of <c>dest</c> in characters, including the terminator
+ * @param decoded           <b>OUT</b>: View of the decoded text within <c>dest</c>
+ * @param plusToSpace       <b>IN</b>: Whether to convert '+' to ' ' or not
+ * @param breakConversion   <b>IN</b>: Line break conversion mode
+ * @return                  Error code or 0 on success
+ *
+ * @see uriUnescapeInPlaceExA
+ * @see uriPathIteratorNextA
+ * @see uriQueryIteratorNextA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(UnescapeRangeEx)(const URI_TYPE(TextRange) * source,
+		URI_CHAR * dest, int maxChars, URI_TYPE(TextRange) * decoded,
+		UriBool plusToSpace, UriBreakConversion breakConversion);
+
+
+
 /**
  * Makes the %URI hold copies of strings so that it no longer depends
  * on the original %URI string.  If the %URI is already owner of copies,
@@ -1466,6 +2998,28 @@ URI_PUBLIC UriBool URI_FUNC(IsWellFormedPort)(const URI_CHAR * first, const URI_
 
 
 
+/**
+ * Converts port text (e.g. <c>uri.portText</c>, also after uriSetPortTextA)
+ * to its numeric value.
+ *
+ * @param value      <b>OUT</b>: Numeric port, 0 for empty port text
+ *                               and values out of range
+ * @param first      <b>IN</b>: Pointer to first character
+ * @param afterLast  <b>IN</b>: Pointer to character after the last one still in
+ * @return           <c>URI_SUCCESS</c> on success,
+ *                   <c>URI_ERROR_PORT_OUT_OF_RANGE</c> for values above 65535,
+ *                   else an error code
+ *
+ * @see uriIsWellFormedPortA
+ * @see uriParseSingleUriInfoExA
+ * @see uriSetPortTextA
+ * @since 0.9.10
+ */
+URI_PUBLIC int URI_FUNC(ParsePortValue)(unsigned int * value,
+		const URI_CHAR * first, const URI_CHAR * afterLast);
+
+
+
 /**
  * Determines if the given text range contains a well-formed query
  * according to RFC 3986 or not.
@@ -0,0 +1,1023 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file Uri.hpp
+ * Holds optional C++ helpers on top of the C interface of uriparser.
+ * NOTE: The C interface remains the primary interface,
+ *       nothing in here is needed to use uriparser from C++.
+ */
+
+#ifndef URI_HPP
+#define URI_HPP 1
+
+
+
+#include "Uri.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+
+
+
+#if defined(_MSVC_LANG)
+# define URI_CPLUSPLUS  _MSVC_LANG
+#else
+# define URI_CPLUSPLUS  __cplusplus
+#endif
+
+#if (URI_CPLUSPLUS >= 201703L) && defined(__has_include)
+# if __has_include(<memory_resource>)
+#  include <memory_resource>
+#  define URI_HAVE_PMR  1
+# endif
+#endif
+
+
+
+namespace uriparser {
+
+
+
+#ifdef URI_ENABLE_ANSI
+
+/**
+ * Range over the raw segments of a path text for use with range-based for,
+ * based on ::uriPathIteratorInitA and ::uriPathIteratorNextA.
+ * Neither the range nor its iterators allocate;
+ * segments point into the path text.
+ *
+ * @see QueryPairs
+ * @see uriUnescapeRangeExA
+ * @since 0.9.10
+ */
+class PathSegments {
+public:
+	/**
+	 * Input iterator yielding one ::UriTextRangeA per segment.
+	 */
+	class iterator {
+	public:
+		typedef std::input_iterator_tag iterator_category; /**< Iterator category */
+		typedef UriTextRangeA value_type; /**< Value type */
+		typedef std::ptrdiff_t difference_type; /**< Difference type */
+		typedef const UriTextRangeA * pointer; /**< Pointer type */
+		typedef const UriTextRangeA & reference; /**< Reference type */
+
+		/**
+		 * Creates an end iterator.
+		 */
+		iterator() noexcept : state(), current(), atEnd(true) { }
+
+		/**
+		 * Creates an iterator at the first segment left in <c>pathIterator</c>.
+		 *
+		 * @param pathIterator  <b>IN</b>: Iterator state to start from
+		 */
+		explicit iterator(const UriPathIteratorA & pathIterator) noexcept
+				: state(pathIterator), current(), atEnd(false) {
+			++(*this);
+		}
+
+		reference operator*() const noexcept {
+			return this->current;
+		}
+
+		pointer operator->() const noexcept {
+			return &(this->current);
+		}
+
+		iterator & operator++() noexcept {
+			this->atEnd = (uriPathIteratorNextA(&(this->state), &(this->current)) == URI_FALSE);
+			return *this;
+		}
+
+		iterator operator++(int) noexcept {
+			const iterator before = *this;
+			++(*this);
+			return before;
+		}
+
+		bool operator==(const iterator & other) const noexcept {
+			if (this->atEnd || other.atEnd) {
+				return this->atEnd == other.atEnd;
+			}
+			return (this->current.first == other.current.first)
+					&& (this->current.afterLast == other.current.afterLast);
+		}
+
+		bool operator!=(const iterator & other) const noexcept {
+			return !(*this == other);
+		}
+
+	private:
+		UriPathIteratorA state;
+		UriTextRangeA current;
+		bool atEnd;
+	};
+
+	/**
+	 * Creates a range over the segments of a path text, e.g. "/one/two".
+	 * Invalid input results in an empty range.
+	 *
+	 * @param first      <b>IN</b>: Pointer to first character of the path
+	 * @param afterLast  <b>IN</b>: Pointer to character after the last one still in
+	 */
+	PathSegments(const char * first, const char * afterLast) noexcept {
+		if (uriPathIteratorInitA(&(this->state), first, afterLast) != URI_SUCCESS) {
+			this->state.next = NULL;
+			this->state.afterLast = NULL;
+		}
+	}
+
+	/**
+	 * Creates a range over the segments of a path text.
+	 *
+	 * @param path  <b>IN</b>: Path text
+	 */
+	explicit PathSegments(const UriTextRangeA & path) noexcept
+			: PathSegments(path.first, path.afterLast) { }
+
+	iterator begin() const noexcept {
+		return iterator(this->state);
+	}
+
+	iterator end() const noexcept {
+		return iterator();
+	}
+
+private:
+	UriPathIteratorA state;
+};
+
+
+
+/**
+ * Raw key/value pair of a query, as yielded by ::QueryPairs.
+ *
+ * @since 0.9.10
+ */
+struct QueryPair {
+	UriTextRangeA key; /**< Raw key text, possibly empty */
+	UriTextRangeA value; /**< Raw value text, {NULL, NULL} for pairs without "=" */
+
+	/**
+	 * Tells whether the pair had a "=" separator.
+	 *
+	 * @return  Whether the value is present
+	 */
+	bool hasValue() const noexcept {
+		return this->value.first != NULL;
+	}
+};
+
+
+
+/**
+ * Range over the raw key/value pairs of a query for use with range-based for,
+ * based on ::uriQueryIteratorInitA and ::uriQueryIteratorNextA.
+ * Pairs are found by the same rules as ::uriDissectQueryMallocA but
+ * neither the range nor its iterators allocate; keys and values
+ * point into the query text. Decode with ::uriUnescapeRangeExA as needed.
+ *
+ * @see PathSegments
+ * @since 0.9.10
+ */
+class QueryPairs {
+public:
+	/**
+	 * Input iterator yielding one ::QueryPair per pair.
+	 */
+	class iterator {
+	public:
+		typedef std::input_iterator_tag iterator_category; /**< Iterator category */
+		typedef QueryPair value_type; /**< Value type */
+		typedef std::ptrdiff_t difference_type; /**< Difference type */
+		typedef const QueryPair * pointer; /**< Pointer type */
+		typedef const QueryPair & reference; /**< Reference type */
+
+		/**
+		 * Creates an end iterator.
+		 */
+		iterator() noexcept : state(), current(), atEnd(true) { }
+
+		/**
+		 * Creates an iterator at the first pair left in <c>queryIterator</c>.
+		 *
+		 * @param queryIterator  <b>IN</b>: Iterator state to start from
+		 */
+		explicit iterator(const UriQueryIteratorA & queryIterator) noexcept
+				: state(queryIterator), current(), atEnd(false) {
+			++(*this);
+		}
+
+		reference operator*() const noexcept {
+			return this->current;
+		}
+
+		pointer operator->() const noexcept {
+			return &(this->current);
+		}
+
+		iterator & operator++() noexcept {
+			this->atEnd = (uriQueryIteratorNextA(&(this->state),
+					&(this->current.key), &(this->current.value)) == URI_FALSE);
+			return *this;
+		}
+
+		iterator operator++(int) noexcept {
+			const iterator before = *this;
+			++(*this);
+			return before;
+		}
+
+		bool operator==(const iterator & other) const noexcept {
+			if (this->atEnd || other.atEnd) {
+				return this->atEnd == other.atEnd;
+			}
+			return this->current.key.first == other.current.key.first;
+		}
+
+		bool operator!=(const iterator & other) const noexcept {
+			return !(*this == other);
+		}
+
+	private:
+		UriQueryIteratorA state;
+		QueryPair current;
+		bool atEnd;
+	};
+
+	/**
+	 * Creates a range over the pairs of a query text, e.g. "k1=v1&amp;k2".
+	 * Invalid input results in an empty range.
+	 *
+	 * @param first      <b>IN</b>: Pointer to first character <b>after</b> '?'
+	 * @param afterLast  <b>IN</b>: Pointer to character after the last one still in
+	 */
+	QueryPairs(const char * first, const char * afterLast) noexcept {
+		if (uriQueryIteratorInitA(&(this->state), first, afterLast) != URI_SUCCESS) {
+			this->state.next = NULL;
+			this->state.afterLast = NULL;
+		}
+	}
+
+	/**
+	 * Creates a range over the pairs of the query of a %URI.
+	 *
+	 * @param uri  <b>IN</b>: %URI whose query to iterate
+	 */
+	explicit QueryPairs(const UriUriA & uri) noexcept
+			: QueryPairs(uri.query.first, uri.query.afterLast) { }
+
+	iterator begin() const noexcept {
+		return iterator(this->state);
+	}
+
+	iterator end() const noexcept {
+		return iterator();
+	}
+
+private:
+	UriQueryIteratorA state;
+};
+
+#endif  // URI_ENABLE_ANSI
+
+
+
+#if (URI_CPLUSPLUS >= 201402L)
+
+/**
+ * Range of offsets [first, afterLast) into the text of a ::LiteralUri.
+ * A range that was not present in the text has both members set to
+ * <c>LiteralUri::npos</c>, mirroring NULL pointers in ::UriTextRangeA.
+ *
+ * @since 0.9.10
+ */
+struct LiteralRange {
+	std::size_t first = static_cast<std::size_t>(-1); /**< Offset of first character, npos if not present */
+	std::size_t afterLast = static_cast<std::size_t>(-1); /**< Offset right after the last character, npos if not present */
+
+	/**
+	 * Tells whether the component was present in the text.
+	 *
+	 * @return  Whether the range is set
+	 */
+	constexpr bool isSet() const noexcept {
+		return this->first != static_cast<std::size_t>(-1);
+	}
+
+	/**
+	 * Returns the number of characters in the range.
+	 *
+	 * @return  Length, 0 for ranges that are not set
+	 */
+	constexpr std::size_t size() const noexcept {
+		return this->isSet() ? (this->afterLast - this->first) : 0;
+	}
+};
+
+
+
+/**
+ * Kind of host of a ::LiteralUri.
+ *
+ * @since 0.9.10
+ */
+enum class LiteralHostType {
+	NONE, /**< No authority */
+	REGNAME, /**< Registered name, possibly empty */
+	IP4, /**< IPv4 address */
+	IP6, /**< IPv6 address, without brackets */
+	IP_FUTURE /**< IPvFuture address, without brackets */
+};
+
+
+
+/**
+ * Component offsets of a %URI reference produced by ::parseLiteralUri,
+ * usable in constant expressions.
+ * Offsets follow the conventions of ::UriUriA, e.g. host text
+ * of IP literals excludes the surrounding brackets.
+ * The text itself is not copied; it needs to outlive the offsets,
+ * which is always the case for string literals.
+ *
+ * @see parseLiteralUri
+ * @see operator""_uri
+ * @since 0.9.10
+ */
+struct LiteralUri {
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1); /**< Marker for missing offsets */
+
+	const char * text = nullptr; /**< Text that was parsed */
+	std::size_t length = 0; /**< Length of the text */
+	bool valid = false; /**< Whether the text is a valid %URI reference */
+	std::size_t errorPos = npos; /**< Offset of the first offending character, length for premature end, npos if valid */
+
+	LiteralRange scheme; /**< Scheme (e.g. "http") */
+	LiteralRange userInfo; /**< User info (e.g. "user:pass") */
+	LiteralRange hostText; /**< Host text (set for all hosts, excluding square brackets) */
+	LiteralHostType hostType = LiteralHostType::NONE; /**< Kind of host */
+	LiteralRange portText; /**< Port (e.g. "80") */
+	LiteralRange path; /**< Path including leading slash, if any (e.g. "/one/two") */
+	LiteralRange query; /**< Query without leading "?" */
+	LiteralRange fragment; /**< Fragment without leading "#" */
+
+	/**
+	 * Converts a range of offsets into a text range pointing
+	 * into the text that was parsed.
+	 *
+	 * @param range  <b>IN</b>: Range of this instance
+	 * @return       Text range, both members NULL if the range is not set
+	 */
+	UriTextRangeA toTextRange(const LiteralRange & range) const noexcept {
+		UriTextRangeA textRange;
+		if (range.isSet()) {
+			textRange.first = this->text + range.first;
+			textRange.afterLast = this->text + range.afterLast;
+		} else {
+			textRange.first = NULL;
+			textRange.afterLast = NULL;
+		}
+		return textRange;
+	}
+};
+
+
+
+namespace detail {
+
+enum : unsigned int {
+	LITERAL_ALLOW_COLON = 1 << 0,
+	LITERAL_ALLOW_AT = 1 << 1,
+	LITERAL_ALLOW_SLASH = 1 << 2,
+	LITERAL_ALLOW_QUESTION = 1 << 3,
+	LITERAL_ALLOW_PCHAR = LITERAL_ALLOW_COLON | LITERAL_ALLOW_AT
+};
+
+constexpr bool isLiteralAlpha(char c) noexcept {
+	return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'));
+}
+
+constexpr bool isLiteralDigit(char c) noexcept {
+	return (c >= '0') && (c <= '9');
+}
+
+constexpr bool isLiteralHexdig(char c) noexcept {
+	return isLiteralDigit(c) || ((c >= 'a') && (c <= 'f'))
+			|| ((c >= 'A') && (c <= 'F'));
+}
+
+constexpr bool isLiteralUnreserved(char c) noexcept {
+	return isLiteralAlpha(c) || isLiteralDigit(c)
+			|| (c == '-') || (c == '.') || (c == '_') || (c == '~');
+}
+
+constexpr bool isLiteralSubDelim(char c) noexcept {
+	return (c == '!') || (c == '$') || (c == '&') || (c == '\'')
+			|| (c == '(') || (c == ')') || (c == '*') || (c == '+')
+			|| (c == ',') || (c == ';') || (c == '=');
+}
+
+/*
+ * Eats [pctEncoded], [subDelims], [unreserved] and the extra
+ * characters selected by allowMask, returns the offset
+ * of the first character not eaten. Sets errorPos on
+ * broken percent-encoding.
+ */
+constexpr std::size_t scanLiteral(const char * text, std::size_t pos,
+		std::size_t afterLast, unsigned int allowMask,
+		std::size_t & errorPos) noexcept {
+	while (pos < afterLast) {
+		const char c = text[pos];
+		if (isLiteralUnreserved(c) || isLiteralSubDelim(c)
+				|| ((c == ':') && (allowMask & LITERAL_ALLOW_COLON))
+				|| ((c == '@') && (allowMask & LITERAL_ALLOW_AT))
+				|| ((c == '/') && (allowMask & LITERAL_ALLOW_SLASH))
+				|| ((c == '?') && (allowMask & LITERAL_ALLOW_QUESTION))) {
+			pos++;
+		} else if (c == '%') {
+			if ((afterLast - pos < 3) || !isLiteralHexdig(text[pos + 1])) {
+				errorPos = (afterLast - pos < 2) ? afterLast : pos + 1;
+				return pos;
+			} else if (!isLiteralHexdig(text[pos + 2])) {
+				errorPos = pos + 2;
+				return pos;
+			}
+			pos += 3;
+		} else {
+			break;
+		}
+	}
+	return pos;
+}
+
+/* Same as ParseIpFourAddress: four dec-octets without leading zeros */
+constexpr bool isLiteralIp4(const char * text, std::size_t first,
+		std::size_t afterLast) noexcept {
+	int octetsDone = 0;
+	std::size_t pos = first;
+	for (;;) {
+		const std::size_t octetFirst = pos;
+		unsigned int value = 0;
+		while ((pos < afterLast) && isLiteralDigit(text[pos])
+				&& (pos - octetFirst < 3)) {
+			value = 10 * value + static_cast<unsigned int>(text[pos] - '0');
+			pos++;
+		}
+		if ((pos == octetFirst) || (value > 255)
+				|| ((pos - octetFirst > 1) && (text[octetFirst] == '0'))) {
+			return false;
+		}
+		octetsDone++;
+		if (octetsDone == 4) {
+			return pos == afterLast;
+		}
+		if ((pos >= afterLast) || (text[pos] != '.')) {
+			return false;
+		}
+		pos++;
+	}
+}
+
+/* [IPv6address] as in RFC 3986 section 3.2.2 */
+constexpr bool isLiteralIp6(const char * text, std::size_t first,
+		std::size_t afterLast) noexcept {
+	int quadsDone = 0;
+	bool zipperEver = false;
+	std::size_t pos = first;
+
+	if ((afterLast - first >= 2) && (text[first] == ':')
+			&& (text[first + 1] == ':')) {
+		zipperEver = true;
+		pos += 2;
+		if (pos == afterLast) {
+			return true;
+		}
+	}
+
+	for (;;) {
+		const std::size_t quadFirst = pos;
+		while ((pos < afterLast) && isLiteralHexdig(text[pos])) {
+			pos++;
+		}
+		if ((pos < afterLast) && (text[pos] == '.')) {
+			/* Trailing IPv4 address counts as two quads */
+			if (!isLiteralIp4(text, quadFirst, afterLast)) {
+				return false;
+			}
+			quadsDone += 2;
+			break;
+		}
+		if ((pos == quadFirst) || (pos - quadFirst > 4)) {
+			return false;
+		}
+		quadsDone++;
+		if (pos == afterLast) {
+			break;
+		}
+		if ((text[pos] != ':') || (pos + 1 == afterLast)) {
+			/* Not a separator or single trailing ":" */
+			return false;
+		}
+		pos++;
+		if (text[pos] == ':') {
+			if (zipperEver) {
+				return false;
+			}
+			zipperEver = true;
+			pos++;
+			if (pos == afterLast) {
+				break;
+			}
+		}
+	}
+
+	return zipperEver ? (quadsDone <= 7) : (quadsDone == 8);
+}
+
+/* [ipFuture]-><v>[HEXDIG][hexZero]<.>[ipFutLoop] */
+constexpr bool isLiteralIpFuture(const char * text, std::size_t first,
+		std::size_t afterLast) noexcept {
+	std::size_t pos = first + 1;
+
+	while ((pos < afterLast) && isLiteralHexdig(text[pos])) {
+		pos++;
+	}
+	if ((pos == first + 1) || (pos >= afterLast) || (text[pos] != '.')) {
+		return false;
+	}
+	pos++;
+	if (pos == afterLast) {
+		return false;
+	}
+	for (; pos < afterLast; pos++) {
+		if (!isLiteralUnreserved(text[pos]) && !isLiteralSubDelim(text[pos])
+				&& (text[pos] != ':')) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* [authority] between "//" and the next "/", "?", "#" or the end */
+constexpr bool parseLiteralAuthority(LiteralUri & uri, std::size_t first,
+		std::size_t afterLast) noexcept {
+	const char * const text = uri.text;
+	std::size_t hostFirst = first;
+	std::size_t pos = first;
+
+	/* User info */
+	while ((pos < afterLast) && (text[pos] != '@')) {
+		pos++;
+	}
+	if (pos < afterLast) {
+		const std::size_t afterUserInfo = scanLiteral(text, first, pos,
+				LITERAL_ALLOW_COLON, uri.errorPos);
+		if (uri.errorPos != LiteralUri::npos) {
+			return false;
+		}
+		if (afterUserInfo != pos) {
+			uri.errorPos = afterUserInfo;
+			return false;
+		}
+		uri.userInfo.first = first;
+		uri.userInfo.afterLast = pos;
+		hostFirst = pos + 1;
+	}
+
+	/* Host */
+	if ((hostFirst < afterLast) && (text[hostFirst] == '[')) {
+		pos = hostFirst + 1;
+		while ((pos < afterLast) && (text[pos] != ']')) {
+			pos++;
+		}
+		if (pos >= afterLast) {
+			uri.errorPos = afterLast;
+			return false;
+		}
+		if ((pos > hostFirst + 1)
+				&& ((text[hostFirst + 1] == 'v') || (text[hostFirst + 1] == 'V'))) {
+			if (!isLiteralIpFuture(text, hostFirst + 1, pos)) {
+				uri.errorPos = hostFirst + 1;
+				return false;
+			}
+			uri.hostType = LiteralHostType::IP_FUTURE;
+		} else {
+			if (!isLiteralIp6(text, hostFirst + 1, pos)) {
+				uri.errorPos = hostFirst + 1;
+				return false;
+			}
+			uri.hostType = LiteralHostType::IP6;
+		}
+		uri.hostText.first = hostFirst + 1;
+		uri.hostText.afterLast = pos;
+		pos++;
+	} else {
+		pos = scanLiteral(text, hostFirst, afterLast, 0, uri.errorPos);
+		if (uri.errorPos != LiteralUri::npos) {
+			return false;
+		}
+		uri.hostText.first = hostFirst;
+		uri.hostText.afterLast = pos;
+		uri.hostType = isLiteralIp4(text, hostFirst, pos)
+				? LiteralHostType::IP4
+				: LiteralHostType::REGNAME;
+	}
+
+	/* Port */
+	if (pos < afterLast) {
+		if (text[pos] != ':') {
+			uri.errorPos = pos;
+			return false;
+		}
+		pos++;
+		uri.portText.first = pos;
+		for (; pos < afterLast; pos++) {
+			if (!isLiteralDigit(text[pos])) {
+				uri.errorPos = pos;
+				return false;
+			}
+		}
+		uri.portText.afterLast = afterLast;
+	}
+
+	return true;
+}
+
+/* Not constexpr on purpose: reaching it in a constant expression fails compilation */
+inline void invalidUriLiteral(std::size_t errorPos) {
+	(void)errorPos;
+	throw std::invalid_argument("uriparser: Invalid URI literal");
+}
+
+}  // namespace detail
+
+
+
+/**
+ * Parses a %URI reference following the same RFC 3986 grammar
+ * as ::uriParseSingleUriA, but in a constant expression and
+ * without any allocation. The result holds offsets into
+ * the text rather than pointers so that it can be
+ * computed at compile time, e.g. for endpoints known at build time:
+ *
+ * <pre>
+ * constexpr uriparser::LiteralUri endpoint
+ *         = uriparser::parseLiteralUri("https://example.org/api", 23);
+ * static_assert(endpoint.valid, "Invalid endpoint URI");
+ * </pre>
+ *
+ * Requires C++14.
+ *
+ * @param text    <b>IN</b>: Text to parse, must not be NULL
+ * @param length  <b>IN</b>: Number of characters to parse
+ * @return        Offsets, check member <c>valid</c> before use
+ *
+ * @see uriParseSingleUriA
+ * @see operator""_uri
+ * @since 0.9.10
+ */
+constexpr LiteralUri parseLiteralUri(const char * text, std::size_t length) noexcept {
+	LiteralUri uri;
+	std::size_t pos = 0;
+	std::size_t afterPath = 0;
+
+	uri.text = text;
+	uri.length = length;
+
+	/* Scheme */
+	if ((length > 0) && detail::isLiteralAlpha(text[0])) {
+		std::size_t afterScheme = 1;
+		while ((afterScheme < length)
+				&& (detail::isLiteralAlpha(text[afterScheme])
+					|| detail::isLiteralDigit(text[afterScheme])
+					|| (text[afterScheme] == '+')
+					|| (text[afterScheme] == '-')
+					|| (text[afterScheme] == '.'))) {
+			afterScheme++;
+		}
+		if ((afterScheme < length) && (text[afterScheme] == ':')) {
+			uri.scheme.first = 0;
+			uri.scheme.afterLast = afterScheme;
+			pos = afterScheme + 1;
+		}
+	}
+
+	/* Authority */
+	if ((length - pos >= 2) && (text[pos] == '/') && (text[pos + 1] == '/')) {
+		std::size_t afterAuthority = pos + 2;
+		while ((afterAuthority < length) && (text[afterAuthority] != '/')
+				&& (text[afterAuthority] != '?')
+				&& (text[afterAuthority] != '#')) {
+			afterAuthority++;
+		}
+		if (!detail::parseLiteralAuthority(uri, pos + 2, afterAuthority)) {
+			return uri;
+		}
+		pos = afterAuthority;
+	}
+
+	/* Path */
+	afterPath = detail::scanLiteral(text, pos, length,
+			detail::LITERAL_ALLOW_PCHAR | detail::LITERAL_ALLOW_SLASH,
+			uri.errorPos);
+	if (uri.errorPos != LiteralUri::npos) {
+		return uri;
+	}
+	if (!uri.scheme.isSet() && !uri.hostText.isSet()) {
+		/* [segmentNzNc]: No colon before the first slash */
+		std::size_t i = pos;
+		for (; (i < afterPath) && (text[i] != '/'); i++) {
+			if (text[i] == ':') {
+				uri.errorPos = i;
+				return uri;
+			}
+		}
+	}
+	uri.path.first = pos;
+	uri.path.afterLast = afterPath;
+	pos = afterPath;
+
+	/* Query */
+	if ((pos < length) && (text[pos] == '?')) {
+		const std::size_t afterQuery = detail::scanLiteral(text, pos + 1,
+				length, detail::LITERAL_ALLOW_PCHAR | detail::LITERAL_ALLOW_SLASH
+					| detail::LITERAL_ALLOW_QUESTION, uri.errorPos);
+		if (uri.errorPos != LiteralUri::npos) {
+			return uri;
+		}
+		uri.query.first = pos + 1;
+		uri.query.afterLast = afterQuery;
+		pos = afterQuery;
+	}
+
+	/* Fragment */
+	if ((pos < length) && (text[pos] == '#')) {
+		const std::size_t afterFragment = detail::scanLiteral(text, pos + 1,
+				length, detail::LITERAL_ALLOW_PCHAR | detail::LITERAL_ALLOW_SLASH
+					| detail::LITERAL_ALLOW_QUESTION, uri.errorPos);
+		if (uri.errorPos != LiteralUri::npos) {
+			return uri;
+		}
+		uri.fragment.first = pos + 1;
+		uri.fragment.afterLast = afterFragment;
+		pos = afterFragment;
+	}
+
+	if (pos != length) {
+		uri.errorPos = pos;
+		return uri;
+	}
+
+	uri.valid = true;
+	return uri;
+}
+
+
+
+inline namespace literals {
+
+/**
+ * Parses a %URI reference literal, e.g. <c>"https://example.org/"_uri</c>.
+ * With C++20 the literal is parsed at compile time in all contexts
+ * and an invalid %URI reference is a compile error.
+ * Before C++20, the same applies to constant expressions
+ * (e.g. initializing a <c>constexpr</c> variable) while
+ * other contexts parse at runtime and throw
+ * <c>std::invalid_argument</c> on invalid input.
+ *
+ * @param text    <b>IN</b>: Literal text
+ * @param length  <b>IN</b>: Literal length
+ * @return        Offsets of a valid %URI reference
+ *
+ * @see parseLiteralUri
+ * @since 0.9.10
+ */
+#if defined(__cpp_consteval)
+consteval
+#else
+constexpr
+#endif
+LiteralUri operator""_uri(const char * text, std::size_t length) {
+	const LiteralUri uri = parseLiteralUri(text, length);
+	if (!uri.valid) {
+		detail::invalidUriLiteral(uri.errorPos);
+	}
+	return uri;
+}
+
+}  // namespace literals
+
+#endif  // (URI_CPLUSPLUS >= 201402L)
+
+
+
+#ifdef URI_HAVE_PMR
+
+/**
+ * Adapts a <c>std::pmr::memory_resource</c> to the ::UriMemoryManager
+ * interface so that all functions ending in "Mm" can allocate
+ * from e.g. a <c>std::pmr::monotonic_buffer_resource</c>.
+ *
+ * Other than <c>free(3)</c>, <c>std::pmr::memory_resource::deallocate</c>
+ * needs to know size and alignment of the block to release.
+ * Like the decorator behind ::uriCompleteMemoryManager, each block
+ * hence carries a hidden header that stores the size requested,
+ * padded so that the pointer handed out keeps the alignment
+ * of <c>std::max_align_t</c>.
+ *
+ * The adapter neither owns the resource nor the blocks;
+ * it must outlive all memory allocated through it.
+ *
+ * Requires C++17; check for macro <c>URI_HAVE_PMR</c>.
+ *
+ * @see UriMemoryManager
+ * @see uriTestMemoryManagerEx
+ * @since 0.9.10
+ */
+class PmrMemoryManager {
+public:
+	/**
+	 * Creates an adapter around the given resource.
+	 *
+	 * @param memoryResource  <b>IN</b>: Memory resource to allocate from, must not be NULL
+	 */
+	explicit PmrMemoryManager(std::pmr::memory_resource * memoryResource
+			= std::pmr::get_default_resource()) noexcept
+			: resource(memoryResource) {
+		this->memoryManager.malloc = PmrMemoryManager::pmrMalloc;
+		this->memoryManager.calloc = uriEmulateCalloc;
+		this->memoryManager.realloc = PmrMemoryManager::pmrRealloc;
+		this->memoryManager.reallocarray = uriEmulateReallocarray;
+		this->memoryManager.free = PmrMemoryManager::pmrFree;
+		this->memoryManager.userData = this;
+	}
+
+	/* NOTE: userData points back to this object */
+	PmrMemoryManager(const PmrMemoryManager &) = delete;
+	PmrMemoryManager & operator=(const PmrMemoryManager &) = delete;
+
+	/**
+	 * Returns the memory manager to pass to functions ending in "Mm".
+	 *
+	 * @return  Memory manager, never NULL
+	 */
+	UriMemoryManager * get() noexcept {
+		return &(this->memoryManager);
+	}
+
+	/**
+	 * Returns the underlying memory resource.
+	 *
+	 * @return  Memory resource
+	 */
+	std::pmr::memory_resource * getResource() const noexcept {
+		return this->resource;
+	}
+
+private:
+	static constexpr std::size_t alignment = alignof(std::max_align_t);
+	static constexpr std::size_t extraBytes
+			= ((sizeof(std::size_t) + alignment - 1) / alignment) * alignment;
+
+	static void * pmrMalloc(UriMemoryManager * memory, std::size_t size) {
+		PmrMemoryManager * self;
+		void * buffer;
+
+		if ((memory == NULL) || (memory->userData == NULL)) {
+			errno = EINVAL;
+			return NULL;
+		}
+
+		/* check for unsigned overflow */
+		if (size > ((std::size_t)-1) - extraBytes) {
+			errno = ENOMEM;
+			return NULL;
+		}
+
+		self = static_cast<PmrMemoryManager *>(memory->userData);
+		try {
+			buffer = self->resource->allocate(extraBytes + size, alignment);
+		} catch (...) {
+			errno = ENOMEM;
+			return NULL;
+		}
+
+		*static_cast<std::size_t *>(buffer) = size;
+
+		return static_cast<char *>(buffer) + extraBytes;
+	}
+
+	static void * pmrRealloc(UriMemoryManager * memory, void * ptr,
+			std::size_t size) {
+		void * newBuffer;
+		std::size_t prevSize;
+
+		if (memory == NULL) {
+			errno = EINVAL;
+			return NULL;
+		}
+
+		/* man realloc: "If ptr is NULL, then the call is equivalent to
+		 * malloc(size), for *all* values of size" */
+		if (ptr == NULL) {
+			return pmrMalloc(memory, size);
+		}
+
+		/* man realloc: "If size is equal to zero, and ptr is *not* NULL,
+		 * then the call is equivalent to free(ptr)." */
+		if (size == 0) {
+			pmrFree(memory, ptr);
+			return NULL;
+		}
+
+		prevSize = *reinterpret_cast<std::size_t *>(
+				static_cast<char *>(ptr) - extraBytes);
+
+		/* Anything to do? */
+		if (size <= prevSize) {
+			return ptr;
+		}
+
+		newBuffer = pmrMalloc(memory, size);
+		if (newBuffer == NULL) {
+			/* errno set by malloc */
+			return NULL;
+		}
+
+		std::memcpy(newBuffer, ptr, prevSize);
+
+		pmrFree(memory, ptr);
+
+		return newBuffer;
+	}
+
+	static void pmrFree(UriMemoryManager * memory, void * ptr) {
+		PmrMemoryManager * self;
+		char * buffer;
+
+		if ((ptr == NULL) || (memory == NULL) || (memory->userData == NULL)) {
+			return;
+		}
+
+		self = static_cast<PmrMemoryManager *>(memory->userData);
+		buffer = static_cast<char *>(ptr) - extraBytes;
+		self->resource->deallocate(buffer,
+				extraBytes + *reinterpret_cast<std::size_t *>(buffer),
+				alignment);
+	}
+
+	UriMemoryManager memoryManager;
+	std::pmr::memory_resource * resource;
+};
+
+#endif  // URI_HAVE_PMR
+
+
+
+}  // namespace uriparser
+
+
+
+#endif  // URI_HPP
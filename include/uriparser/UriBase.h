@@ -159,6 +159,27 @@ typedef int UriBool; /**< Boolean type */
 #define URI_ERROR_SETHOST_USERINFO_SET     14 /* [>=0.9.9] The %URI given does have user info set */
 #define URI_ERROR_SETHOST_PORT_SET         15 /* [>=0.9.9] The %URI given does have a port set */
 
+/* Error specific to uriParsePortValue */
+#define URI_ERROR_PORT_OUT_OF_RANGE        16 /* [>=0.9.10] The port given exceeds 65535 */
+
+/* Error specific to uriToOriginForm */
+#define URI_ERROR_TOORIGINFORM_HOST_NOT_SET 17 /* [>=0.9.10] The %URI given does not have the host set */
+
+/* Error specific to uriIndexHostLabels */
+#define URI_ERROR_HOST_NOT_REGNAME         18 /* [>=0.9.10] The %URI given does not have a registered name host */
+
+/* Error specific to uriOriginHash and uriSiteHash */
+#define URI_ERROR_HASH_HOST_NOT_SET        19 /* [>=0.9.10] The %URI given does not have the host set */
+
+/* Error specific to uriDeserializeUri */
+#define URI_ERROR_DESERIALIZE_MALFORMED    20 /* [>=0.9.10] The data given is no serialized %URI of this variant */
+
+/* Error specific to uriBuildCompressedSet */
+#define URI_ERROR_COMPRESSEDSET_NOT_SORTED 21 /* [>=0.9.10] The URIs given are not sorted */
+
+/* Error specific to uriCreateSeenFilter */
+#define URI_ERROR_SEENFILTER_RATE_INVALID  22 /* [>=0.9.10] The false positive rate given is not between 0 and 1 */
+
 
 
 #ifndef URI_DOXYGEN
@@ -187,6 +208,24 @@ typedef struct UriIp6Struct {
 } UriIp6; /**< @copydoc UriIp6Struct */
 
 
+
+/**
+ * Unsigned integer of exactly 64 bits, as used for hashes.
+ *
+ * @see uriOriginHashA
+ * @see uriJumpConsistentHash
+ * @since 0.9.10
+ */
+#if defined(_MSC_VER)
+typedef unsigned __int64 UriUint64;
+#elif defined(__GNUC__)
+__extension__ typedef unsigned long long UriUint64; /* no warning with -std=c89 -pedantic */
+#else
+# include <stdint.h>
+typedef uint64_t UriUint64;
+#endif
+
+
 struct UriMemoryManagerStruct;  /* forward declaration to break loop */
 
 
@@ -260,6 +299,19 @@ typedef enum UriBreakConversionEnum {
 
 
 
+/**
+ * Specifies how URIs are separated in a list.
+ *
+ * @see uriParseUriListExA
+ * @since 0.9.10
+ */
+typedef enum UriListDelimiterEnum {
+	URI_LIST_LINES, /**< One %URI per line, blanks around it are ignored */
+	URI_LIST_WHITESPACE /**< URIs separated by any amount of whitespace */
+} UriListDelimiter; /**< @copydoc UriListDelimiterEnum */
+
+
+
 /**
  * Specifies which component of a %URI has to be normalized.
  */
@@ -276,6 +328,149 @@ typedef enum UriNormalizationMaskEnum {
 
 
 
+/**
+ * Identifies well-known schemes.
+ *
+ * @see uriIdentifySchemeA
+ * @see UriParseInfo
+ * @since 0.9.10
+ */
+typedef enum UriSchemeEnum {
+	URI_SCHEME_NONE = 0, /**< No scheme, i.e. a relative reference */
+	URI_SCHEME_UNKNOWN, /**< Scheme other than the ones below */
+	URI_SCHEME_HTTP, /**< "http" */
+	URI_SCHEME_HTTPS, /**< "https" */
+	URI_SCHEME_WS, /**< "ws" */
+	URI_SCHEME_WSS, /**< "wss" */
+	URI_SCHEME_FTP, /**< "ftp" */
+	URI_SCHEME_FILE, /**< "file" */
+	URI_SCHEME_MAILTO, /**< "mailto" */
+	URI_SCHEME_DATA, /**< "data" */
+	URI_SCHEME_URN /**< "urn" */
+} UriScheme; /**< @copydoc UriSchemeEnum */
+
+
+
+/**
+ * Flags describing the content of a single %URI component.
+ *
+ * @see UriParseInfo
+ * @see uriCollectComponentFlagsA
+ * @since 0.9.10
+ */
+typedef enum UriComponentFlagsEnum {
+	URI_HAS_NOTHING = 0, /**< None of the below */
+	URI_HAS_PERCENT = 1 << 0, /**< Contains percent-encodings */
+	URI_HAS_UPPERCASE = 1 << 1, /**< Contains uppercase letters, including inside percent-encodings */
+	URI_HAS_NON_ASCII = 1 << 2, /**< Contains percent-encoded octets beyond ASCII, e.g. UTF-8 */
+	URI_HAS_DOT_SEGMENT = 1 << 3, /**< Path only: contains segment "." or ".." */
+	URI_HAS_EMPTY_SEGMENT = 1 << 4, /**< Path only: contains an empty segment, e.g. from "//" or a trailing "/" */
+	URI_HAS_IP_HOST = 1 << 5 /**< Host only: IPv4, IPv6 or IPvFuture address rather than a registered name */
+} UriComponentFlags; /**< @copydoc UriComponentFlagsEnum */
+
+
+
+/**
+ * Specifies the type of a host.
+ *
+ * @see UriAuthorityA
+ * @see uriSetHostAutoA
+ * @since 0.9.10
+ */
+typedef enum UriHostTypeEnum {
+	URI_HOST_TYPE_IP4, /**< IPv4 address */
+	URI_HOST_TYPE_IP6, /**< IPv6 address */
+	URI_HOST_TYPE_IPFUTURE, /**< IPvFuture address */
+	URI_HOST_TYPE_REGNAME /**< Registered name, possibly empty */
+} UriHostType; /**< @copydoc UriHostTypeEnum */
+
+
+
+/**
+ * Holds facts about a %URI that the parser collects while parsing,
+ * so that callers do not have to rescan the text of the %URI.
+ * The flag members are filled by a single pass over the component
+ * texts after a successful parse; parsing without info skips that pass.
+ *
+ * @see uriParseSingleUriInfoExA
+ * @since 0.9.10
+ */
+typedef struct UriParseInfoStruct {
+	UriScheme scheme; /**< Well-known scheme, compared case-insensitively */
+	unsigned int port; /**< Numeric value of .portText,
+							0 for no or empty port text and when .portOverflow is set */
+	UriBool portOverflow; /**< Whether .portText exceeds 65535 */
+	unsigned int schemeFlags; /**< Flags of .scheme, see UriComponentFlags */
+	unsigned int userInfoFlags; /**< Flags of .userInfo, see UriComponentFlags */
+	unsigned int hostFlags; /**< Flags of .hostText, see UriComponentFlags */
+	unsigned int pathFlags; /**< Flags of all path segments combined, see UriComponentFlags */
+	unsigned int queryFlags; /**< Flags of .query, see UriComponentFlags */
+	unsigned int fragmentFlags; /**< Flags of .fragment, see UriComponentFlags */
+} UriParseInfo; /**< @copydoc UriParseInfoStruct */
+
+
+
+/**
+ * Maximum number of labels in UriHostLabels, enough for any host
+ * that fits the DNS limit of 253 characters.
+ *
+ * @since 0.9.10
+ */
+#define URI_HOST_LABELS_MAX 127
+
+
+
+/**
+ * Holds where the dot-separated labels of a registered name host start,
+ * so that label ranges and domain suffixes are available without
+ * rescanning the host. Label <c>i</c> spans from
+ * <c>hostText.first + offsets[i]</c> to
+ * <c>hostText.first + offsets[i + 1] - 1</c> (exclusive),
+ * so the last <c>n</c> labels start at <c>offsets[count - n]</c>.
+ *
+ * @see uriIndexHostLabelsA
+ * @since 0.9.10
+ */
+typedef struct UriHostLabelsStruct {
+	int count; /**< Number of labels, not counting an empty label after a trailing dot */
+	int offsets[URI_HOST_LABELS_MAX + 1]; /**< Start of each label relative to .hostText.first,
+											followed by the start a next label would have */
+} UriHostLabels; /**< @copydoc UriHostLabelsStruct */
+
+
+
+/**
+ * Identifies the columns of a UriBatchA.
+ *
+ * @see UriBatchA
+ * @since 0.9.10
+ */
+typedef enum UriBatchColumnIdEnum {
+	URI_COLUMN_SCHEME = 0, /**< Scheme, null if none */
+	URI_COLUMN_HOST, /**< Host text (without brackets), null if none */
+	URI_COLUMN_PORT, /**< Port text, null if none */
+	URI_COLUMN_PATH, /**< Path as written in the %URI (e.g. <c>"/a/b"</c>), never null */
+	URI_COLUMN_QUERY, /**< Query without <c>"?"</c>, null if none */
+	URI_COLUMN_FRAGMENT, /**< Fragment without <c>"#"</c>, null if none */
+	URI_COLUMN_COUNT /**< Number of columns */
+} UriBatchColumnId; /**< @copydoc UriBatchColumnIdEnum */
+
+
+
+/**
+ * Selects which columns of a UriBatchA are dictionary-encoded.
+ *
+ * @see uriInitBatchA
+ * @since 0.9.10
+ */
+typedef enum UriBatchFlagsEnum {
+	URI_BATCH_PLAIN = 0, /**< No column dictionary-encoded */
+	URI_BATCH_DICTIONARY_SCHEME = 1 << URI_COLUMN_SCHEME, /**< Dictionary-encode the scheme column */
+	URI_BATCH_DICTIONARY_HOST = 1 << URI_COLUMN_HOST /**< Dictionary-encode the host column */
+} UriBatchFlags; /**< @copydoc UriBatchFlagsEnum */
+
+
+
 /**
  * Specifies how to resolve %URI references.
  */
@@ -423,4 +618,219 @@ URI_PUBLIC int uriTestMemoryManagerEx(UriMemoryManager * memory, UriBool challen
 
 
 
+/**
+ * Public suffix list compiled to a compact label trie,
+ * see uriCompilePublicSuffixList.
+ *
+ * @since 0.9.10
+ */
+typedef struct UriPublicSuffixListStruct UriPublicSuffixList;
+
+
+
+/**
+ * Compiles the text of a <a href="https://publicsuffix.org/list/">public
+ * suffix list</a> (e.g. the content of a local copy of
+ * <c>public_suffix_list.dat</c>) to a compact label trie for
+ * uriRegistrableDomainA.  Rules are read one per line, up to the
+ * first whitespace; empty lines and lines starting with <c>"//"</c>
+ * are skipped.  Wildcard (<c>"*.ck"</c>) and exception
+ * (<c>"!www.ck"</c>) rules are supported.  ASCII letters are
+ * lowercased; labels with non-ASCII characters are kept as UTF-8
+ * and hence only match hosts of the ANSI variant, so prefer
+ * Punycode hosts (see uriNormalizeHostIdnaA) for lookups.
+ * Uses default libc-based memory manager.
+ *
+ * @param psl         <b>OUT</b>: Compiled list, to be freed with uriFreePublicSuffixList, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character of the list, must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the list,
+ *                               can be NULL (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character of
+ *                                a malformed rule (e.g. with an empty label),
+ *                                can be NULL; only set when URI_ERROR_SYNTAX was returned
+ * @return            Error code or 0 on success
+ *
+ * @see uriCompilePublicSuffixListMm
+ * @see uriFreePublicSuffixList
+ * @see uriRegistrableDomainA
+ * @since 0.9.10
+ */
+URI_PUBLIC int uriCompilePublicSuffixList(UriPublicSuffixList ** psl,
+		const char * first, const char * afterLast, const char ** errorPos);
+
+
+
+/**
+ * Compiles the text of a public suffix list like uriCompilePublicSuffixList.
+ *
+ * @param psl         <b>OUT</b>: Compiled list, to be freed with uriFreePublicSuffixList, must not be NULL
+ * @param first       <b>IN</b>: Pointer to the first character of the list, must not be NULL
+ * @param afterLast   <b>IN</b>: Pointer to the character after the last of the list,
+ *                               can be NULL (to use first + strlen(first))
+ * @param errorPos    <b>OUT</b>: Pointer to a pointer to the first character of
+ *                                a malformed rule, can be NULL;
+ *                                only set when URI_ERROR_SYNTAX was returned
+ * @param memory      <b>IN</b>: Memory manager to use, NULL for default libc;
+ *                               also used by uriFreePublicSuffixList
+ * @return            Error code or 0 on success
+ *
+ * @see uriCompilePublicSuffixList
+ * @since 0.9.10
+ */
+URI_PUBLIC int uriCompilePublicSuffixListMm(UriPublicSuffixList ** psl,
+		const char * first, const char * afterLast, const char ** errorPos,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Frees a public suffix list compiled by uriCompilePublicSuffixList.
+ *
+ * @param psl   <b>INOUT</b>: Compiled list to free, can be NULL
+ *
+ * @see uriCompilePublicSuffixList
+ * @since 0.9.10
+ */
+URI_PUBLIC void uriFreePublicSuffixList(UriPublicSuffixList * psl);
+
+
+
+/**
+ * Maps a 64-bit key (e.g. from uriOriginHashA) to one of
+ * <c>bucketCount</c> buckets using the jump consistent hash
+ * of Lamping and Veach: the mapping is uniform, needs no memory
+ * and when growing from <c>n</c> to <c>n + 1</c> buckets only
+ * about <c>1 / (n + 1)</c> of the keys move, all to the new bucket.
+ *
+ * @param key           <b>IN</b>: Key to map, should be well-distributed
+ * @param bucketCount   <b>IN</b>: Number of buckets, must be positive
+ * @return              Bucket in range <c>[0, bucketCount)</c>,
+ *                      or -1 if <c>bucketCount</c> is not positive
+ *
+ * @see uriOriginHashA
+ * @see uriSiteHashA
+ * @since 0.9.10
+ */
+URI_PUBLIC int uriJumpConsistentHash(UriUint64 key, int bucketCount);
+
+
+
+/**
+ * Approximate set of 64-bit hashes of URIs seen before, e.g. by
+ * a crawler, see uriCreateSeenFilter.
+ *
+ * @since 0.9.10
+ */
+typedef struct UriSeenFilterStruct UriSeenFilter;
+
+
+
+/**
+ * Creates a filter to tell URIs seen before from new ones by their
+ * hash (e.g. from uriNormalizedHashA), in constant space: a split
+ * block Bloom filter, where each hash sets eight bits within one
+ * block of 32 bytes so that inserts and lookups touch a single
+ * cache line. There are no false negatives; new hashes are taken
+ * for seen ones at about the false positive rate given, as long as
+ * no more than <c>expectedCount</c> hashes have been inserted.
+ * Rates below about 1e-9 cost 128 bits per hash and are not reached.
+ * Uses default libc-based memory manager.
+ *
+ * @param filter              <b>OUT</b>: Filter created, to be freed with uriFreeSeenFilter, must not be NULL
+ * @param expectedCount       <b>IN</b>: Number of hashes to size for
+ * @param falsePositiveRate   <b>IN</b>: Rate of false positives to size for,
+ *                                       greater than 0 and less than 1, e.g. 0.01
+ * @return                    Error code or 0 on success;
+ *                            URI_ERROR_SEENFILTER_RATE_INVALID for a rate out of range
+ *
+ * @see uriCreateSeenFilterMm
+ * @see uriSeenFilterInsert
+ * @see uriNormalizedHashA
+ * @since 0.9.10
+ */
+URI_PUBLIC int uriCreateSeenFilter(UriSeenFilter ** filter,
+		UriUint64 expectedCount, double falsePositiveRate);
+
+
+
+/**
+ * Creates a filter for hashes of URIs like uriCreateSeenFilter.
+ *
+ * @param filter              <b>OUT</b>: Filter created, to be freed with uriFreeSeenFilter, must not be NULL
+ * @param expectedCount       <b>IN</b>: Number of hashes to size for
+ * @param falsePositiveRate   <b>IN</b>: Rate of false positives to size for,
+ *                                       greater than 0 and less than 1
+ * @param memory              <b>IN</b>: Memory manager to use, NULL for default libc;
+ *                                       also used by uriFreeSeenFilter
+ * @return                    Error code or 0 on success
+ *
+ * @see uriCreateSeenFilter
+ * @since 0.9.10
+ */
+URI_PUBLIC int uriCreateSeenFilterMm(UriSeenFilter ** filter,
+		UriUint64 expectedCount, double falsePositiveRate,
+		UriMemoryManager * memory);
+
+
+
+/**
+ * Frees a filter created by uriCreateSeenFilter.
+ *
+ * @param filter   <b>INOUT</b>: Filter to free, can be NULL
+ *
+ * @see uriCreateSeenFilter
+ * @since 0.9.10
+ */
+URI_PUBLIC void uriFreeSeenFilter(UriSeenFilter * filter);
+
+
+
+/**
+ * Returns the number of bytes a filter occupies in memory, in total.
+ *
+ * @param filter   <b>IN</b>: Filter, can be NULL
+ * @return         Size in bytes, 0 for NULL
+ *
+ * @see uriCreateSeenFilter
+ * @since 0.9.10
+ */
+URI_PUBLIC size_t uriSeenFilterByteSize(const UriSeenFilter * filter);
+
+
+
+/**
+ * Adds a hash to a filter and tells whether it was (probably) there
+ * before, in one go. Threads may insert into and look up in the same
+ * filter concurrently when built with GCC, Clang or MSVC (bits are set
+ * by atomic OR); two threads inserting the same new hash at the same
+ * time may both be told it is new.
+ *
+ * @param filter   <b>INOUT</b>: Filter to add to, can be NULL
+ * @param hash     <b>IN</b>: Hash to add, e.g. from uriNormalizedHashA
+ * @return         <c>URI_TRUE</c> if the hash was probably added before,
+ *                 <c>URI_FALSE</c> if it certainly was not, or for NULL
+ *
+ * @see uriSeenFilterContains
+ * @since 0.9.10
+ */
+URI_PUBLIC UriBool uriSeenFilterInsert(UriSeenFilter * filter, UriUint64 hash);
+
+
+
+/**
+ * Tells whether a hash was (probably) added to a filter before.
+ *
+ * @param filter   <b>IN</b>: Filter to look up in, can be NULL
+ * @param hash     <b>IN</b>: Hash to look up
+ * @return         <c>URI_TRUE</c> if the hash was probably added,
+ *                 <c>URI_FALSE</c> if it certainly was not, or for NULL
+ *
+ * @see uriSeenFilterInsert
+ * @since 0.9.10
+ */
+URI_PUBLIC UriBool uriSeenFilterContains(const UriSeenFilter * filter,
+		UriUint64 hash);
+
+
+
 #endif /* URI_BASE_H */
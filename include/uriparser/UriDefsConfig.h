@@ -50,6 +50,7 @@
 /* Deny external overriding */
 #undef URI_ENABLE_ANSI      /* Internal for !URI_NO_ANSI */
 #undef URI_ENABLE_UNICODE   /* Internal for !URI_NO_UNICODE */
+#undef URI_ENABLE_CHAR16_T  /* Internal for URI_WITH_CHAR16_T */
 
 
 
@@ -73,6 +74,15 @@
 # endif
 #endif
 
+/* 16-bit code units, opt-in; as char16_t needs C11 or C++11,
+ * older compilers only get to see the other encodings */
+#if defined(URI_WITH_CHAR16_T) \
+		&& ((defined(__cplusplus) && ((__cplusplus >= 201103L) \
+			|| (defined(_MSVC_LANG) && (_MSVC_LANG >= 201103L)))) \
+		|| (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)))
+# define URI_ENABLE_CHAR16_T  1
+#endif
+
 
 
 /* Function inlining, not ANSI/ISO C! */
@@ -40,16 +40,24 @@
 /**
  * @file UriIp4.h
  * Holds the IPv4 parser interface.
- * NOTE: This header includes itself twice.
+ * NOTE: This header includes itself once per encoding.
  */
 
 #if (defined(URI_PASS_ANSI) && !defined(URI_IP4_TWICE_H_ANSI)) \
 	|| (defined(URI_PASS_UNICODE) && !defined(URI_IP4_TWICE_H_UNICODE)) \
-	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_IP4_TWICE_H_CHAR16_T)) \
+	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
 /* What encodings are enabled? */
 #include "UriDefsConfig.h"
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriIp4.h"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriIp4.h"
@@ -63,14 +71,19 @@
 /* Only one pass for each encoding */
 #elif (defined(URI_PASS_ANSI) && !defined(URI_IP4_TWICE_H_ANSI) \
 	&& defined(URI_ENABLE_ANSI)) || (defined(URI_PASS_UNICODE) \
-	&& !defined(URI_IP4_TWICE_H_UNICODE) && defined(URI_ENABLE_UNICODE))
+	&& !defined(URI_IP4_TWICE_H_UNICODE) && defined(URI_ENABLE_UNICODE)) \
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_IP4_TWICE_H_CHAR16_T) \
+	&& defined(URI_ENABLE_CHAR16_T))
 # ifdef URI_PASS_ANSI
 #  define URI_IP4_TWICE_H_ANSI 1
 #  include "UriDefsAnsi.h"
-# else
+# elif defined(URI_PASS_UNICODE)
 #  define URI_IP4_TWICE_H_UNICODE 1
 #  include "UriDefsUnicode.h"
 #  include <wchar.h>
+# else
+#  define URI_IP4_TWICE_H_CHAR16_T 1
+#  include "UriDefsChar16.h"
 # endif
 
 
@@ -0,0 +1,546 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriBatch.c
+ * Holds the columnar batch implementation.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriBatch.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriBatch.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriBatch.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriMemory.h"
+#endif
+
+
+
+#include <limits.h>
+#include <string.h>
+
+
+
+#ifndef URI_BATCH_MIN_ROWS
+# define URI_BATCH_MIN_ROWS    64
+# define URI_BATCH_MIN_CHARS   256
+# define URI_BATCH_MIN_SLOTS   16
+# define URI_BATCH_DICTIONARY_MASK  (URI_BATCH_DICTIONARY_SCHEME \
+		| URI_BATCH_DICTIONARY_HOST)
+#endif
+
+
+
+/* Grows an array to at least needed elements, doubling the capacity */
+static int URI_FUNC(GrowArray)(UriMemoryManager * memory, void ** array,
+		int * capacity, int needed, int minimum, size_t size) {
+	int newCapacity = (*capacity > 0) ? *capacity : minimum;
+	void * grown;
+
+	if (needed <= *capacity) {
+		return URI_SUCCESS;
+	}
+	while (newCapacity < needed) {
+		newCapacity = (newCapacity > INT_MAX / 2) ? INT_MAX : (newCapacity * 2);
+	}
+	grown = memory->reallocarray(memory, *array, (size_t)newCapacity, size);
+	if (grown == NULL) {
+		return URI_ERROR_MALLOC;
+	}
+	*array = grown;
+	*capacity = newCapacity;
+	return URI_SUCCESS;
+}
+
+
+
+static int URI_FUNC(GrowValues)(UriMemoryManager * memory,
+		URI_TYPE(BatchColumn) * column, int used, int length) {
+	void * values = column->values;
+	int res;
+	if (length > INT_MAX - used) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	res = URI_FUNC(GrowArray)(memory, &values, &(column->valuesCapacity),
+			used + length, URI_BATCH_MIN_CHARS, sizeof(URI_CHAR));
+	column->values = (URI_CHAR *)values;
+	return res;
+}
+
+
+
+static int URI_FUNC(GrowOffsets)(UriMemoryManager * memory,
+		URI_TYPE(BatchColumn) * column, int needed) {
+	const UriBool first = (column->offsetsCapacity == 0) ? URI_TRUE : URI_FALSE;
+	void * offsets = column->offsets;
+	const int res = URI_FUNC(GrowArray)(memory, &offsets,
+			&(column->offsetsCapacity), needed, URI_BATCH_MIN_ROWS + 1,
+			sizeof(int));
+	column->offsets = (int *)offsets;
+	if ((res == URI_SUCCESS) && first) {
+		column->offsets[0] = 0;
+	}
+	return res;
+}
+
+
+
+/* Makes room for one more row in every column */
+static int URI_FUNC(GrowRows)(URI_TYPE(Batch) * batch) {
+	UriMemoryManager * const memory = batch->memory;
+	const size_t oldValidityBytes = (size_t)(batch->rowCapacity + 7) / 8;
+	size_t newValidityBytes;
+	int newCapacity;
+	int i;
+
+	if (batch->count < batch->rowCapacity) {
+		return URI_SUCCESS;
+	}
+	if (batch->rowCapacity > (INT_MAX - 1) / 2) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	newCapacity = (batch->rowCapacity > 0)
+			? (batch->rowCapacity * 2)
+			: URI_BATCH_MIN_ROWS;
+	newValidityBytes = (size_t)(newCapacity + 7) / 8;
+
+	for (i = 0; i < URI_COLUMN_COUNT; i++) {
+		URI_TYPE(BatchColumn) * const column = &(batch->columns[i]);
+		unsigned char * const validity = memory->realloc(memory,
+				column->validity, newValidityBytes);
+		if (validity == NULL) {
+			return URI_ERROR_MALLOC;
+		}
+		/* realloc leaves the grown tail uninitialized */
+		memset(validity + oldValidityBytes, 0,
+				newValidityBytes - oldValidityBytes);
+		column->validity = validity;
+
+		if (batch->flags & (1 << i)) {
+			int * const indices = memory->reallocarray(memory,
+					column->indices, (size_t)newCapacity, sizeof(int));
+			if (indices == NULL) {
+				return URI_ERROR_MALLOC;
+			}
+			column->indices = indices;
+		} else {
+			const int res = URI_FUNC(GrowOffsets)(memory, column, newCapacity + 1);
+			if (res != URI_SUCCESS) {
+				return res;
+			}
+		}
+	}
+
+	batch->rowCapacity = newCapacity;
+	return URI_SUCCESS;
+}
+
+
+
+static void URI_FUNC(SetValid)(URI_TYPE(BatchColumn) * column, int row,
+		UriBool valid) {
+	const unsigned char bit = (unsigned char)(1 << (row % 8));
+	if (valid) {
+		column->validity[row / 8] |= bit;
+	} else {
+		column->validity[row / 8] &= (unsigned char)~bit;
+	}
+}
+
+
+
+static unsigned int URI_FUNC(HashValue)(const URI_CHAR * first, int length) {
+	unsigned int hash = 2166136261U;  /* FNV-1a */
+	int i;
+	for (i = 0; i < length; i++) {
+		hash = (hash ^ (unsigned int)(sizeof(URI_CHAR) == 1
+				? (unsigned char)first[i]
+				: (unsigned int)first[i])) * 16777619U;
+	}
+	return hash;
+}
+
+
+
+/* Rebuilds the hash table of a dictionary column with twice the slots */
+static int URI_FUNC(GrowSlots)(UriMemoryManager * memory,
+		URI_TYPE(BatchColumn) * column) {
+	int slotCount;
+	int * slots;
+	int i;
+
+	/* Check before doubling, so slotCount cannot overflow */
+	if (column->slotCount > INT_MAX / 4) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	slotCount = (column->slotCount > 0)
+			? (column->slotCount * 2)
+			: URI_BATCH_MIN_SLOTS;
+	slots = memory->calloc(memory, (size_t)slotCount, sizeof(int));
+	if (slots == NULL) {
+		return URI_ERROR_MALLOC;
+	}
+	for (i = 0; i < column->dictionaryCount; i++) {
+		const int start = column->offsets[i];
+		unsigned int slot = URI_FUNC(HashValue)(column->values + start,
+				column->offsets[i + 1] - start) & (unsigned int)(slotCount - 1);
+		while (slots[slot] != 0) {
+			slot = (slot + 1) & (unsigned int)(slotCount - 1);
+		}
+		slots[slot] = i + 1;
+	}
+	if (column->slots != NULL) {
+		memory->free(memory, column->slots);
+	}
+	column->slots = slots;
+	column->slotCount = slotCount;
+	return URI_SUCCESS;
+}
+
+
+
+static int URI_FUNC(AppendDictionaryValue)(UriMemoryManager * memory,
+		URI_TYPE(BatchColumn) * column, int row,
+		const URI_CHAR * first, int length) {
+	unsigned int slot;
+	int used;
+	int res;
+
+	/* Keep the table at most half full */
+	if (column->dictionaryCount >= column->slotCount / 2) {
+		res = URI_FUNC(GrowSlots)(memory, column);
+		if (res != URI_SUCCESS) {
+			return res;
+		}
+	}
+
+	slot = URI_FUNC(HashValue)(first, length)
+			& (unsigned int)(column->slotCount - 1);
+	while (column->slots[slot] != 0) {
+		const int index = column->slots[slot] - 1;
+		const int start = column->offsets[index];
+		if ((column->offsets[index + 1] - start == length)
+				&& ((length == 0) || (memcmp(column->values + start, first,
+					length * sizeof(URI_CHAR)) == 0))) {
+			column->indices[row] = index;
+			return URI_SUCCESS;
+		}
+		slot = (slot + 1) & (unsigned int)(column->slotCount - 1);
+	}
+
+	/* New distinct value */
+	res = URI_FUNC(GrowOffsets)(memory, column, column->dictionaryCount + 2);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+	used = column->offsets[column->dictionaryCount];
+	res = URI_FUNC(GrowValues)(memory, column, used, length);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+	if (length > 0) {
+		memcpy(column->values + used, first, length * sizeof(URI_CHAR));
+	}
+	column->offsets[column->dictionaryCount + 1] = used + length;
+	column->slots[slot] = column->dictionaryCount + 1;
+	column->indices[row] = column->dictionaryCount;
+	column->dictionaryCount++;
+	return URI_SUCCESS;
+}
+
+
+
+/* Writes the value of a row, with a NULL range for null */
+static int URI_FUNC(AppendValue)(URI_TYPE(Batch) * batch, int columnId,
+		const URI_TYPE(TextRange) * range) {
+	URI_TYPE(BatchColumn) * const column = &(batch->columns[columnId]);
+	const int row = batch->count;
+	const int length = (range->first == NULL)
+			? 0
+			: (int)(range->afterLast - range->first);
+	int res;
+
+	URI_FUNC(SetValid)(column, row, (range->first != NULL) ? URI_TRUE : URI_FALSE);
+
+	if (batch->flags & (1 << columnId)) {
+		if (range->first == NULL) {
+			column->indices[row] = 0;
+			return URI_SUCCESS;
+		}
+		return URI_FUNC(AppendDictionaryValue)(batch->memory, column, row,
+				range->first, length);
+	}
+
+	res = URI_FUNC(GrowValues)(batch->memory, column, column->offsets[row], length);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+	if (length > 0) {
+		memcpy(column->values + column->offsets[row], range->first,
+				length * sizeof(URI_CHAR));
+	}
+	column->offsets[row + 1] = column->offsets[row] + length;
+	return URI_SUCCESS;
+}
+
+
+
+/* Writes the path as uriToStringA would, i.e. with a leading slash
+ * for absolute paths and for paths after a host */
+static int URI_FUNC(AppendPath)(URI_TYPE(Batch) * batch,
+		const URI_TYPE(Uri) * uri) {
+	URI_TYPE(BatchColumn) * const column = &(batch->columns[URI_COLUMN_PATH]);
+	const int row = batch->count;
+	const URI_TYPE(PathSegment) * walker;
+	const UriBool leadingSlash = (uri->absolutePath
+			|| ((uri->pathHead != NULL) && URI_FUNC(HasHost)(uri)))
+			? URI_TRUE : URI_FALSE;
+	size_t length = leadingSlash ? 1 : 0;
+	int res;
+
+	for (walker = uri->pathHead; walker != NULL; walker = walker->next) {
+		length += (size_t)(walker->text.afterLast - walker->text.first);
+		if (walker->next != NULL) {
+			length++;
+		}
+	}
+	if (length > (size_t)INT_MAX) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+
+	res = URI_FUNC(GrowValues)(batch->memory, column, column->offsets[row],
+			(int)length);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+
+	if (length > 0) {
+		URI_CHAR * write = column->values + column->offsets[row];
+		if (leadingSlash) {
+			*write++ = _UT('/');
+		}
+		for (walker = uri->pathHead; walker != NULL; walker = walker->next) {
+			const size_t segmentLength
+					= (size_t)(walker->text.afterLast - walker->text.first);
+			if (segmentLength > 0) {
+				memcpy(write, walker->text.first, segmentLength * sizeof(URI_CHAR));
+				write += segmentLength;
+			}
+			if (walker->next != NULL) {
+				*write++ = _UT('/');
+			}
+		}
+	}
+
+	URI_FUNC(SetValid)(column, row, URI_TRUE);
+	column->offsets[row + 1] = column->offsets[row] + (int)length;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(InitBatchMm)(URI_TYPE(Batch) * batch, int flags,
+		UriMemoryManager * memory) {
+	if (batch == NULL) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	memset(batch, 0, sizeof(URI_TYPE(Batch)));
+	batch->flags = flags & URI_BATCH_DICTIONARY_MASK;
+	batch->memory = memory;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(InitBatch)(URI_TYPE(Batch) * batch, int flags) {
+	return URI_FUNC(InitBatchMm)(batch, flags, NULL);
+}
+
+
+
+int URI_FUNC(BatchAppendUri)(URI_TYPE(Batch) * batch,
+		const URI_TYPE(Uri) * uri) {
+	int res;
+	int i;
+
+	if ((batch == NULL) || (uri == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	/* A failure half-way leaves no trace but unused capacity
+	 * (and maybe a distinct value no row refers to yet),
+	 * as the row only counts once complete */
+	res = URI_FUNC(GrowRows)(batch);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+	if (((res = URI_FUNC(AppendValue)(batch, URI_COLUMN_SCHEME, &(uri->scheme))) != URI_SUCCESS)
+			|| ((res = URI_FUNC(AppendValue)(batch, URI_COLUMN_HOST, &(uri->hostText))) != URI_SUCCESS)
+			|| ((res = URI_FUNC(AppendValue)(batch, URI_COLUMN_PORT, &(uri->portText))) != URI_SUCCESS)
+			|| ((res = URI_FUNC(AppendPath)(batch, uri)) != URI_SUCCESS)
+			|| ((res = URI_FUNC(AppendValue)(batch, URI_COLUMN_QUERY, &(uri->query))) != URI_SUCCESS)
+			|| ((res = URI_FUNC(AppendValue)(batch, URI_COLUMN_FRAGMENT, &(uri->fragment))) != URI_SUCCESS)) {
+		return res;
+	}
+
+	for (i = 0; i < URI_COLUMN_COUNT; i++) {
+		URI_TYPE(BatchColumn) * const column = &(batch->columns[i]);
+		if ((column->validity[batch->count / 8] & (1 << (batch->count % 8))) == 0) {
+			column->nullCount++;
+		}
+	}
+	batch->count++;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(ParseIntoBatch)(URI_TYPE(Batch) * batch,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos) {
+	URI_TYPE(Uri) uri;
+	int res;
+
+	if ((batch == NULL) || (first == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (afterLast == NULL) {
+		afterLast = first + URI_STRLEN(first);
+	}
+
+	res = URI_FUNC(ParseSingleUriExMm)(&uri, first, afterLast, errorPos,
+			batch->memory);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+	res = URI_FUNC(BatchAppendUri)(batch, &uri);
+	URI_FUNC(FreeUriMembersMm)(&uri, batch->memory);
+	return res;
+}
+
+
+
+void URI_FUNC(ClearBatch)(URI_TYPE(Batch) * batch) {
+	int i;
+
+	if (batch == NULL) {
+		return;
+	}
+
+	for (i = 0; i < URI_COLUMN_COUNT; i++) {
+		URI_TYPE(BatchColumn) * const column = &(batch->columns[i]);
+		column->nullCount = 0;
+		column->dictionaryCount = 0;
+		if (column->slots != NULL) {
+			memset(column->slots, 0, (size_t)column->slotCount * sizeof(int));
+		}
+	}
+	batch->count = 0;
+}
+
+
+
+void URI_FUNC(FreeBatchMembers)(URI_TYPE(Batch) * batch) {
+	UriMemoryManager * memory;
+	int flags;
+	int i;
+
+	if (batch == NULL) {
+		return;
+	}
+
+	memory = batch->memory;
+	flags = batch->flags;
+	for (i = 0; i < URI_COLUMN_COUNT; i++) {
+		URI_TYPE(BatchColumn) * const column = &(batch->columns[i]);
+		void * buffers[5];
+		int k;
+		buffers[0] = column->offsets;
+		buffers[1] = column->values;
+		buffers[2] = column->validity;
+		buffers[3] = column->indices;
+		buffers[4] = column->slots;
+		for (k = 0; k < 5; k++) {
+			if (buffers[k] != NULL) {
+				memory->free(memory, buffers[k]);
+			}
+		}
+	}
+
+	/* Ready for reuse, like after uriInitBatchMmA */
+	memset(batch, 0, sizeof(URI_TYPE(Batch)));
+	batch->flags = flags;
+	batch->memory = memory;
+}
+
+
+
+#endif
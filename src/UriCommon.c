@@ -39,8 +39,14 @@
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriCommon.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriCommon.c"
@@ -54,9 +60,11 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -149,6 +157,94 @@ int URI_FUNC(CompareRange)(
 
 
 
+/* Like CompareRange, with ASCII letters compared ignoring case */
+int URI_FUNC(CompareRangeIgnoreCase)(
+		const URI_TYPE(TextRange) * a,
+		const URI_TYPE(TextRange) * b) {
+	const URI_CHAR * walkA;
+	const URI_CHAR * walkB;
+	int diff;
+
+	/* NOTE: Both NULL means equal! */
+	if ((a == NULL) || (b == NULL)) {
+		return ((a == NULL) ? 0 : 1) - ((b == NULL) ? 0 : 1);
+	}
+
+	/* NOTE: Both NULL means equal! */
+	if ((a->first == NULL) || (b->first == NULL)) {
+		return ((a->first == NULL) ? 0 : 1) - ((b->first == NULL) ? 0 : 1);
+	}
+
+	diff = ((int)(a->afterLast - a->first) - (int)(b->afterLast - b->first));
+	if (diff > 0) {
+		return 1;
+	} else if (diff < 0) {
+		return -1;
+	}
+
+	for (walkA = a->first, walkB = b->first; walkA < a->afterLast;
+			walkA++, walkB++) {
+		URI_CHAR charA = *walkA;
+		URI_CHAR charB = *walkB;
+		if ((charA >= _UT('A')) && (charA <= _UT('Z'))) {
+			charA = (URI_CHAR)(charA + (_UT('a') - _UT('A')));
+		}
+		if ((charB >= _UT('A')) && (charB <= _UT('Z'))) {
+			charB = (URI_CHAR)(charB + (_UT('a') - _UT('A')));
+		}
+		if (charA != charB) {
+			return (charA < charB) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}
+
+
+
+/*
+ * Determines the port a URI refers to: the port given,
+ * or else the default port of the scheme (80 for http and ws,
+ * 443 for https and wss, 21 for ftp), or else 0.
+ */
+int URI_FUNC(EffectivePort)(const URI_TYPE(Uri) * uri, unsigned int * port) {
+	if ((uri->portText.first != NULL)
+			&& (uri->portText.first != uri->portText.afterLast)) {
+		return URI_FUNC(ParsePortValue)(port, uri->portText.first,
+				uri->portText.afterLast);
+	}
+
+	switch (URI_FUNC(IdentifyScheme)(uri->scheme.first, uri->scheme.afterLast)) {
+	case URI_SCHEME_HTTP:
+	case URI_SCHEME_WS:
+		*port = 80;
+		break;
+
+	case URI_SCHEME_HTTPS:
+	case URI_SCHEME_WSS:
+		*port = 443;
+		break;
+
+	case URI_SCHEME_FTP:
+		*port = 21;
+		break;
+
+	default:
+		*port = 0;
+		break;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+/* Length of a range in characters, 0 for a NULL range */
+int URI_FUNC(RangeLength)(const URI_TYPE(TextRange) * range) {
+	return (range->first == NULL) ? 0 : (int)(range->afterLast - range->first);
+}
+
+
+
 UriBool URI_FUNC(CopyRange)(URI_TYPE(TextRange) * destRange,
 		const URI_TYPE(TextRange) * sourceRange, UriMemoryManager * memory) {
 	const int lenInChars = (int)(sourceRange->afterLast - sourceRange->first);
@@ -808,4 +904,188 @@ void URI_FUNC(FixEmptyTrailSegment)(URI_TYPE(Uri) * uri,
 
 
 
+/*
+ * Decodes the code point at first, from UTF-8 for char and from UTF-16
+ * or UTF-32 for wider character types, depending on their size.
+ * Returns the position after it, or NULL for ill-formed or truncated
+ * input (including overlong forms, surrogates and beyond U+10FFFF).
+ */
+const URI_CHAR * URI_FUNC(DecodeCodePoint)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, unsigned long * codePoint) {
+	if (sizeof(URI_CHAR) == 1) {
+		const unsigned char lead = (unsigned char)first[0];
+		unsigned long value;
+		int trailCount;
+		int i;
+
+		if (lead < 0x80) {
+			*codePoint = lead;
+			return first + 1;
+		} else if (lead < 0xC2) {
+			return NULL; /* Trail byte or overlong two-byte form */
+		} else if (lead < 0xE0) {
+			value = lead & 0x1F;
+			trailCount = 1;
+		} else if (lead < 0xF0) {
+			value = lead & 0x0F;
+			trailCount = 2;
+		} else if (lead < 0xF5) {
+			value = lead & 0x07;
+			trailCount = 3;
+		} else {
+			return NULL;
+		}
+
+		if (afterLast - first <= trailCount) {
+			return NULL;
+		}
+		for (i = 1; i <= trailCount; i++) {
+			const unsigned char trail = (unsigned char)first[i];
+			if ((trail & 0xC0) != 0x80) {
+				return NULL;
+			}
+			value = (value << 6) | (trail & 0x3F);
+		}
+
+		if (((trailCount == 2) && (value < 0x800))
+				|| ((trailCount == 3) && (value < 0x10000))
+				|| ((value >= 0xD800) && (value <= 0xDFFF))
+				|| (value > 0x10FFFF)) {
+			return NULL;
+		}
+		*codePoint = value;
+		return first + 1 + trailCount;
+	} else if (sizeof(URI_CHAR) == 2) {
+		const unsigned long high = (unsigned long)first[0] & 0xFFFF;
+		unsigned long low;
+
+		if ((high < 0xD800) || (high > 0xDFFF)) {
+			*codePoint = high;
+			return first + 1;
+		}
+		if ((high > 0xDBFF) || (afterLast - first < 2)) {
+			return NULL;
+		}
+		low = (unsigned long)first[1] & 0xFFFF;
+		if ((low < 0xDC00) || (low > 0xDFFF)) {
+			return NULL;
+		}
+		*codePoint = 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+		return first + 2;
+	} else {
+		const unsigned long value = (unsigned long)first[0];
+
+		if (((value >= 0xD800) && (value <= 0xDFFF)) || (value > 0x10FFFF)) {
+			return NULL;
+		}
+		*codePoint = value;
+		return first + 1;
+	}
+}
+
+
+
+/*
+ * Counterpart of DecodeCodePoint: writes a scalar value to dest
+ * as UTF-8, UTF-16 or UTF-32 depending on the size of URI_CHAR.
+ * Returns the number of characters written, at most 4.
+ */
+int URI_FUNC(EncodeCodePoint)(unsigned long codePoint, URI_CHAR * dest) {
+	if (sizeof(URI_CHAR) == 1) {
+		if (codePoint < 0x80) {
+			dest[0] = (URI_CHAR)codePoint;
+			return 1;
+		} else if (codePoint < 0x800) {
+			dest[0] = (URI_CHAR)(0xC0 | (codePoint >> 6));
+			dest[1] = (URI_CHAR)(0x80 | (codePoint & 0x3F));
+			return 2;
+		} else if (codePoint < 0x10000) {
+			dest[0] = (URI_CHAR)(0xE0 | (codePoint >> 12));
+			dest[1] = (URI_CHAR)(0x80 | ((codePoint >> 6) & 0x3F));
+			dest[2] = (URI_CHAR)(0x80 | (codePoint & 0x3F));
+			return 3;
+		} else {
+			dest[0] = (URI_CHAR)(0xF0 | (codePoint >> 18));
+			dest[1] = (URI_CHAR)(0x80 | ((codePoint >> 12) & 0x3F));
+			dest[2] = (URI_CHAR)(0x80 | ((codePoint >> 6) & 0x3F));
+			dest[3] = (URI_CHAR)(0x80 | (codePoint & 0x3F));
+			return 4;
+		}
+	} else if ((sizeof(URI_CHAR) == 2) && (codePoint >= 0x10000)) {
+		dest[0] = (URI_CHAR)(0xD800 + ((codePoint - 0x10000) >> 10));
+		dest[1] = (URI_CHAR)(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+		return 2;
+	} else {
+		dest[0] = (URI_CHAR)codePoint;
+		return 1;
+	}
+}
+
+
+
+/*
+ * Writes a scalar value to bytes as UTF-8, regardless of the
+ * size of URI_CHAR. Returns the number of bytes written, at most 4.
+ */
+int URI_FUNC(EncodeUtf8)(unsigned long codePoint, unsigned char * bytes) {
+	if (codePoint < 0x80) {
+		bytes[0] = (unsigned char)codePoint;
+		return 1;
+	} else if (codePoint < 0x800) {
+		bytes[0] = (unsigned char)(0xC0 | (codePoint >> 6));
+		bytes[1] = (unsigned char)(0x80 | (codePoint & 0x3F));
+		return 2;
+	} else if (codePoint < 0x10000) {
+		bytes[0] = (unsigned char)(0xE0 | (codePoint >> 12));
+		bytes[1] = (unsigned char)(0x80 | ((codePoint >> 6) & 0x3F));
+		bytes[2] = (unsigned char)(0x80 | (codePoint & 0x3F));
+		return 3;
+	} else {
+		bytes[0] = (unsigned char)(0xF0 | (codePoint >> 18));
+		bytes[1] = (unsigned char)(0x80 | ((codePoint >> 12) & 0x3F));
+		bytes[2] = (unsigned char)(0x80 | ((codePoint >> 6) & 0x3F));
+		bytes[3] = (unsigned char)(0x80 | (codePoint & 0x3F));
+		return 4;
+	}
+}
+
+
+
+#ifdef URI_PASS_CHAR16_T
+size_t URI_FUNC(Strlen)(const URI_CHAR * str) {
+	const URI_CHAR * walker = str;
+	while (*walker != _UT('\0')) {
+		walker++;
+	}
+	return (size_t)(walker - str);
+}
+
+
+
+int URI_FUNC(Strncmp)(const URI_CHAR * a, const URI_CHAR * b, size_t count) {
+	for (; count > 0; a++, b++, count--) {
+		if (*a != *b) {
+			return (*a < *b) ? -1 : 1;
+		}
+		if (*a == _UT('\0')) {
+			break;
+		}
+	}
+	return 0;
+}
+
+
+
+URI_CHAR * URI_FUNC(Memchr)(const URI_CHAR * str, URI_CHAR c, size_t count) {
+	for (; count > 0; str++, count--) {
+		if (*str == c) {
+			return (URI_CHAR *)str;
+		}
+	}
+	return NULL;
+}
+#endif
+
+
+
 #endif
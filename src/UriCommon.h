@@ -39,11 +39,19 @@
 
 #if (defined(URI_PASS_ANSI) && !defined(URI_COMMON_H_ANSI)) \
 	|| (defined(URI_PASS_UNICODE) && !defined(URI_COMMON_H_UNICODE)) \
-	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_COMMON_H_CHAR16_T)) \
+	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriCommon.h"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriCommon.h"
@@ -57,13 +65,18 @@
 /* Only one pass for each encoding */
 #elif (defined(URI_PASS_ANSI) && !defined(URI_COMMON_H_ANSI) \
 	&& defined(URI_ENABLE_ANSI)) || (defined(URI_PASS_UNICODE) \
-	&& !defined(URI_COMMON_H_UNICODE) && defined(URI_ENABLE_UNICODE))
+	&& !defined(URI_COMMON_H_UNICODE) && defined(URI_ENABLE_UNICODE)) \
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_COMMON_H_CHAR16_T) \
+	&& defined(URI_ENABLE_CHAR16_T))
 # ifdef URI_PASS_ANSI
 #  define URI_COMMON_H_ANSI 1
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  define URI_COMMON_H_UNICODE 1
 #  include <uriparser/UriDefsUnicode.h>
+# else
+#  define URI_COMMON_H_CHAR16_T 1
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -83,6 +96,11 @@ int URI_FUNC(FreeUriPath)(URI_TYPE(Uri) * uri, UriMemoryManager * memory);
 int URI_FUNC(CompareRange)(
 		const URI_TYPE(TextRange) * a,
 		const URI_TYPE(TextRange) * b);
+int URI_FUNC(CompareRangeIgnoreCase)(
+		const URI_TYPE(TextRange) * a,
+		const URI_TYPE(TextRange) * b);
+int URI_FUNC(EffectivePort)(const URI_TYPE(Uri) * uri, unsigned int * port);
+int URI_FUNC(RangeLength)(const URI_TYPE(TextRange) * range);
 
 UriBool URI_FUNC(CopyRange)(URI_TYPE(TextRange) * destRange,
 		const URI_TYPE(TextRange) * sourceRange, UriMemoryManager * memory);
@@ -108,6 +126,22 @@ UriBool URI_FUNC(EnsureThatPathIsNotMistakenForHost)(URI_TYPE(Uri) * uri, UriMem
 void URI_FUNC(FixEmptyTrailSegment)(URI_TYPE(Uri) * uri,
 		UriMemoryManager * memory);
 
+int URI_FUNC(ParseNetworkPathMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory);
+
+const URI_CHAR * URI_FUNC(DecodeCodePoint)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, unsigned long * codePoint);
+int URI_FUNC(EncodeCodePoint)(unsigned long codePoint, URI_CHAR * dest);
+int URI_FUNC(EncodeUtf8)(unsigned long codePoint, unsigned char * bytes);
+
+#ifdef URI_PASS_CHAR16_T
+/* Stand-ins for wcslen, wcsncmp and wmemchr, see UriDefsChar16.h */
+size_t URI_FUNC(Strlen)(const URI_CHAR * str);
+int URI_FUNC(Strncmp)(const URI_CHAR * a, const URI_CHAR * b, size_t count);
+URI_CHAR * URI_FUNC(Memchr)(const URI_CHAR * str, URI_CHAR c, size_t count);
+#endif
+
 
 #endif
 #endif
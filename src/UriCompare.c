@@ -39,8 +39,14 @@
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriCompare.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriCompare.c"
@@ -54,9 +60,11 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -165,4 +173,124 @@ UriBool URI_FUNC(EqualsUri)(const URI_TYPE(Uri) * a,
 
 
 
+UriBool URI_FUNC(SameOrigin)(const URI_TYPE(Uri) * a,
+		const URI_TYPE(Uri) * b) {
+	unsigned int portA;
+	unsigned int portB;
+
+	/* URIs without host have an opaque origin that equals no other */
+	if ((a == NULL) || (b == NULL)
+			|| (a->hostText.first == NULL) || (b->hostText.first == NULL)) {
+		return URI_FALSE;
+	}
+
+	/* Scheme */
+	if (URI_FUNC(CompareRangeIgnoreCase)(&(a->scheme), &(b->scheme))) {
+		return URI_FALSE;
+	}
+
+	/* Host */
+	if (((a->hostData.ip4 == NULL) != (b->hostData.ip4 == NULL))
+			|| ((a->hostData.ip6 == NULL) != (b->hostData.ip6 == NULL))
+			|| ((a->hostData.ipFuture.first == NULL)
+				!= (b->hostData.ipFuture.first == NULL))) {
+		return URI_FALSE;
+	}
+
+	if (a->hostData.ip4 != NULL) {
+		if (memcmp(a->hostData.ip4->data, b->hostData.ip4->data, 4)) {
+			return URI_FALSE;
+		}
+	} else if (a->hostData.ip6 != NULL) {
+		if (memcmp(a->hostData.ip6->data, b->hostData.ip6->data, 16)) {
+			return URI_FALSE;
+		}
+	} else if (a->hostData.ipFuture.first != NULL) {
+		if (URI_FUNC(CompareRangeIgnoreCase)(&(a->hostData.ipFuture),
+				&(b->hostData.ipFuture))) {
+			return URI_FALSE;
+		}
+	} else if (URI_FUNC(CompareRangeIgnoreCase)(&(a->hostText),
+			&(b->hostText))) {
+		return URI_FALSE;
+	}
+
+	/* Port */
+	if ((URI_FUNC(EffectivePort)(a, &portA) != URI_SUCCESS)
+			|| (URI_FUNC(EffectivePort)(b, &portB) != URI_SUCCESS)
+			|| (portA != portB)) {
+		return URI_FALSE;
+	}
+
+	return URI_TRUE;
+}
+
+
+
+/* Checks for "." and "..", also when percent-encoded as in "%2e." */
+static UriBool URI_FUNC(IsDotSegment)(const URI_TYPE(TextRange) * text) {
+	const URI_CHAR * walker = text->first;
+	int dots = 0;
+
+	while (walker < text->afterLast) {
+		if (walker[0] == _UT('.')) {
+			walker++;
+		} else if ((text->afterLast - walker >= 3)
+				&& (walker[0] == _UT('%'))
+				&& (walker[1] == _UT('2'))
+				&& ((walker[2] == _UT('e')) || (walker[2] == _UT('E')))) {
+			walker += 3;
+		} else {
+			return URI_FALSE;
+		}
+		dots++;
+	}
+	return ((dots == 1) || (dots == 2)) ? URI_TRUE : URI_FALSE;
+}
+
+
+
+UriBool URI_FUNC(IsUnderBase)(const URI_TYPE(Uri) * uri,
+		const URI_TYPE(Uri) * base) {
+	const URI_TYPE(PathSegment) * walkUri;
+	const URI_TYPE(PathSegment) * walkBase;
+
+	if (! URI_FUNC(SameOrigin)(uri, base)) {
+		return URI_FALSE;
+	}
+
+	/* Dot segments could climb out of the base after the fact */
+	for (walkUri = uri->pathHead; walkUri != NULL; walkUri = walkUri->next) {
+		if (URI_FUNC(IsDotSegment)(&(walkUri->text))) {
+			return URI_FALSE;
+		}
+	}
+
+	walkUri = uri->pathHead;
+	for (walkBase = base->pathHead; walkBase != NULL; walkBase = walkBase->next) {
+		if (URI_FUNC(IsDotSegment)(&(walkBase->text))) {
+			return URI_FALSE;
+		}
+
+		/* A trailing slash of the base, as in "/docs/", matches any rest
+		 * but no rest at all ("/docs"), unless the base is the root */
+		if ((walkBase->next == NULL)
+				&& (walkBase->text.first == walkBase->text.afterLast)) {
+			return ((walkUri != NULL) || (walkBase == base->pathHead))
+					? URI_TRUE
+					: URI_FALSE;
+		}
+
+		if ((walkUri == NULL)
+				|| URI_FUNC(CompareRange)(&(walkUri->text), &(walkBase->text))) {
+			return URI_FALSE;
+		}
+		walkUri = walkUri->next;
+	}
+
+	return URI_TRUE;
+}
+
+
+
 #endif
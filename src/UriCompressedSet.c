@@ -0,0 +1,619 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriCompressedSet.c
+ * Holds the front-coded compressed URI set implementation.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriCompressedSet.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriCompressedSet.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriCompressedSet.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriMemory.h"
+#endif
+
+
+
+#include <limits.h>
+
+
+
+/*
+ * Strings are front-coded in blocks of URI_SET_BLOCK_SIZE:
+ * the first of a block is stored in full (length, characters),
+ * the others as the length of the prefix shared with their
+ * predecessor, the length of the rest, and the rest.
+ * Lengths are unsigned LEB128; characters are bytes for char
+ * and LEB128 for wider types, so ASCII takes a byte either way.
+ */
+#ifndef URI_SET_BLOCK_SIZE
+# define URI_SET_BLOCK_SIZE  16
+#endif
+
+
+
+struct URI_TYPE(CompressedSetStruct) {
+	UriMemoryManager * memory;
+	int count; /* Strings */
+	int blockCount;
+	int maxLength; /* Of all strings, in characters */
+	int byteSize; /* Of this block of memory */
+	const unsigned int * blockOffsets; /* Into .data, one per block */
+	const unsigned char * data;
+};
+
+
+
+/* Writes (dest != NULL) or measures a number, returns its size */
+static unsigned int URI_FUNC(PutNumber)(unsigned char * dest,
+		unsigned long value) {
+	unsigned int size = 0;
+	do {
+		const unsigned char low = (unsigned char)(value & 0x7F);
+		value >>= 7;
+		if (dest != NULL) {
+			dest[size] = (unsigned char)(low | ((value != 0) ? 0x80 : 0));
+		}
+		size++;
+	} while (value != 0);
+	return size;
+}
+
+
+
+static unsigned long URI_FUNC(GetNumber)(const unsigned char ** source) {
+	const unsigned char * walker = *source;
+	unsigned long value = 0;
+	int shift = 0;
+	do {
+		value |= (unsigned long)(*walker & 0x7F) << shift;
+		shift += 7;
+	} while (*walker++ & 0x80);
+	*source = walker;
+	return value;
+}
+
+
+
+static unsigned int URI_FUNC(PutChars)(unsigned char * dest,
+		const URI_CHAR * first, int length) {
+	unsigned int size = 0;
+	int i;
+	if (sizeof(URI_CHAR) == 1) {
+		if (dest != NULL) {
+			memcpy(dest, first, (size_t)length);
+		}
+		return (unsigned int)length;
+	}
+	for (i = 0; i < length; i++) {
+		size += URI_FUNC(PutNumber)((dest != NULL) ? (dest + size) : NULL,
+				(unsigned long)first[i]);
+	}
+	return size;
+}
+
+
+
+static URI_CHAR URI_FUNC(GetChar)(const unsigned char ** source) {
+	if (sizeof(URI_CHAR) == 1) {
+		return (URI_CHAR)*((*source)++);
+	}
+	return (URI_CHAR)URI_FUNC(GetNumber)(source);
+}
+
+
+
+static void URI_FUNC(SkipChars)(const unsigned char ** source, unsigned long count) {
+	if (sizeof(URI_CHAR) == 1) {
+		*source += count;
+		return;
+	}
+	for (; count > 0; count--) {
+		while (*((*source)++) & 0x80) {
+		}
+	}
+}
+
+
+
+/* Characters are ordered as unsigned numbers, like strcmp does */
+#ifndef URI_SET_UNIT
+# define URI_SET_UNIT(c)  ((sizeof(URI_CHAR) == 1) \
+		? (unsigned long)(unsigned char)(c) \
+		: (unsigned long)(c))
+#endif
+
+
+
+static int URI_FUNC(SharedPrefix)(const URI_CHAR * a, int lengthA,
+		const URI_CHAR * b, int lengthB) {
+	int shared = 0;
+	while ((shared < lengthA) && (shared < lengthB) && (a[shared] == b[shared])) {
+		shared++;
+	}
+	return shared;
+}
+
+
+
+/*
+ * Encodes the strings to dest, or measures them if dest is NULL.
+ * Duplicates are skipped, unsorted input is rejected.
+ */
+static int URI_FUNC(EncodeSet)(unsigned char * dest, unsigned int * blockOffsets,
+		const URI_TYPE(TextRange) * uris, int count, int * errorIndex,
+		unsigned long * byteCount, int * setCount, int * maxLength) {
+	unsigned long size = 0;
+	int written = 0;
+	int previous = -1;
+	int i;
+
+	*maxLength = 0;
+	for (i = 0; i < count; i++) {
+		const URI_CHAR * const first = uris[i].first;
+		const int length = URI_FUNC(RangeLength)(&uris[i]);
+		int shared = 0;
+
+		if (previous >= 0) {
+			const URI_CHAR * const prevFirst = uris[previous].first;
+			const int prevLength = URI_FUNC(RangeLength)(&uris[previous]);
+			shared = URI_FUNC(SharedPrefix)(prevFirst, prevLength, first, length);
+			if ((shared == length) && (shared == prevLength)) {
+				continue;  /* Duplicate */
+			}
+			if ((shared == length)
+					|| ((shared < prevLength) && (URI_SET_UNIT(prevFirst[shared])
+						> URI_SET_UNIT(first[shared])))) {
+				if (errorIndex != NULL) {
+					*errorIndex = i;
+				}
+				return URI_ERROR_COMPRESSEDSET_NOT_SORTED;
+			}
+		}
+
+		if (written % URI_SET_BLOCK_SIZE == 0) {
+			if (blockOffsets != NULL) {
+				blockOffsets[written / URI_SET_BLOCK_SIZE] = (unsigned int)size;
+			}
+			size += URI_FUNC(PutNumber)((dest != NULL) ? (dest + size) : NULL,
+					(unsigned long)length);
+			shared = 0;
+		} else {
+			size += URI_FUNC(PutNumber)((dest != NULL) ? (dest + size) : NULL,
+					(unsigned long)shared);
+			size += URI_FUNC(PutNumber)((dest != NULL) ? (dest + size) : NULL,
+					(unsigned long)(length - shared));
+		}
+		size += URI_FUNC(PutChars)((dest != NULL) ? (dest + size) : NULL,
+				first + shared, length - shared);
+		if (size > (unsigned long)INT_MAX / 2) {
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+
+		if (length > *maxLength) {
+			*maxLength = length;
+		}
+		previous = i;
+		written++;
+	}
+
+	*byteCount = size;
+	*setCount = written;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(BuildCompressedSetMm)(URI_TYPE(CompressedSet) ** set,
+		const URI_TYPE(TextRange) * uris, int count, int * errorIndex,
+		UriMemoryManager * memory) {
+	URI_TYPE(CompressedSet) * built;
+	unsigned long byteCount;
+	unsigned int * blockOffsets;
+	unsigned char * data;
+	int setCount;
+	int maxLength;
+	int blockCount;
+	size_t headerSize;
+	size_t total;
+	int res;
+
+	if ((set == NULL) || ((uris == NULL) && (count > 0))) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	res = URI_FUNC(EncodeSet)(NULL, NULL, uris, count, errorIndex,
+			&byteCount, &setCount, &maxLength);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+
+	/* One block of memory: the struct, the block offsets, the data */
+	blockCount = (setCount + URI_SET_BLOCK_SIZE - 1) / URI_SET_BLOCK_SIZE;
+	headerSize = sizeof(URI_TYPE(CompressedSet))
+			+ (size_t)blockCount * sizeof(unsigned int);
+	total = headerSize + byteCount;
+	if (total > (size_t)INT_MAX) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	built = memory->malloc(memory, total);
+	if (built == NULL) {
+		return URI_ERROR_MALLOC;
+	}
+	blockOffsets = (unsigned int *)(void *)(built + 1);
+	data = (unsigned char *)built + headerSize;
+
+	URI_FUNC(EncodeSet)(data, blockOffsets, uris, count, NULL,
+			&byteCount, &setCount, &maxLength);
+	built->memory = memory;
+	built->count = setCount;
+	built->blockCount = blockCount;
+	built->maxLength = maxLength;
+	built->byteSize = (int)total;
+	built->blockOffsets = blockOffsets;
+	built->data = data;
+
+	*set = built;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(BuildCompressedSet)(URI_TYPE(CompressedSet) ** set,
+		const URI_TYPE(TextRange) * uris, int count, int * errorIndex) {
+	return URI_FUNC(BuildCompressedSetMm)(set, uris, count, errorIndex, NULL);
+}
+
+
+
+void URI_FUNC(FreeCompressedSet)(URI_TYPE(CompressedSet) * set) {
+	if (set == NULL) {
+		return;
+	}
+	set->memory->free(set->memory, set);
+}
+
+
+
+int URI_FUNC(CompressedSetCount)(const URI_TYPE(CompressedSet) * set) {
+	return (set == NULL) ? 0 : set->count;
+}
+
+
+
+int URI_FUNC(CompressedSetByteSize)(const URI_TYPE(CompressedSet) * set) {
+	return (set == NULL) ? 0 : set->byteSize;
+}
+
+
+
+/*
+ * Compares characters at source with those of text from offset on,
+ * consuming all length of them. Sets *shared to the offset of the
+ * first difference and returns the sign of (stored - text), with
+ * a stored string that is a prefix of text comparing less.
+ */
+static int URI_FUNC(CompareChars)(const unsigned char ** source,
+		unsigned long length, const URI_CHAR * text, int textLength,
+		int offset, int * shared) {
+	unsigned long i;
+	for (i = 0; i < length; i++) {
+		const URI_CHAR c = URI_FUNC(GetChar)(source);
+		if ((offset >= textLength) || (c != text[offset])) {
+			*shared = offset;
+			URI_FUNC(SkipChars)(source, length - i - 1);
+			return ((offset >= textLength)
+					|| (URI_SET_UNIT(c) > URI_SET_UNIT(text[offset]))) ? 1 : -1;
+		}
+		offset++;
+	}
+	*shared = offset;
+	return (offset == textLength) ? 0 : -1;
+}
+
+
+
+/*
+ * Determines the number of strings less than text, without
+ * decompressing: only the shared prefix of the current string and
+ * text is tracked, which the prefix length of the next string
+ * compares against before any character needs to be looked at.
+ */
+static int URI_FUNC(Search)(const URI_TYPE(CompressedSet) * set,
+		const URI_CHAR * text, int textLength, UriBool * contained) {
+	const unsigned char * walker;
+	int shared;
+	int cmp;
+	int low = 0;
+	int high;
+	int block;
+	int i;
+
+	*contained = URI_FALSE;
+	if (set->count == 0) {
+		return 0;
+	}
+
+	/* Last block whose first string is not greater than text */
+	high = set->blockCount - 1;
+	block = -1;
+	while (low <= high) {
+		const int middle = low + (high - low) / 2;
+		unsigned long length;
+		walker = set->data + set->blockOffsets[middle];
+		length = URI_FUNC(GetNumber)(&walker);
+		cmp = URI_FUNC(CompareChars)(&walker, length, text, textLength, 0, &shared);
+		if (cmp == 0) {
+			*contained = URI_TRUE;
+			return middle * URI_SET_BLOCK_SIZE;
+		} else if (cmp < 0) {
+			block = middle;
+			low = middle + 1;
+		} else {
+			high = middle - 1;
+		}
+	}
+	if (block < 0) {
+		return 0;
+	}
+
+	/* Walk the block, the first string is less than text */
+	walker = set->data + set->blockOffsets[block];
+	cmp = URI_FUNC(CompareChars)(&walker, URI_FUNC(GetNumber)(&walker),
+			text, textLength, 0, &shared);
+	for (i = block * URI_SET_BLOCK_SIZE + 1;
+			(i < set->count) && (i < (block + 1) * URI_SET_BLOCK_SIZE); i++) {
+		const unsigned long prefix = URI_FUNC(GetNumber)(&walker);
+		const unsigned long rest = URI_FUNC(GetNumber)(&walker);
+		if (prefix > (unsigned long)shared) {
+			/* Agrees with the previous string where it was less than text */
+			URI_FUNC(SkipChars)(&walker, rest);
+			continue;
+		} else if (prefix < (unsigned long)shared) {
+			/* Greater than the previous string where it agreed with text */
+			return i;
+		}
+		cmp = URI_FUNC(CompareChars)(&walker, rest, text, textLength,
+				shared, &shared);
+		if (cmp == 0) {
+			*contained = URI_TRUE;
+			return i;
+		} else if (cmp > 0) {
+			return i;
+		}
+	}
+	return i;
+}
+
+
+
+int URI_FUNC(CompressedSetRank)(const URI_TYPE(CompressedSet) * set,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		int * rank, UriBool * contained) {
+	UriBool found;
+	int position;
+
+	if ((set == NULL) || (first == NULL) || (rank == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (afterLast == NULL) {
+		afterLast = first + URI_STRLEN(first);
+	}
+
+	position = URI_FUNC(Search)(set, first, (int)(afterLast - first), &found);
+	*rank = position;
+	if (contained != NULL) {
+		*contained = found;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+UriBool URI_FUNC(CompressedSetContains)(const URI_TYPE(CompressedSet) * set,
+		const URI_CHAR * first, const URI_CHAR * afterLast) {
+	UriBool contained;
+	int rank;
+	return (URI_FUNC(CompressedSetRank)(set, first, afterLast, &rank,
+			&contained) == URI_SUCCESS) ? contained : URI_FALSE;
+}
+
+
+
+/*
+ * Decodes the string at index with *walker at its entry and dest
+ * holding its predecessor, writing no more than maxChars characters.
+ * Returns its length and leaves *walker at the next entry.
+ */
+static int URI_FUNC(DecodeEntry)(const unsigned char ** walker, int index,
+		URI_CHAR * dest, int maxChars) {
+	unsigned long prefix = 0;
+	unsigned long rest;
+	unsigned long k;
+
+	if (index % URI_SET_BLOCK_SIZE != 0) {
+		prefix = URI_FUNC(GetNumber)(walker);
+	}
+	rest = URI_FUNC(GetNumber)(walker);
+	for (k = 0; k < rest; k++) {
+		const URI_CHAR c = URI_FUNC(GetChar)(walker);
+		if (prefix + k < (unsigned long)maxChars) {
+			dest[prefix + k] = c;
+		}
+	}
+	return (int)(prefix + rest);
+}
+
+
+
+/*
+ * Decodes the string at index like DecodeEntry, starting over at the
+ * beginning of its block. Characters below the resulting length are
+ * complete even if predecessors were cut off at maxChars.
+ */
+static int URI_FUNC(DecodeAt)(const URI_TYPE(CompressedSet) * set,
+		int index, URI_CHAR * dest, int maxChars,
+		const unsigned char ** walker) {
+	int length = 0;
+	int i;
+
+	*walker = set->data + set->blockOffsets[index / URI_SET_BLOCK_SIZE];
+	for (i = index - index % URI_SET_BLOCK_SIZE; i <= index; i++) {
+		length = URI_FUNC(DecodeEntry)(walker, i, dest, maxChars);
+	}
+	return length;
+}
+
+
+
+int URI_FUNC(CompressedSetGet)(const URI_TYPE(CompressedSet) * set,
+		int index, URI_CHAR * dest, int maxChars, int * charsWritten) {
+	const unsigned char * walker;
+	int length;
+
+	if ((set == NULL) || (dest == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if ((index < 0) || (index >= set->count)) {
+		return URI_ERROR_RANGE_INVALID;
+	}
+
+	length = URI_FUNC(DecodeAt)(set, index, dest,
+			(maxChars > 0) ? (maxChars - 1) : 0, &walker);
+	if (length >= maxChars) {
+		if (charsWritten != NULL) {
+			*charsWritten = 0;
+		}
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	dest[length] = _UT('\0');
+	if (charsWritten != NULL) {
+		*charsWritten = length + 1;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(CompressedSetEnumeratePrefix)(const URI_TYPE(CompressedSet) * set,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_TYPE(CompressedSetCallback) callback, void * userData) {
+	const unsigned char * walker;
+	URI_CHAR * buffer;
+	UriBool contained;
+	int prefixLength;
+	int length;
+	int i;
+
+	if ((set == NULL) || (first == NULL) || (callback == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (afterLast == NULL) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	prefixLength = (int)(afterLast - first);
+
+	i = URI_FUNC(Search)(set, first, prefixLength, &contained);
+	if (i >= set->count) {
+		return URI_SUCCESS;
+	}
+
+	buffer = set->memory->malloc(set->memory,
+			((size_t)set->maxLength + 1) * sizeof(URI_CHAR));
+	if (buffer == NULL) {
+		return URI_ERROR_MALLOC;
+	}
+
+	/* The first match is the first string not less than the prefix,
+	 * if any; matches end at the first string that does not match */
+	length = URI_FUNC(DecodeAt)(set, i, buffer, set->maxLength, &walker);
+	for (;;) {
+		if ((length < prefixLength)
+				|| ((prefixLength > 0) && (memcmp(buffer, first,
+					prefixLength * sizeof(URI_CHAR)) != 0))
+				|| !callback(userData, buffer, buffer + length, i)) {
+			break;
+		}
+		if (++i >= set->count) {
+			break;
+		}
+		/* Blocks are back to back, so just read on */
+		length = URI_FUNC(DecodeEntry)(&walker, i, buffer, set->maxLength);
+	}
+
+	set->memory->free(set->memory, buffer);
+	return URI_SUCCESS;
+}
+
+
+
+#endif
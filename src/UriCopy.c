@@ -41,13 +41,19 @@
 /**
  * @file UriCopy.c
  * Holds the RFC 3986 %URI normalization implementation.
- * NOTE: This source file includes itself twice.
+ * NOTE: This source file includes itself once per encoding.
  */
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriCopy.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriCopy.c"
@@ -61,9 +67,11 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -194,15 +202,16 @@ int URI_FUNC(CopyUriMm)(URI_TYPE(Uri) * destUri,
 				revertMask |= URI_NORMALIZE_PATH;
 			}
 
+			/* Link before copying the text so that cleanup finds the segment */
+			if (destPrev != NULL) {
+				destPrev->next = destWalker;
+			}
+
 			if (URI_FUNC(CopyRangeAsNeeded)(&destWalker->text, &sourceWalker->text, memory) == URI_FALSE) {
 				URI_FUNC(PreventLeakageAfterCopy)(destUri, revertMask, memory);
 				return URI_ERROR_MALLOC;
 			}
 
-			if (destPrev != NULL) {
-				destPrev->next = destWalker;
-			}
-
 			destPrev = destWalker;
 			sourceWalker = sourceWalker->next;
 
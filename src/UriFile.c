@@ -39,8 +39,14 @@
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriFile.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriFile.c"
@@ -54,15 +60,18 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
 
 #ifndef URI_DOXYGEN
 # include <uriparser/Uri.h>
+# include "UriCommon.h"
 #endif
 
 
@@ -0,0 +1,519 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriFind.c
+ * Finds URIs in free text.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriFind.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriFind.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriFind.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriMemory.h"
+# include "UriParseBase.h"
+#endif
+
+
+
+/* Parses per candidate at most, so that scanning stays linear */
+#ifndef URI_FIND_MAX_ATTEMPTS
+# define URI_FIND_MAX_ATTEMPTS  8
+#endif
+
+/* Characters searched for candidates at first, doubled as needed */
+#ifndef URI_FIND_MIN_WINDOW
+# define URI_FIND_MIN_WINDOW  256
+#endif
+
+
+
+/* Characters of a URI reference, "%" without looking at what follows */
+static URI_INLINE UriBool URI_FUNC(IsFindUriChar)(URI_CHAR c) {
+	return (URI_FAST_CHAR_IS(c, URI_FAST_QUERY)
+			|| (c == _UT('%'))
+			|| (c == _UT('#'))
+			|| (c == _UT('['))
+			|| (c == _UT(']'))) ? URI_TRUE : URI_FALSE;
+}
+
+
+
+/*
+ * Drops trailing characters that rather belong to the surrounding
+ * text, e.g. the full stop in "See http://example.org/." or the
+ * closing parenthesis in "(http://example.org/)".
+ */
+static const URI_CHAR * URI_FUNC(TrimCandidate)(const URI_CHAR * first,
+		const URI_CHAR * afterLast) {
+	const URI_CHAR * walker;
+	int parenDepth = 0;
+	int bracketDepth = 0;
+
+	/* Counted once, a negative depth means an unbalanced close */
+	for (walker = first; walker < afterLast; walker++) {
+		switch (*walker) {
+		case _UT('('):
+			parenDepth++;
+			break;
+
+		case _UT(')'):
+			parenDepth--;
+			break;
+
+		case _UT('['):
+			bracketDepth++;
+			break;
+
+		case _UT(']'):
+			bracketDepth--;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	while (afterLast > first) {
+		switch (afterLast[-1]) {
+		case _UT('.'):
+		case _UT(','):
+		case _UT(';'):
+		case _UT(':'):
+		case _UT('!'):
+		case _UT('?'):
+		case _UT('\''):
+			afterLast--;
+			break;
+
+		case _UT(')'):
+			if (parenDepth >= 0) {
+				return afterLast;
+			}
+			parenDepth++;
+			afterLast--;
+			break;
+
+		case _UT(']'):
+			if (bracketDepth >= 0) {
+				return afterLast;
+			}
+			bracketDepth++;
+			afterLast--;
+			break;
+
+		default:
+			return afterLast;
+		}
+	}
+	return afterLast;
+}
+
+
+
+/*
+ * Finds the next "scheme://" with its colon at or after *searchFrom
+ * and before searchLimit.  Returns the first character of the scheme
+ * or NULL, in which case *searchFrom is moved up to searchLimit.
+ */
+static const URI_CHAR * URI_FUNC(NextSchemeCandidate)(const URI_CHAR * first,
+		const URI_CHAR ** searchFrom, const URI_CHAR * searchLimit,
+		const URI_CHAR * afterLast, const URI_CHAR ** colon, size_t * work) {
+	const URI_CHAR * walker = *searchFrom;
+
+	if (walker >= searchLimit) {
+		return NULL;  /* Searched further already, keep that */
+	}
+	while (walker < searchLimit) {
+		const URI_CHAR * const candidateColon
+				= URI_MEMCHR(walker, _UT(':'), (size_t)(searchLimit - walker));
+		const URI_CHAR * schemeFirst;
+		if (candidateColon == NULL) {
+			*work += (size_t)(searchLimit - walker);
+			break;
+		}
+		*work += (size_t)(candidateColon + 1 - walker);
+		walker = candidateColon + 1;
+
+		if ((afterLast - candidateColon < 3)
+				|| (candidateColon[1] != _UT('/'))
+				|| (candidateColon[2] != _UT('/'))) {
+			continue;
+		}
+
+		/* Walk back over the scheme, which has to start with a letter */
+		schemeFirst = candidateColon;
+		while ((schemeFirst > first)
+				&& URI_FAST_CHAR_IS(schemeFirst[-1], URI_FAST_SCHEME)) {
+			schemeFirst--;
+		}
+		*work += (size_t)(candidateColon - schemeFirst);
+		while ((schemeFirst < candidateColon)
+				&& !URI_FAST_CHAR_IS(*schemeFirst, URI_FAST_ALPHA)) {
+			schemeFirst++;
+		}
+		if (schemeFirst < candidateColon) {
+			*searchFrom = walker;
+			*colon = candidateColon;
+			return schemeFirst;
+		}
+	}
+
+	*searchFrom = searchLimit;
+	return NULL;
+}
+
+
+
+/*
+ * Finds the next "www." with its dot at or after *searchFrom and
+ * before searchLimit, that starts a word and is followed by more host
+ * characters.  Returns the first "w" or NULL, in which case
+ * *searchFrom is moved up to searchLimit.
+ */
+static const URI_CHAR * URI_FUNC(NextWwwCandidate)(const URI_CHAR * first,
+		const URI_CHAR ** searchFrom, const URI_CHAR * searchLimit,
+		const URI_CHAR * afterLast, size_t * work) {
+	const URI_CHAR * walker = *searchFrom;
+
+	if (walker >= searchLimit) {
+		return NULL;  /* Searched further already, keep that */
+	}
+	while (walker < searchLimit) {
+		const URI_CHAR * const dot
+				= URI_MEMCHR(walker, _UT('.'), (size_t)(searchLimit - walker));
+		const URI_CHAR * www;
+		int i;
+		if (dot == NULL) {
+			*work += (size_t)(searchLimit - walker);
+			break;
+		}
+		*work += (size_t)(dot + 1 - walker);
+		walker = dot + 1;
+
+		if ((dot - first < 3) || (afterLast - dot < 2)
+				|| !URI_FAST_CHAR_IS(dot[1], URI_FAST_HOST)) {
+			continue;
+		}
+		www = dot - 3;
+		for (i = 0; i < 3; i++) {
+			if ((www[i] != _UT('w')) && (www[i] != _UT('W'))) {
+				break;
+			}
+		}
+		if (i < 3) {
+			continue;
+		}
+		if ((www > first) && (URI_FAST_CHAR_IS(www[-1], URI_FAST_HOST)
+				|| (www[-1] == _UT('/'))
+				|| (www[-1] == _UT('@'))
+				|| (www[-1] == _UT(':'))
+				|| (www[-1] == _UT('%')))) {
+			continue;
+		}
+
+		*searchFrom = walker;
+		return www;
+	}
+
+	*searchFrom = searchLimit;
+	return NULL;
+}
+
+
+
+/*
+ * Takes URI characters from candidateFirst on, trims them and
+ * validates the result with the parser.  Syntax errors shorten
+ * the candidate to the part before the error until either
+ * parsing succeeds or nothing beyond minAfterLast is left.
+ * Gives up after URI_FIND_MAX_ATTEMPTS parses, as each costs
+ * time linear in the length of the candidate.
+ */
+static int URI_FUNC(ParseCandidate)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * candidateFirst, const URI_CHAR * minAfterLast,
+		const URI_CHAR * afterLast, UriBool networkPath,
+		const URI_CHAR ** candidateAfterLast, UriMemoryManager * memory,
+		size_t * work) {
+	const URI_CHAR * walker = candidateFirst;
+	int attempts;
+
+	while ((walker < afterLast) && URI_FUNC(IsFindUriChar)(*walker)) {
+		walker++;
+	}
+	*work += (size_t)(walker - candidateFirst);
+
+	for (attempts = 1; attempts <= URI_FIND_MAX_ATTEMPTS; attempts++) {
+		const URI_CHAR * errorPos = NULL;
+		int res;
+
+		walker = URI_FUNC(TrimCandidate)(candidateFirst, walker);
+		if (walker <= minAfterLast) {
+			return URI_ERROR_SYNTAX;
+		}
+		*work += (size_t)(walker - candidateFirst);
+
+		res = networkPath
+				? URI_FUNC(ParseNetworkPathMm)(uri, candidateFirst, walker,
+					&errorPos, memory)
+				: URI_FUNC(ParseSingleUriExMm)(uri, candidateFirst, walker,
+					&errorPos, memory);
+		if (res != URI_ERROR_SYNTAX) {
+			*candidateAfterLast = walker;
+			return res;
+		}
+		if (errorPos == NULL) {
+			return URI_ERROR_SYNTAX;
+		}
+		if (errorPos < walker) {
+			walker = errorPos;
+			continue;
+		}
+
+		/* Ran out of text, e.g. in "%4", "[::1" or "host:80x" (user info
+		 * without "@"), so cut off before the last character that needs
+		 * lookahead; for the last attempt, before the first one instead,
+		 * as long runs like ":1:1:1" would take one attempt each */
+		if (attempts < URI_FIND_MAX_ATTEMPTS - 1) {
+			errorPos = walker - 1;
+			while ((errorPos > minAfterLast) && (*errorPos != _UT('%'))
+					&& (*errorPos != _UT('[')) && (*errorPos != _UT(':'))) {
+				errorPos--;
+			}
+		} else {
+			errorPos = minAfterLast + 1;
+			while ((errorPos < walker) && (*errorPos != _UT('%'))
+					&& (*errorPos != _UT('[')) && (*errorPos != _UT(':'))) {
+				errorPos++;
+			}
+			if (errorPos >= walker) {
+				return URI_ERROR_SYNTAX;
+			}
+		}
+		if (errorPos <= minAfterLast) {
+			return URI_ERROR_SYNTAX;
+		}
+		walker = errorPos;
+	}
+	return URI_ERROR_SYNTAX;
+}
+
+
+
+/*
+ * Does the work of uriFindUriExMmA, adding the number of characters
+ * looked at to *work so that tests can check it stays linear.
+ *
+ * Both kinds of candidates are searched for within a window that
+ * only grows while it holds neither, so that finding all URIs does
+ * not search the rest of the text over and over.  A candidate of one
+ * kind cannot start before one of the other kind whose colon or dot
+ * is in the window, as neither "www." nor a scheme can start in the
+ * middle of the other; the earliest candidate in the window is
+ * therefore the earliest in the text.
+ */
+static int URI_FUNC(FindUri)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_TYPE(TextRange) * found, UriMemoryManager * memory,
+		size_t * work) {
+	URI_TYPE(Uri) scratchUri;
+	const URI_CHAR * schemeSearch = first;
+	const URI_CHAR * wwwSearch = first;
+	const URI_CHAR * windowAfterLast = first;
+	size_t windowSize = URI_FIND_MIN_WINDOW;
+	const URI_CHAR * colon = NULL;
+	const URI_CHAR * schemeCandidate = NULL;
+	const URI_CHAR * wwwCandidate = NULL;
+
+	found->first = NULL;
+	found->afterLast = NULL;
+
+	for (;;) {
+		UriBool networkPath;
+		const URI_CHAR * candidateFirst;
+		const URI_CHAR * minAfterLast;
+		const URI_CHAR * candidateAfterLast = NULL;
+		int res;
+
+		while ((schemeCandidate == NULL) && (wwwCandidate == NULL)
+				&& (windowAfterLast < afterLast)) {
+			windowAfterLast = ((size_t)(afterLast - windowAfterLast) > windowSize)
+					? windowAfterLast + windowSize
+					: afterLast;
+			windowSize *= 2;
+			schemeCandidate = URI_FUNC(NextSchemeCandidate)(first,
+					&schemeSearch, windowAfterLast, afterLast, &colon, work);
+			wwwCandidate = URI_FUNC(NextWwwCandidate)(first, &wwwSearch,
+					windowAfterLast, afterLast, work);
+		}
+		if ((schemeCandidate == NULL) && (wwwCandidate == NULL)) {
+			break;
+		}
+
+		networkPath = ((schemeCandidate == NULL)
+				|| ((wwwCandidate != NULL) && (wwwCandidate < schemeCandidate)))
+				? URI_TRUE : URI_FALSE;
+
+		/* Only a scheme starting at the very same "w" can have its
+		 * colon beyond the window, e.g. "www.example+tag://", and it
+		 * is tried first */
+		if (networkPath && (schemeCandidate == NULL)) {
+			const URI_CHAR * walker = wwwCandidate + 4;
+			while ((walker < afterLast)
+					&& URI_FAST_CHAR_IS(*walker, URI_FAST_SCHEME)) {
+				walker++;
+			}
+			*work += (size_t)(walker - wwwCandidate);
+			if ((walker >= schemeSearch) && (afterLast - walker >= 3)
+					&& (walker[0] == _UT(':')) && (walker[1] == _UT('/'))
+					&& (walker[2] == _UT('/'))) {
+				schemeCandidate = wwwCandidate;
+				colon = walker;
+				schemeSearch = walker + 1;
+				networkPath = URI_FALSE;
+			}
+		}
+		candidateFirst = networkPath ? wwwCandidate : schemeCandidate;
+		minAfterLast = networkPath ? wwwCandidate + 4 : colon + 3;
+		res = URI_FUNC(ParseCandidate)((uri != NULL) ? uri : &scratchUri,
+				candidateFirst, minAfterLast, afterLast, networkPath,
+				&candidateAfterLast, memory, work);
+
+		if (res == URI_SUCCESS) {
+			if (uri == NULL) {
+				URI_FUNC(FreeUriMembersMm)(&scratchUri, memory);
+			}
+			found->first = candidateFirst;
+			found->afterLast = candidateAfterLast;
+			return URI_SUCCESS;
+		} else if (res != URI_ERROR_SYNTAX) {
+			return res;
+		}
+
+		if (networkPath) {
+			wwwCandidate = URI_FUNC(NextWwwCandidate)(first, &wwwSearch,
+					windowAfterLast, afterLast, work);
+		} else {
+			schemeCandidate = URI_FUNC(NextSchemeCandidate)(first,
+					&schemeSearch, windowAfterLast, afterLast, &colon, work);
+		}
+	}
+
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(FindUriEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_TYPE(TextRange) * found) {
+	if ((afterLast == NULL) && (first != NULL)) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	return URI_FUNC(FindUriExMm)(uri, first, afterLast, found, NULL);
+}
+
+
+
+int URI_FUNC(FindUriExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_TYPE(TextRange) * found, UriMemoryManager * memory) {
+	size_t work = 0;
+
+	/* Check params */
+	if ((first == NULL) || (afterLast == NULL) || (found == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	return URI_FUNC(FindUri)(uri, first, afterLast, found, memory, &work);
+}
+
+
+
+/* Finds all URIs like repeated uriFindUriExA, returns the work done */
+size_t URI_FUNC(_TESTING_ONLY_FindAllWork)(const URI_CHAR * first,
+		const URI_CHAR * afterLast) {
+	URI_TYPE(TextRange) found;
+	size_t work = 0;
+
+	while (URI_FUNC(FindUri)(NULL, first, afterLast, &found,
+			&defaultMemoryManager, &work) == URI_SUCCESS) {
+		if (found.first == NULL) {
+			break;
+		}
+		first = found.afterLast;
+	}
+	return work;
+}
+
+
+
+#endif
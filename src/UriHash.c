@@ -0,0 +1,390 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriHash.c
+ * Holds the origin and site hash implementation.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriHash.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriHash.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriHash.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriHashBase.h"
+# include "UriMemory.h"
+#endif
+
+
+
+/* Separates the fields so that e.g. "ab" + "c" and "a" + "bc" differ */
+#define URI_HASH_SEPARATOR  0x00
+
+/* Tells absent components from empty ones, e.g. "/?" from "/" */
+#define URI_HASH_ABSENT   0x00
+#define URI_HASH_PRESENT  0x01
+
+/* Tells host types apart, an IPv4 address is no registered name */
+#define URI_HASH_TAG_REGNAME    'r'
+#define URI_HASH_TAG_IP4        '4'
+#define URI_HASH_TAG_IP6        '6'
+#define URI_HASH_TAG_IPFUTURE   'v'
+
+
+
+/*
+ * Feeds text to the hash, with ASCII letters lowercased if asked to.
+ * Wide characters are fed as UTF-8 so that all variants agree;
+ * code units that do not decode are fed one by one.
+ */
+static UriUint64 URI_FUNC(HashText)(UriUint64 state,
+		const URI_CHAR * first, const URI_CHAR * afterLast, UriBool lowercase) {
+	const URI_CHAR * walker = first;
+
+	while (walker < afterLast) {
+		const unsigned long unit = (sizeof(URI_CHAR) == 1)
+				? (unsigned char)*walker
+				: (unsigned long)*walker;
+		if ((unit < 0x80) || (sizeof(URI_CHAR) == 1)) {
+			state = URI_HASH_BYTE(state, (lowercase && (unit >= 'A') && (unit <= 'Z'))
+					? (unit + ('a' - 'A'))
+					: unit);
+			walker++;
+		} else {
+			unsigned char bytes[4];
+			unsigned long codePoint;
+			const URI_CHAR * const next = URI_FUNC(DecodeCodePoint)(walker,
+					afterLast, &codePoint);
+			int byteCount;
+			int i;
+			if (next == NULL) {
+				codePoint = unit & 0x1FFFFF;
+				walker++;
+			} else {
+				walker = next;
+			}
+			byteCount = URI_FUNC(EncodeUtf8)(codePoint, bytes);
+			for (i = 0; i < byteCount; i++) {
+				state = URI_HASH_BYTE(state, bytes[i]);
+			}
+		}
+	}
+	return state;
+}
+
+
+
+static UriUint64 URI_FUNC(HashScheme)(UriUint64 state,
+		const URI_TYPE(Uri) * uri) {
+	if (uri->scheme.first != NULL) {
+		state = URI_FUNC(HashText)(state, uri->scheme.first,
+				uri->scheme.afterLast, URI_TRUE);
+	}
+	return URI_HASH_BYTE(state, URI_HASH_SEPARATOR);
+}
+
+
+
+/*
+ * Feeds an IP host by address rather than by text, so that
+ * e.g. "[::1]" and "[0:0:0:0:0:0:0:1]" hash the same.
+ * Returns URI_FALSE for registered names, leaving state alone.
+ */
+static UriBool URI_FUNC(HashIpHost)(UriUint64 * state,
+		const URI_TYPE(Uri) * uri) {
+	UriUint64 value = *state;
+	int i;
+
+	if (uri->hostData.ip4 != NULL) {
+		value = URI_HASH_BYTE(value, URI_HASH_TAG_IP4);
+		for (i = 0; i < 4; i++) {
+			value = URI_HASH_BYTE(value, uri->hostData.ip4->data[i]);
+		}
+	} else if (uri->hostData.ip6 != NULL) {
+		value = URI_HASH_BYTE(value, URI_HASH_TAG_IP6);
+		for (i = 0; i < 16; i++) {
+			value = URI_HASH_BYTE(value, uri->hostData.ip6->data[i]);
+		}
+	} else if (uri->hostData.ipFuture.first != NULL) {
+		value = URI_HASH_BYTE(value, URI_HASH_TAG_IPFUTURE);
+		value = URI_FUNC(HashText)(value,
+				uri->hostData.ipFuture.first,
+				uri->hostData.ipFuture.afterLast, URI_TRUE);
+	} else {
+		return URI_FALSE;
+	}
+	*state = URI_HASH_BYTE(value, URI_HASH_SEPARATOR);
+	return URI_TRUE;
+}
+
+
+
+static UriUint64 URI_FUNC(HashRegName)(UriUint64 state,
+		const URI_CHAR * first, const URI_CHAR * afterLast) {
+	state = URI_HASH_BYTE(state, URI_HASH_TAG_REGNAME);
+	state = URI_FUNC(HashText)(state, first, afterLast, URI_TRUE);
+	return URI_HASH_BYTE(state, URI_HASH_SEPARATOR);
+}
+
+
+
+int URI_FUNC(OriginHash)(const URI_TYPE(Uri) * uri, UriUint64 seed,
+		UriUint64 * hash) {
+	UriUint64 state;
+	unsigned int port;
+	int res;
+
+	if ((uri == NULL) || (hash == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (uri->hostText.first == NULL) {
+		return URI_ERROR_HASH_HOST_NOT_SET;
+	}
+
+	res = URI_FUNC(EffectivePort)(uri, &port);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+
+	state = URI_FUNC(HashScheme)(uriHashStart(seed), uri);
+	if (! URI_FUNC(HashIpHost)(&state, uri)) {
+		state = URI_FUNC(HashRegName)(state, uri->hostText.first,
+				uri->hostText.afterLast);
+	}
+	state = URI_HASH_BYTE(state, port >> 8);
+	state = URI_HASH_BYTE(state, port & 0xFF);
+
+	*hash = uriHashFinish(state);
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(SiteHash)(const URI_TYPE(Uri) * uri,
+		const UriPublicSuffixList * psl, UriUint64 seed, UriUint64 * hash) {
+	UriUint64 state;
+
+	if ((uri == NULL) || (psl == NULL) || (hash == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (uri->hostText.first == NULL) {
+		return URI_ERROR_HASH_HOST_NOT_SET;
+	}
+
+	state = URI_FUNC(HashScheme)(uriHashStart(seed), uri);
+	if (! URI_FUNC(HashIpHost)(&state, uri)) {
+		URI_TYPE(TextRange) registrableDomain;
+		const int res = URI_FUNC(RegistrableDomain)(uri, NULL, psl,
+				&registrableDomain, NULL);
+		if (res != URI_SUCCESS) {
+			return res;
+		}
+		if (registrableDomain.first != NULL) {
+			state = URI_FUNC(HashRegName)(state, registrableDomain.first,
+					registrableDomain.afterLast);
+		} else {
+			/* Public suffix itself (e.g. "localhost"), the site is the host */
+			state = URI_FUNC(HashRegName)(state, uri->hostText.first,
+					uri->hostText.afterLast);
+		}
+	}
+
+	*hash = uriHashFinish(state);
+	return URI_SUCCESS;
+}
+
+
+
+/* Feeds an optional component, e.g. the query, case-sensitively */
+static UriUint64 URI_FUNC(HashComponent)(UriUint64 state,
+		const URI_TYPE(TextRange) * range) {
+	if (range->first == NULL) {
+		return URI_HASH_BYTE(state, URI_HASH_ABSENT);
+	}
+	state = URI_HASH_BYTE(state, URI_HASH_PRESENT);
+	state = URI_FUNC(HashText)(state, range->first, range->afterLast, URI_FALSE);
+	return URI_HASH_BYTE(state, URI_HASH_SEPARATOR);
+}
+
+
+
+/*
+ * Hashes a %URI whose user info, host, path and query are normalized;
+ * scheme and host are lowercased on the fly, the port is taken by
+ * value, an empty path with a host counts as "/", and the fragment
+ * is left out.
+ */
+static int URI_FUNC(HashNormalized)(const URI_TYPE(Uri) * uri,
+		UriUint64 seed, UriUint64 * hash) {
+	const URI_TYPE(PathSegment) * segment;
+	UriUint64 state = URI_FUNC(HashScheme)(uriHashStart(seed), uri);
+
+	state = URI_FUNC(HashComponent)(state, &uri->userInfo);
+	if (uri->hostText.first == NULL) {
+		state = URI_HASH_BYTE(state, URI_HASH_ABSENT);
+	} else {
+		unsigned int port;
+		const int res = URI_FUNC(EffectivePort)(uri, &port);
+		if (res != URI_SUCCESS) {
+			return res;
+		}
+		state = URI_HASH_BYTE(state, URI_HASH_PRESENT);
+		if (! URI_FUNC(HashIpHost)(&state, uri)) {
+			state = URI_FUNC(HashRegName)(state, uri->hostText.first,
+					uri->hostText.afterLast);
+		}
+		state = URI_HASH_BYTE(state, port >> 8);
+		state = URI_HASH_BYTE(state, port & 0xFF);
+		if (uri->pathHead == NULL) {
+			state = URI_HASH_BYTE(state, '/');
+		}
+	}
+
+	for (segment = uri->pathHead; segment != NULL; segment = segment->next) {
+		if ((segment != uri->pathHead) || uri->absolutePath
+				|| (uri->hostText.first != NULL)) {
+			state = URI_HASH_BYTE(state, '/');
+		}
+		state = URI_FUNC(HashText)(state, segment->text.first,
+				segment->text.afterLast, URI_FALSE);
+	}
+	state = URI_HASH_BYTE(state, URI_HASH_SEPARATOR);
+
+	state = URI_FUNC(HashComponent)(state, &uri->query);
+
+	*hash = uriHashFinish(state);
+	return URI_SUCCESS;
+}
+
+
+
+/* Whether host normalization could do more than fold case */
+static UriBool URI_FUNC(HostHasPercent)(const URI_TYPE(Uri) * uri) {
+	const URI_CHAR * walker;
+
+	for (walker = uri->hostText.first; walker < uri->hostText.afterLast;
+			walker++) {
+		if (*walker == _UT('%')) {
+			return URI_TRUE;
+		}
+	}
+	return URI_FALSE;
+}
+
+
+
+int URI_FUNC(NormalizedHashMm)(const URI_TYPE(Uri) * uri, UriUint64 seed,
+		UriUint64 * hash, UriMemoryManager * memory) {
+	URI_TYPE(Uri) normalized;
+	unsigned int mask;
+	int res;
+
+	if ((uri == NULL) || (hash == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	res = URI_FUNC(NormalizeSyntaxMaskRequiredEx)(uri, &mask);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+
+	/* Scheme, host case and port are taken care of while hashing,
+	 * the fragment is left out; so most URIs need no copy */
+	mask &= URI_NORMALIZE_USER_INFO | URI_NORMALIZE_HOST
+			| URI_NORMALIZE_PATH | URI_NORMALIZE_QUERY;
+	if (! URI_FUNC(HostHasPercent)(uri)) {
+		mask &= ~(unsigned int)URI_NORMALIZE_HOST;
+	}
+	if (mask == URI_NORMALIZED) {
+		return URI_FUNC(HashNormalized)(uri, seed, hash);
+	}
+
+	res = URI_FUNC(CopyUriMm)(&normalized, uri, memory);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+	res = URI_FUNC(NormalizeSyntaxExMm)(&normalized, mask, memory);
+	if (res == URI_SUCCESS) {
+		res = URI_FUNC(HashNormalized)(&normalized, seed, hash);
+	}
+	URI_FUNC(FreeUriMembersMm)(&normalized, memory);
+	return res;
+}
+
+
+
+int URI_FUNC(NormalizedHash)(const URI_TYPE(Uri) * uri, UriUint64 seed,
+		UriUint64 * hash) {
+	return URI_FUNC(NormalizedHashMm)(uri, seed, hash, NULL);
+}
+
+
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriHashBase.c
+ * Holds the hashing primitives, independent of the encoding pass.
+ */
+
+#ifndef URI_DOXYGEN
+# include "UriHashBase.h"
+#endif
+
+
+
+/* Finalizer of MurmurHash3, spreads every input bit over the result */
+static UriUint64 uriHashMix(UriUint64 value) {
+	value ^= value >> 33;
+	value *= URI_UINT64(0xFF51AFD7UL, 0xED558CCDUL);
+	value ^= value >> 33;
+	value *= URI_UINT64(0xC4CEB9FEUL, 0x1A85EC53UL);
+	value ^= value >> 33;
+	return value;
+}
+
+
+
+UriUint64 uriHashStart(UriUint64 seed) {
+	return URI_HASH_FNV_OFFSET ^ uriHashMix(seed);
+}
+
+
+
+UriUint64 uriHashFinish(UriUint64 state) {
+	/* FNV-1a alone leaves the high bits weak for short input,
+	 * which uriJumpConsistentHash relies on most */
+	return uriHashMix(state);
+}
+
+
+
+int uriJumpConsistentHash(UriUint64 key, int bucketCount) {
+	int bucket = -1;
+	double jump = 0.0;
+
+	if (bucketCount <= 0) {
+		return -1;
+	}
+
+	/* "A Fast, Minimal Memory, Consistent Hash Algorithm",
+	 * John Lamping and Eric Veach, 2014 */
+	while (jump < (double)bucketCount) {
+		bucket = (int)jump;
+		key = key * URI_UINT64(0x27BB2EE6UL, 0x87B0B0FDUL) + 1;
+		jump = (double)(bucket + 1)
+				* (2147483648.0 / (double)((key >> 33) + 1));
+	}
+	return bucket;
+}
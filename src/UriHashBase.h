@@ -1,7 +1,7 @@
 /*
  * uriparser - RFC 3986 URI parsing library
  *
- * Copyright (C) 2025, Sebastian Pipping <sebastian@pipping.org>
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
  * All rights reserved.
  *
  * Redistribution and use in source  and binary forms, with or without
@@ -36,18 +36,30 @@
  * OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef URI_SET_HOST_BASE_H
-#define URI_SET_HOST_BASE_H 1
+#ifndef URI_HASH_BASE_H
+#define URI_HASH_BASE_H 1
 
 
 
-typedef enum UriHostTypeEnum {
-    URI_HOST_TYPE_IP4,
-    URI_HOST_TYPE_IP6,
-    URI_HOST_TYPE_IPFUTURE,
-    URI_HOST_TYPE_REGNAME
-} UriHostType;
+#include <uriparser/UriBase.h>
 
 
 
-#endif /* URI_SET_HOST_BASE_H */
+/* 64-bit constants built from 32-bit halves, C89 has no long long literals */
+#define URI_UINT64(high, low)  ((((UriUint64)(high)) << 32) | (UriUint64)(low))
+
+/* FNV-1a, see http://www.isthe.com/chongo/tech/comp/fnv/ */
+#define URI_HASH_FNV_OFFSET  URI_UINT64(0xCBF29CE4UL, 0x84222325UL)
+#define URI_HASH_FNV_PRIME   URI_UINT64(0x00000100UL, 0x000001B3UL)
+
+#define URI_HASH_BYTE(state, byte) \
+	(((state) ^ (UriUint64)(unsigned char)(byte)) * URI_HASH_FNV_PRIME)
+
+
+
+UriUint64 uriHashStart(UriUint64 seed);
+UriUint64 uriHashFinish(UriUint64 state);
+
+
+
+#endif /* URI_HASH_BASE_H */
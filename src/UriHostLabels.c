@@ -0,0 +1,268 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriHostLabels.c
+ * Holds the host label index and reversed-domain key implementation.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriHostLabels.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriHostLabels.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriHostLabels.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+#endif
+
+
+
+static int URI_FUNC(IndexHostLabelsEngine)(const URI_TYPE(Uri) * uri,
+		UriHostLabels * labels) {
+	const URI_CHAR * const first = uri->hostText.first;
+	const URI_CHAR * afterLast = uri->hostText.afterLast;
+	const URI_CHAR * walker;
+	int count = 0;
+
+	if ((first == NULL)
+			|| (uri->hostData.ip4 != NULL)
+			|| (uri->hostData.ip6 != NULL)
+			|| (uri->hostData.ipFuture.first != NULL)) {
+		return URI_ERROR_HOST_NOT_REGNAME;
+	}
+
+	/* A trailing dot marks a fully qualified name, not an empty label */
+	if ((afterLast > first) && (afterLast[-1] == _UT('.'))) {
+		afterLast--;
+	}
+
+	if (afterLast > first) {
+		labels->offsets[count++] = 0;
+		for (walker = first; walker < afterLast; walker++) {
+			if (*walker == _UT('.')) {
+				if (count >= URI_HOST_LABELS_MAX) {
+					return URI_ERROR_OUTPUT_TOO_LARGE;
+				}
+				labels->offsets[count++] = (int)(walker + 1 - first);
+			}
+		}
+	}
+	labels->offsets[count] = (int)(afterLast + 1 - first);
+	labels->count = count;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(IndexHostLabels)(const URI_TYPE(Uri) * uri,
+		UriHostLabels * labels) {
+	if ((uri == NULL) || (labels == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	return URI_FUNC(IndexHostLabelsEngine)(uri, labels);
+}
+
+
+
+/*
+ * Writes (dest != NULL) or measures (dest == NULL) the key;
+ * maxChars excludes the terminator.
+ */
+static int URI_FUNC(ReversedHostKeyEngine)(URI_CHAR * dest,
+		const URI_TYPE(Uri) * uri, const UriHostLabels * labels,
+		UriBool withPath, int maxChars, int * length) {
+	const URI_CHAR * const host = uri->hostText.first;
+	int written = 0;
+	int i;
+
+	for (i = labels->count - 1; i >= 0; i--) {
+		const URI_CHAR * walker = host + labels->offsets[i];
+		const URI_CHAR * const labelAfterLast = host + labels->offsets[i + 1] - 1;
+		const int labelLength = (int)(labelAfterLast - walker);
+		const int separatorLength = (i > 0) ? 1 : 0;
+
+		if (dest != NULL) {
+			if (labelLength + separatorLength > maxChars - written) {
+				*length = written;
+				return URI_ERROR_OUTPUT_TOO_LARGE;
+			}
+			for (; walker < labelAfterLast; walker++) {
+				/* Keys of hosts differing in case only should be equal */
+				dest[written++] = ((*walker >= _UT('A')) && (*walker <= _UT('Z')))
+						? (URI_CHAR)(*walker + (_UT('a') - _UT('A')))
+						: *walker;
+			}
+			if (separatorLength > 0) {
+				dest[written++] = _UT('.');
+			}
+		} else {
+			written += labelLength + separatorLength;
+		}
+	}
+
+	if (withPath) {
+		const URI_TYPE(PathSegment) * segment = uri->pathHead;
+		if (dest != NULL) {
+			if (written >= maxChars) {
+				*length = written;
+				return URI_ERROR_OUTPUT_TOO_LARGE;
+			}
+			dest[written] = _UT('/');
+		}
+		written++;
+
+		for (; segment != NULL; segment = segment->next) {
+			const int segmentLength = (int)(segment->text.afterLast
+					- segment->text.first);
+			const int separatorLength = (segment->next != NULL) ? 1 : 0;
+			if (dest != NULL) {
+				if (segmentLength + separatorLength > maxChars - written) {
+					*length = written;
+					return URI_ERROR_OUTPUT_TOO_LARGE;
+				}
+				memcpy(dest + written, segment->text.first,
+						segmentLength * sizeof(URI_CHAR));
+				if (separatorLength > 0) {
+					dest[written + segmentLength] = _UT('/');
+				}
+			}
+			written += segmentLength + separatorLength;
+		}
+	}
+
+	*length = written;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(ToReversedHostKeyCharsRequired)(const URI_TYPE(Uri) * uri,
+		const UriHostLabels * labels, UriBool withPath, int * charsRequired) {
+	UriHostLabels ownLabels;
+
+	if ((uri == NULL) || (charsRequired == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (labels == NULL) {
+		const int res = URI_FUNC(IndexHostLabelsEngine)(uri, &ownLabels);
+		if (res != URI_SUCCESS) {
+			return res;
+		}
+		labels = &ownLabels;
+	}
+
+	return URI_FUNC(ReversedHostKeyEngine)(NULL, uri, labels, withPath, 0,
+			charsRequired);
+}
+
+
+
+int URI_FUNC(ToReversedHostKey)(URI_CHAR * dest, const URI_TYPE(Uri) * uri,
+		const UriHostLabels * labels, UriBool withPath, int maxChars,
+		int * charsWritten) {
+	UriHostLabels ownLabels;
+	int length;
+	int res;
+
+	if ((dest == NULL) || (uri == NULL)) {
+		if (charsWritten != NULL) {
+			*charsWritten = 0;
+		}
+		return URI_ERROR_NULL;
+	}
+	if (maxChars < 1) {
+		if (charsWritten != NULL) {
+			*charsWritten = 0;
+		}
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	dest[0] = _UT('\0');
+	if (labels == NULL) {
+		res = URI_FUNC(IndexHostLabelsEngine)(uri, &ownLabels);
+		if (res != URI_SUCCESS) {
+			if (charsWritten != NULL) {
+				*charsWritten = 0;
+			}
+			return res;
+		}
+		labels = &ownLabels;
+	}
+
+	res = URI_FUNC(ReversedHostKeyEngine)(dest, uri, labels, withPath,
+			maxChars - 1, &length);
+	dest[length] = _UT('\0');
+	if (charsWritten != NULL) {
+		*charsWritten = length + 1;
+	}
+	return res;
+}
+
+
+
+
+#endif
@@ -0,0 +1,674 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriIdna.c
+ * Holds the Punycode (RFC 3492) and host IDNA conversion implementation.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriIdna.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriIdna.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriIdna.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriMemory.h"
+#endif
+
+
+
+#include <string.h>
+
+
+
+/* Bootstring parameters for Punycode, see RFC 3492 section 5 */
+#define URI_PUNY_BASE          36
+#define URI_PUNY_TMIN          1
+#define URI_PUNY_TMAX          26
+#define URI_PUNY_SKEW          38
+#define URI_PUNY_DAMP          700
+#define URI_PUNY_INITIAL_BIAS  72
+#define URI_PUNY_INITIAL_N     0x80
+#define URI_PUNY_MAX_INT       0x7FFFFFFFUL
+
+/* DNS limits, see RFC 1034 section 3.1 */
+#define URI_IDNA_MAX_LABEL     63
+#define URI_IDNA_MAX_HOST      253
+
+
+
+static unsigned long URI_FUNC(PunycodeAdapt)(unsigned long delta,
+		unsigned long numPoints, UriBool firstTime) {
+	unsigned long k = 0;
+
+	delta = firstTime ? (delta / URI_PUNY_DAMP) : (delta / 2);
+	delta += delta / numPoints;
+	while (delta > ((URI_PUNY_BASE - URI_PUNY_TMIN) * URI_PUNY_TMAX) / 2) {
+		delta /= URI_PUNY_BASE - URI_PUNY_TMIN;
+		k += URI_PUNY_BASE;
+	}
+	return k + (URI_PUNY_BASE - URI_PUNY_TMIN + 1) * delta
+			/ (delta + URI_PUNY_SKEW);
+}
+
+
+
+static URI_INLINE unsigned long URI_FUNC(PunycodeThreshold)(unsigned long k,
+		unsigned long bias) {
+	if (k <= bias) {
+		return URI_PUNY_TMIN;
+	} else if (k >= bias + URI_PUNY_TMAX) {
+		return URI_PUNY_TMAX;
+	}
+	return k - bias;
+}
+
+
+
+static URI_INLINE URI_CHAR URI_FUNC(PunycodeDigitToChar)(unsigned long digit) {
+	return (URI_CHAR)((digit < 26)
+			? (_UT('a') + digit)
+			: (_UT('0') + digit - 26));
+}
+
+
+
+static URI_INLINE unsigned long URI_FUNC(PunycodeCharToDigit)(URI_CHAR c) {
+	if ((c >= _UT('a')) && (c <= _UT('z'))) {
+		return (unsigned long)(c - _UT('a'));
+	} else if ((c >= _UT('A')) && (c <= _UT('Z'))) {
+		return (unsigned long)(c - _UT('A'));
+	} else if ((c >= _UT('0')) && (c <= _UT('9'))) {
+		return (unsigned long)(c - _UT('0') + 26);
+	}
+	return URI_PUNY_BASE;  /* i.e. invalid */
+}
+
+
+
+/*
+ * Encodes code points to Punycode, RFC 3492 section 6.3.
+ * dest can be NULL to only count; *length is not touched on error.
+ */
+static int URI_FUNC(PunycodeEncodeCodePoints)(const unsigned long * input,
+		int inputLength, URI_CHAR * dest, int maxChars, int * length) {
+	unsigned long n = URI_PUNY_INITIAL_N;
+	unsigned long delta = 0;
+	unsigned long bias = URI_PUNY_INITIAL_BIAS;
+	int handled;
+	int basicCount;
+	int out = 0;
+	int j;
+
+	for (j = 0; j < inputLength; j++) {
+		if (input[j] < 0x80) {
+			if (out >= maxChars) {
+				return URI_ERROR_OUTPUT_TOO_LARGE;
+			}
+			if (dest != NULL) {
+				dest[out] = (URI_CHAR)input[j];
+			}
+			out++;
+		}
+	}
+	handled = basicCount = out;
+	if (basicCount > 0) {
+		if (out >= maxChars) {
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+		if (dest != NULL) {
+			dest[out] = _UT('-');
+		}
+		out++;
+	}
+
+	while (handled < inputLength) {
+		unsigned long m = URI_PUNY_MAX_INT;
+		for (j = 0; j < inputLength; j++) {
+			if ((input[j] >= n) && (input[j] < m)) {
+				m = input[j];
+			}
+		}
+
+		/* Input is at most a label of valid scalar values, so no overflow */
+		delta += (m - n) * (unsigned long)(handled + 1);
+		n = m;
+
+		for (j = 0; j < inputLength; j++) {
+			if (input[j] < n) {
+				delta++;
+			} else if (input[j] == n) {
+				unsigned long q = delta;
+				unsigned long k;
+				for (k = URI_PUNY_BASE; ; k += URI_PUNY_BASE) {
+					const unsigned long t = URI_FUNC(PunycodeThreshold)(k, bias);
+					if (q < t) {
+						break;
+					}
+					if (out >= maxChars) {
+						return URI_ERROR_OUTPUT_TOO_LARGE;
+					}
+					if (dest != NULL) {
+						dest[out] = URI_FUNC(PunycodeDigitToChar)(
+								t + (q - t) % (URI_PUNY_BASE - t));
+					}
+					out++;
+					q = (q - t) / (URI_PUNY_BASE - t);
+				}
+				if (out >= maxChars) {
+					return URI_ERROR_OUTPUT_TOO_LARGE;
+				}
+				if (dest != NULL) {
+					dest[out] = URI_FUNC(PunycodeDigitToChar)(q);
+				}
+				out++;
+
+				bias = URI_FUNC(PunycodeAdapt)(delta,
+						(unsigned long)(handled + 1),
+						(handled == basicCount) ? URI_TRUE : URI_FALSE);
+				delta = 0;
+				handled++;
+			}
+		}
+		delta++;
+		n++;
+	}
+
+	*length = out;
+	return URI_SUCCESS;
+}
+
+
+
+/*
+ * Decodes Punycode to code points, RFC 3492 section 6.2.
+ * output must have room for URI_IDNA_MAX_LABEL code points.
+ */
+static int URI_FUNC(PunycodeDecodeCodePoints)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, unsigned long * output,
+		int * outputLength) {
+	unsigned long n = URI_PUNY_INITIAL_N;
+	unsigned long i = 0;
+	unsigned long bias = URI_PUNY_INITIAL_BIAS;
+	const URI_CHAR * basicAfterLast = first;
+	const URI_CHAR * walker;
+	int out = 0;
+
+	/* Basic code points come before the last delimiter */
+	for (walker = first; walker < afterLast; walker++) {
+		if (*walker == _UT('-')) {
+			basicAfterLast = walker;
+		}
+	}
+	for (walker = first; walker < basicAfterLast; walker++) {
+		if (((unsigned long)*walker >= 0x80) || (out >= URI_IDNA_MAX_LABEL)) {
+			return URI_ERROR_SYNTAX;
+		}
+		output[out++] = (unsigned long)*walker;
+	}
+	walker = (basicAfterLast > first) ? (basicAfterLast + 1) : first;
+
+	while (walker < afterLast) {
+		const unsigned long oldI = i;
+		unsigned long w = 1;
+		unsigned long k;
+		int j;
+
+		for (k = URI_PUNY_BASE; ; k += URI_PUNY_BASE) {
+			unsigned long digit;
+			unsigned long t;
+			if (walker >= afterLast) {
+				return URI_ERROR_SYNTAX;
+			}
+			digit = URI_FUNC(PunycodeCharToDigit)(*walker++);
+			if ((digit >= URI_PUNY_BASE)
+					|| (digit > (URI_PUNY_MAX_INT - i) / w)) {
+				return URI_ERROR_SYNTAX;
+			}
+			i += digit * w;
+			t = URI_FUNC(PunycodeThreshold)(k, bias);
+			if (digit < t) {
+				break;
+			}
+			if (w > URI_PUNY_MAX_INT / (URI_PUNY_BASE - t)) {
+				return URI_ERROR_SYNTAX;
+			}
+			w *= URI_PUNY_BASE - t;
+		}
+
+		bias = URI_FUNC(PunycodeAdapt)(i - oldI, (unsigned long)(out + 1),
+				(oldI == 0) ? URI_TRUE : URI_FALSE);
+		if (i / (unsigned long)(out + 1) > URI_PUNY_MAX_INT - n) {
+			return URI_ERROR_SYNTAX;
+		}
+		n += i / (unsigned long)(out + 1);
+		i %= (unsigned long)(out + 1);
+
+		if ((n > 0x10FFFF) || ((n >= 0xD800) && (n <= 0xDFFF))
+				|| (out >= URI_IDNA_MAX_LABEL)) {
+			return URI_ERROR_SYNTAX;
+		}
+		for (j = out; j > (int)i; j--) {
+			output[j] = output[j - 1];
+		}
+		output[i] = n;
+		out++;
+		i++;
+	}
+
+	*outputLength = out;
+	return URI_SUCCESS;
+}
+
+
+
+static URI_INLINE UriBool URI_FUNC(IsHexdig)(URI_CHAR c) {
+	return (((c >= _UT('0')) && (c <= _UT('9')))
+			|| ((c >= _UT('a')) && (c <= _UT('f')))
+			|| ((c >= _UT('A')) && (c <= _UT('F'))))
+			? URI_TRUE : URI_FALSE;
+}
+
+
+
+static URI_INLINE UriBool URI_FUNC(IsPercentEncoded)(const URI_CHAR * first,
+		const URI_CHAR * afterLast) {
+	return ((afterLast - first >= 3) && (first[0] == _UT('%'))
+			&& URI_FUNC(IsHexdig)(first[1]) && URI_FUNC(IsHexdig)(first[2]))
+			? URI_TRUE : URI_FALSE;
+}
+
+
+
+static URI_INLINE unsigned long URI_FUNC(PercentEncodedByte)(
+		const URI_CHAR * first) {
+	return (unsigned long)(URI_FUNC(HexdigToInt)(first[1]) * 16
+			+ URI_FUNC(HexdigToInt)(first[2]));
+}
+
+
+
+/*
+ * Reads a code point of a host, where RFC 3986 section 3.2.2 has
+ * non-ASCII characters percent-encoded as UTF-8 and RFC 3987 has
+ * them raw. Returns NULL for ill-formed input.
+ */
+static const URI_CHAR * URI_FUNC(ReadHostCodePoint)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, unsigned long * codePoint) {
+	unsigned long value;
+	int trailCount;
+	int i;
+
+	if (!URI_FUNC(IsPercentEncoded)(first, afterLast)) {
+		return URI_FUNC(DecodeCodePoint)(first, afterLast, codePoint);
+	}
+
+	value = URI_FUNC(PercentEncodedByte)(first);
+	if (value < 0x80) {
+		*codePoint = value;
+		return first + 3;
+	} else if (value < 0xC2) {
+		return NULL;
+	} else if (value < 0xE0) {
+		value &= 0x1F;
+		trailCount = 1;
+	} else if (value < 0xF0) {
+		value &= 0x0F;
+		trailCount = 2;
+	} else if (value < 0xF5) {
+		value &= 0x07;
+		trailCount = 3;
+	} else {
+		return NULL;
+	}
+
+	first += 3;
+	for (i = 0; i < trailCount; i++) {
+		unsigned long trail;
+		if (!URI_FUNC(IsPercentEncoded)(first, afterLast)) {
+			return NULL;
+		}
+		trail = URI_FUNC(PercentEncodedByte)(first);
+		if ((trail & 0xC0) != 0x80) {
+			return NULL;
+		}
+		value = (value << 6) | (trail & 0x3F);
+		first += 3;
+	}
+
+	if (((trailCount == 2) && (value < 0x800))
+			|| ((trailCount == 3) && (value < 0x10000))
+			|| ((value >= 0xD800) && (value <= 0xDFFF))
+			|| (value > 0x10FFFF)) {
+		return NULL;
+	}
+	*codePoint = value;
+	return first;
+}
+
+
+
+static UriBool URI_FUNC(HostNeedsIdna)(const URI_CHAR * first,
+		const URI_CHAR * afterLast) {
+	for (; first < afterLast; first++) {
+		if (((unsigned long)*first >= 0x80)
+				|| (URI_FUNC(IsPercentEncoded)(first, afterLast)
+					&& (URI_FUNC(HexdigToInt)(first[1]) >= 8))) {
+			return URI_TRUE;
+		}
+	}
+	return URI_FALSE;
+}
+
+
+
+static int URI_FUNC(HostToAscii)(const URI_CHAR * first, const URI_CHAR * afterLast,
+		URI_CHAR * dest, int maxChars, int * charsWritten) {
+	const URI_CHAR * labelFirst = first;
+	int out = 0;
+
+	for (;;) {
+		unsigned long codePoints[URI_IDNA_MAX_LABEL];
+		int count = 0;
+		UriBool ascii = URI_TRUE;
+		const URI_CHAR * labelAfterLast = labelFirst;
+		const URI_CHAR * walker = labelFirst;
+
+		while ((labelAfterLast < afterLast) && (*labelAfterLast != _UT('.'))) {
+			labelAfterLast++;
+		}
+
+		while (walker < labelAfterLast) {
+			unsigned long codePoint;
+			walker = URI_FUNC(ReadHostCodePoint)(walker, labelAfterLast,
+					&codePoint);
+			if ((walker == NULL) || (count >= URI_IDNA_MAX_LABEL)) {
+				return URI_ERROR_SYNTAX;
+			}
+			if (codePoint >= 0x80) {
+				ascii = URI_FALSE;
+			} else if ((codePoint >= 'A') && (codePoint <= 'Z')) {
+				codePoint += 'a' - 'A';
+			}
+			codePoints[count++] = codePoint;
+		}
+
+		if (ascii) {
+			/* Copied verbatim, including any percent-encoding */
+			const int labelLength = (int)(labelAfterLast - labelFirst);
+			if (labelLength > maxChars - out) {
+				return URI_ERROR_OUTPUT_TOO_LARGE;
+			}
+			if (dest != NULL) {
+				memcpy(dest + out, labelFirst, labelLength * sizeof(URI_CHAR));
+			}
+			out += labelLength;
+		} else {
+			int encodedLength;
+			int res;
+			if (maxChars - out < 4) {
+				return URI_ERROR_OUTPUT_TOO_LARGE;
+			}
+			if (dest != NULL) {
+				dest[out] = _UT('x');
+				dest[out + 1] = _UT('n');
+				dest[out + 2] = _UT('-');
+				dest[out + 3] = _UT('-');
+			}
+			out += 4;
+			res = URI_FUNC(PunycodeEncodeCodePoints)(codePoints, count,
+					(dest != NULL) ? (dest + out) : NULL, maxChars - out,
+					&encodedLength);
+			if (res != URI_SUCCESS) {
+				return res;
+			}
+			if (4 + encodedLength > URI_IDNA_MAX_LABEL) {
+				return URI_ERROR_SYNTAX;
+			}
+			out += encodedLength;
+		}
+
+		if (labelAfterLast >= afterLast) {
+			break;
+		}
+		if (out >= maxChars) {
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+		if (dest != NULL) {
+			dest[out] = _UT('.');
+		}
+		out++;
+		labelFirst = labelAfterLast + 1;
+	}
+
+	*charsWritten = out;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(NormalizeHostIdnaMm)(URI_TYPE(Uri) * uri,
+		UriMemoryManager * memory) {
+	URI_CHAR buffer[URI_IDNA_MAX_HOST];
+	URI_CHAR * newText;
+	int length;
+	int res;
+
+	if (uri == NULL) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	if ((uri->hostText.first == NULL)
+			|| (uri->hostData.ip4 != NULL)
+			|| (uri->hostData.ip6 != NULL)
+			|| (uri->hostData.ipFuture.first != NULL)
+			|| !URI_FUNC(HostNeedsIdna)(uri->hostText.first,
+				uri->hostText.afterLast)) {
+		return URI_SUCCESS;
+	}
+
+	if (URI_FUNC(HostToAscii)(uri->hostText.first, uri->hostText.afterLast,
+			buffer, URI_IDNA_MAX_HOST, &length) != URI_SUCCESS) {
+		/* Not a valid DNS name in the making, leave it alone */
+		return URI_SUCCESS;
+	}
+
+	if (!uri->owner) {
+		res = URI_FUNC(MakeOwnerMm)(uri, memory);
+		if (res != URI_SUCCESS) {
+			return res;
+		}
+	}
+
+	if (length <= uri->hostText.afterLast - uri->hostText.first) {
+		newText = (URI_CHAR *)uri->hostText.first;
+	} else {
+		newText = memory->malloc(memory, length * sizeof(URI_CHAR));
+		if (newText == NULL) {
+			return URI_ERROR_MALLOC;
+		}
+		/* Non-ASCII hosts are never empty, so this is owned memory */
+		memory->free(memory, (URI_CHAR *)uri->hostText.first);
+		uri->hostText.first = newText;
+	}
+	memcpy(newText, buffer, length * sizeof(URI_CHAR));
+	uri->hostText.afterLast = newText + length;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(NormalizeHostIdna)(URI_TYPE(Uri) * uri) {
+	return URI_FUNC(NormalizeHostIdnaMm)(uri, NULL);
+}
+
+
+
+int URI_FUNC(PunycodeEncode)(URI_CHAR * dest, const URI_CHAR * first,
+		const URI_CHAR * afterLast, int maxChars, int * charsWritten) {
+	unsigned long codePoints[URI_IDNA_MAX_LABEL];
+	const URI_CHAR * walker;
+	int count = 0;
+	int length;
+	int res;
+
+	if ((dest == NULL) || (first == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (afterLast == NULL) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	if (charsWritten != NULL) {
+		*charsWritten = 0;
+	}
+	if (maxChars < 1) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	dest[0] = _UT('\0');
+
+	walker = first;
+	while (walker < afterLast) {
+		if (count >= URI_IDNA_MAX_LABEL) {
+			return URI_ERROR_SYNTAX;
+		}
+		walker = URI_FUNC(DecodeCodePoint)(walker, afterLast,
+				&codePoints[count]);
+		if (walker == NULL) {
+			return URI_ERROR_SYNTAX;
+		}
+		count++;
+	}
+
+	res = URI_FUNC(PunycodeEncodeCodePoints)(codePoints, count, dest,
+			maxChars - 1, &length);
+	if (res != URI_SUCCESS) {
+		dest[0] = _UT('\0');
+		return res;
+	}
+	dest[length] = _UT('\0');
+	if (charsWritten != NULL) {
+		*charsWritten = length + 1;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(PunycodeDecode)(URI_CHAR * dest, const URI_CHAR * first,
+		const URI_CHAR * afterLast, int maxChars, int * charsWritten) {
+	unsigned long codePoints[URI_IDNA_MAX_LABEL];
+	int count;
+	int out = 0;
+	int res;
+	int j;
+
+	if ((dest == NULL) || (first == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (afterLast == NULL) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	if (charsWritten != NULL) {
+		*charsWritten = 0;
+	}
+	if (maxChars < 1) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	dest[0] = _UT('\0');
+
+	res = URI_FUNC(PunycodeDecodeCodePoints)(first, afterLast, codePoints,
+			&count);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+
+	for (j = 0; j < count; j++) {
+		URI_CHAR units[4];
+		const int unitCount = URI_FUNC(EncodeCodePoint)(codePoints[j], units);
+		if (unitCount > maxChars - 1 - out) {
+			dest[out] = _UT('\0');
+			if (charsWritten != NULL) {
+				*charsWritten = out + 1;
+			}
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+		memcpy(dest + out, units, unitCount * sizeof(URI_CHAR));
+		out += unitCount;
+	}
+	dest[out] = _UT('\0');
+	if (charsWritten != NULL) {
+		*charsWritten = out + 1;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+
+#endif
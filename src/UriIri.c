@@ -0,0 +1,202 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriIri.c
+ * Holds the IRI to URI conversion implementation.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriIri.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriIri.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriIri.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+#endif
+
+
+
+/*
+ * Converts (dest != NULL) or measures (dest == NULL) in a single
+ * pass, validating the input encoding on the way.
+ */
+static int URI_FUNC(IriToUriEngine)(URI_CHAR * dest,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		int maxChars, int * charsWritten, int * charsRequired,
+		const URI_CHAR ** errorPos) {
+	const URI_CHAR * walker = first;
+	int written = 0;
+
+	if (afterLast == NULL) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	if (dest != NULL) {
+		if (maxChars < 1) {
+			if (charsWritten != NULL) {
+				*charsWritten = 0;
+			}
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+		maxChars--; /* So we don't have to subtract 1 for '\0' all the time */
+	}
+
+	while (walker < afterLast) {
+		unsigned long codePoint;
+		const URI_CHAR * const next = URI_FUNC(DecodeCodePoint)(walker,
+				afterLast, &codePoint);
+		if (next == NULL) {
+			if (errorPos != NULL) {
+				*errorPos = walker;
+			}
+			if (dest != NULL) {
+				dest[0] = _UT('\0');
+				if (charsWritten != NULL) {
+					*charsWritten = 0;
+				}
+			}
+			return URI_ERROR_SYNTAX;
+		}
+
+		if (codePoint < 0x80) {
+			if (dest != NULL) {
+				if (written + 1 > maxChars) {
+					dest[written] = _UT('\0');
+					if (charsWritten != NULL) {
+						*charsWritten = written + 1;
+					}
+					return URI_ERROR_OUTPUT_TOO_LARGE;
+				}
+				dest[written] = *walker;
+			}
+			written++;
+		} else {
+			unsigned char bytes[4];
+			const int byteCount = URI_FUNC(EncodeUtf8)(codePoint, bytes);
+			int i;
+			if (dest != NULL) {
+				if (written + 3 * byteCount > maxChars) {
+					dest[written] = _UT('\0');
+					if (charsWritten != NULL) {
+						*charsWritten = written + 1;
+					}
+					return URI_ERROR_OUTPUT_TOO_LARGE;
+				}
+				for (i = 0; i < byteCount; i++) {
+					dest[written + 3 * i] = _UT('%');
+					dest[written + 3 * i + 1] = URI_FUNC(HexToLetterEx)(
+							bytes[i] >> 4, URI_TRUE);
+					dest[written + 3 * i + 2] = URI_FUNC(HexToLetterEx)(
+							bytes[i] & 0x0F, URI_TRUE);
+				}
+			}
+			written += 3 * byteCount;
+		}
+		walker = next;
+	}
+
+	if (dest != NULL) {
+		dest[written] = _UT('\0');
+		if (charsWritten != NULL) {
+			*charsWritten = written + 1;
+		}
+	} else {
+		*charsRequired = written;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(IriToUriStringCharsRequired)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, int * charsRequired,
+		const URI_CHAR ** errorPos) {
+	if ((first == NULL) || (charsRequired == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	return URI_FUNC(IriToUriEngine)(NULL, first, afterLast, 0, NULL,
+			charsRequired, errorPos);
+}
+
+
+
+int URI_FUNC(IriToUriString)(URI_CHAR * dest,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		int maxChars, int * charsWritten, const URI_CHAR ** errorPos) {
+	if ((dest == NULL) || (first == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	return URI_FUNC(IriToUriEngine)(dest, first, afterLast, maxChars,
+			charsWritten, NULL, errorPos);
+}
+
+
+
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriIterate.c
+ * Holds allocation-free iteration over path segments and query pairs.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriIterate.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriIterate.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriIterate.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+#endif
+
+
+
+#include <string.h>  /* memcpy */
+
+
+
+int URI_FUNC(PathIteratorInit)(URI_TYPE(PathIterator) * iterator,
+		const URI_CHAR * first, const URI_CHAR * afterLast) {
+	if ((iterator == NULL) || ((first == NULL) != (afterLast == NULL))) {
+		return URI_ERROR_NULL;
+	}
+
+	if (first > afterLast) {
+		return URI_ERROR_RANGE_INVALID;
+	}
+
+	/* Neither "" nor "/" hold any segments */
+	if ((first == afterLast)
+			|| ((afterLast - first == 1) && (first[0] == _UT('/')))) {
+		iterator->next = NULL;
+		iterator->afterLast = NULL;
+		return URI_SUCCESS;
+	}
+
+	/* Skip leading slash of absolute paths */
+	if (first[0] == _UT('/')) {
+		first++;
+	}
+
+	iterator->next = first;
+	iterator->afterLast = afterLast;
+	return URI_SUCCESS;
+}
+
+
+
+UriBool URI_FUNC(PathIteratorNext)(URI_TYPE(PathIterator) * iterator,
+		URI_TYPE(TextRange) * segment) {
+	const URI_CHAR * walk;
+
+	if ((iterator == NULL) || (segment == NULL) || (iterator->next == NULL)) {
+		return URI_FALSE;
+	}
+
+	walk = iterator->next;
+	while ((walk < iterator->afterLast) && (*walk != _UT('/'))) {
+		walk++;
+	}
+
+	segment->first = iterator->next;
+	segment->afterLast = walk;
+
+	/* A trailing slash leaves one more empty segment */
+	iterator->next = (walk < iterator->afterLast) ? walk + 1 : NULL;
+	return URI_TRUE;
+}
+
+
+
+int URI_FUNC(QueryIteratorInit)(URI_TYPE(QueryIterator) * iterator,
+		const URI_CHAR * first, const URI_CHAR * afterLast) {
+	if ((iterator == NULL) || ((first == NULL) != (afterLast == NULL))) {
+		return URI_ERROR_NULL;
+	}
+
+	if (first > afterLast) {
+		return URI_ERROR_RANGE_INVALID;
+	}
+
+	iterator->next = first;
+	iterator->afterLast = afterLast;
+	return URI_SUCCESS;
+}
+
+
+
+UriBool URI_FUNC(QueryIteratorNext)(URI_TYPE(QueryIterator) * iterator,
+		URI_TYPE(TextRange) * key, URI_TYPE(TextRange) * value) {
+	if ((iterator == NULL) || (key == NULL) || (value == NULL)) {
+		return URI_FALSE;
+	}
+
+	/* NOTE: Same item rules as DissectQueryMallocExMm */
+	while ((iterator->next != NULL) && (iterator->next < iterator->afterLast)) {
+		const URI_CHAR * const pairFirst = iterator->next;
+		const URI_CHAR * equals = NULL;
+		const URI_CHAR * walk = pairFirst;
+
+		for (; (walk < iterator->afterLast) && (*walk != _UT('&')); walk++) {
+			/* NOTE: The first '=' is the separator, */
+			/*       all following go into the value */
+			if ((*walk == _UT('=')) && (equals == NULL)) {
+				equals = walk;
+			}
+		}
+
+		iterator->next = (walk < iterator->afterLast) ? walk + 1 : NULL;
+
+		/* Skip empty items, e.g. "&&" */
+		if ((walk == pairFirst) && (equals == NULL)) {
+			continue;
+		}
+
+		key->first = pairFirst;
+		if (equals != NULL) {
+			key->afterLast = equals;
+			value->first = equals + 1;
+			value->afterLast = walk;
+		} else {
+			key->afterLast = walk;
+			value->first = NULL;
+			value->afterLast = NULL;
+		}
+		return URI_TRUE;
+	}
+
+	iterator->next = NULL;
+	return URI_FALSE;
+}
+
+
+
+int URI_FUNC(UnescapeRangeEx)(const URI_TYPE(TextRange) * source,
+		URI_CHAR * dest, int maxChars, URI_TYPE(TextRange) * decoded,
+		UriBool plusToSpace, UriBreakConversion breakConversion) {
+	size_t sourceLen;
+
+	if ((source == NULL) || (decoded == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	/* Missing stays missing, e.g. a value without "=" */
+	if (source->first == NULL) {
+		decoded->first = NULL;
+		decoded->afterLast = NULL;
+		return URI_SUCCESS;
+	}
+
+	if ((dest == NULL) || (source->afterLast == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	if (source->first > source->afterLast) {
+		return URI_ERROR_RANGE_INVALID;
+	}
+
+	/* Decoding never grows the text, the terminator needs room as well */
+	sourceLen = (size_t)(source->afterLast - source->first);
+	if ((maxChars < 1) || (sourceLen > (size_t)(maxChars - 1))) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+
+	memcpy(dest, source->first, sourceLen * sizeof(URI_CHAR));
+	dest[sourceLen] = _UT('\0');
+
+	decoded->first = dest;
+	decoded->afterLast = URI_FUNC(UnescapeInPlaceEx)(dest, plusToSpace,
+			breakConversion);
+	return URI_SUCCESS;
+}
+
+
+
+#endif
@@ -297,6 +297,186 @@ int uriCompleteMemoryManager(UriMemoryManager * memory,
 
 
 
+static void * uriScratchMalloc(UriMemoryManager * memory, size_t size) {
+	UriScratchMemoryManager * const scratch
+			= (UriScratchMemoryManager *)memory->userData;
+
+	if (!scratch->bufferInUse && (size <= sizeof(scratch->buffer))) {
+		scratch->bufferInUse = URI_TRUE;
+		return &scratch->buffer;
+	}
+	return scratch->backend->malloc(scratch->backend, size);
+}
+
+
+
+static void * uriScratchRealloc(UriMemoryManager * memory,
+		void * ptr, size_t size) {
+	UriScratchMemoryManager * const scratch
+			= (UriScratchMemoryManager *)memory->userData;
+	void * newBuffer;
+
+	if (ptr != &scratch->buffer) {
+		return scratch->backend->realloc(scratch->backend, ptr, size);
+	}
+
+	if (size == 0) {
+		scratch->bufferInUse = URI_FALSE;
+		return NULL;
+	}
+
+	/* Anything to do? */
+	if (size <= sizeof(scratch->buffer)) {
+		return ptr;
+	}
+
+	newBuffer = scratch->backend->malloc(scratch->backend, size);
+	if (newBuffer == NULL) {
+		/* errno set by malloc */
+		return NULL;
+	}
+	memcpy(newBuffer, ptr, sizeof(scratch->buffer));
+	scratch->bufferInUse = URI_FALSE;
+	return newBuffer;
+}
+
+
+
+static void uriScratchFree(UriMemoryManager * memory, void * ptr) {
+	UriScratchMemoryManager * const scratch
+			= (UriScratchMemoryManager *)memory->userData;
+
+	if (ptr == &scratch->buffer) {
+		scratch->bufferInUse = URI_FALSE;
+		return;
+	}
+	scratch->backend->free(scratch->backend, ptr);
+}
+
+
+
+void uriInitScratchMemoryManager(UriScratchMemoryManager * scratch,
+		UriMemoryManager * backend) {
+	scratch->manager.malloc = uriScratchMalloc;
+	scratch->manager.calloc = uriEmulateCalloc;
+	scratch->manager.realloc = uriScratchRealloc;
+	scratch->manager.reallocarray = uriEmulateReallocarray;
+	scratch->manager.free = uriScratchFree;
+	scratch->manager.userData = scratch;
+	scratch->backend = backend;
+	scratch->bufferInUse = URI_FALSE;
+}
+
+
+
+/*
+ * Each block is preceded by a header holding its size (for realloc)
+ * and, for blocks from the backend, the link to the next such block.
+ */
+typedef union UriArenaHeaderUnion {
+	struct {
+		size_t size;
+		void * nextOverflow;
+	} info;
+	size_t alignSize;
+	void * alignPointer;
+	double alignDouble;
+} UriArenaHeader;
+
+
+
+static void * uriArenaMalloc(UriMemoryManager * memory, size_t size) {
+	UriArenaMemoryManager * const arena
+			= (UriArenaMemoryManager *)memory->userData;
+	const size_t align = sizeof(UriArenaHeader);
+	size_t total;
+	UriArenaHeader * header;
+
+	/* check for unsigned overflow */
+	if (size > ((size_t)-1) - 2 * align) {
+		errno = ENOMEM;
+		return NULL;
+	}
+	total = sizeof(UriArenaHeader) + (size + align - 1) / align * align;
+
+	if (total <= sizeof(arena->buffer) - arena->used) {
+		header = (UriArenaHeader *)(arena->buffer.bytes + arena->used);
+		arena->used += total;
+		header->info.nextOverflow = NULL;
+	} else {
+		header = arena->backend->malloc(arena->backend, total);
+		if (header == NULL) {
+			return NULL;
+		}
+		header->info.nextOverflow = arena->overflow;
+		arena->overflow = header;
+	}
+	header->info.size = size;
+	return header + 1;
+}
+
+
+
+static void * uriArenaRealloc(UriMemoryManager * memory,
+		void * ptr, size_t size) {
+	void * newBuffer;
+	size_t prevSize;
+
+	if (ptr == NULL) {
+		return memory->malloc(memory, size);
+	}
+
+	prevSize = ((UriArenaHeader *)ptr - 1)->info.size;
+
+	/* Anything to do? */
+	if (size <= prevSize) {
+		return ptr;
+	}
+
+	newBuffer = memory->malloc(memory, size);
+	if (newBuffer == NULL) {
+		/* errno set by malloc */
+		return NULL;
+	}
+	memcpy(newBuffer, ptr, prevSize);
+	return newBuffer;
+}
+
+
+
+static void uriArenaFree(UriMemoryManager * URI_UNUSED(memory),
+		void * URI_UNUSED(ptr)) {
+	/* Released as a whole by uriRewindArena */
+}
+
+
+
+void uriInitArenaMemoryManager(UriArenaMemoryManager * arena,
+		UriMemoryManager * backend) {
+	arena->manager.malloc = uriArenaMalloc;
+	arena->manager.calloc = uriEmulateCalloc;
+	arena->manager.realloc = uriArenaRealloc;
+	arena->manager.reallocarray = uriEmulateReallocarray;
+	arena->manager.free = uriArenaFree;
+	arena->manager.userData = arena;
+	arena->backend = backend;
+	arena->used = 0;
+	arena->overflow = NULL;
+}
+
+
+
+void uriRewindArena(UriArenaMemoryManager * arena) {
+	while (arena->overflow != NULL) {
+		UriArenaHeader * const header = (UriArenaHeader *)arena->overflow;
+		arena->overflow = header->info.nextOverflow;
+		arena->backend->free(arena->backend, header);
+	}
+	arena->used = 0;
+}
+
+
+
 int uriTestMemoryManagerEx(UriMemoryManager * memory, UriBool challengeAlignment) {
 	const size_t mallocSize = 7;
 	const size_t callocNmemb = 3;
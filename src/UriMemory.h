@@ -75,4 +75,58 @@ UriBool uriMemoryManagerIsComplete(const UriMemoryManager * memory);
 
 
 
+/*
+ * Serves one small allocation at a time (e.g. the UriIp4 or UriIp6
+ * host data of a parser run) from inline storage and forwards
+ * everything else to the backend.  Use .manager as the memory manager.
+ */
+typedef struct UriScratchMemoryManagerStruct {
+	UriMemoryManager manager;
+	UriMemoryManager * backend;
+	union {
+		UriIp6 ip6;
+		size_t alignSize;
+		void * alignPointer;
+		double alignDouble;
+	} buffer;
+	UriBool bufferInUse;
+} UriScratchMemoryManager;
+
+
+
+void uriInitScratchMemoryManager(UriScratchMemoryManager * scratch,
+		UriMemoryManager * backend);
+
+
+
+#define URI_ARENA_INLINE_BYTES  2048
+
+/*
+ * Hands out memory from inline storage (and the backend once that is
+ * used up) without ever freeing individual blocks; uriRewindArena
+ * makes all of it available again at once.  Suits repeated parser runs
+ * whose results are dropped as a whole, e.g. when parsing a list of URIs.
+ * Use .manager as the memory manager.
+ */
+typedef struct UriArenaMemoryManagerStruct {
+	UriMemoryManager manager;
+	UriMemoryManager * backend;
+	union {
+		unsigned char bytes[URI_ARENA_INLINE_BYTES];
+		size_t alignSize;
+		void * alignPointer;
+		double alignDouble;
+	} buffer;
+	size_t used;
+	void * overflow; /* Linked list of blocks from the backend */
+} UriArenaMemoryManager;
+
+
+
+void uriInitArenaMemoryManager(UriArenaMemoryManager * arena,
+		UriMemoryManager * backend);
+void uriRewindArena(UriArenaMemoryManager * arena);
+
+
+
 #endif /* URI_MEMORY_H */
@@ -40,11 +40,19 @@
 
 #if (defined(URI_PASS_ANSI) && !defined(URI_NORMALIZE_H_ANSI)) \
 	|| (defined(URI_PASS_UNICODE) && !defined(URI_NORMALIZE_H_UNICODE)) \
-	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_NORMALIZE_H_CHAR16_T)) \
+	|| (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriNormalize.h"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriNormalize.h"
@@ -58,13 +66,18 @@
 /* Only one pass for each encoding */
 #elif (defined(URI_PASS_ANSI) && !defined(URI_NORMALIZE_H_ANSI) \
 	&& defined(URI_ENABLE_ANSI)) || (defined(URI_PASS_UNICODE) \
-	&& !defined(URI_NORMALIZE_H_UNICODE) && defined(URI_ENABLE_UNICODE))
+	&& !defined(URI_NORMALIZE_H_UNICODE) && defined(URI_ENABLE_UNICODE)) \
+	|| (defined(URI_PASS_CHAR16_T) && !defined(URI_NORMALIZE_H_CHAR16_T) \
+	&& defined(URI_ENABLE_CHAR16_T))
 # ifdef URI_PASS_ANSI
 #  define URI_NORMALIZE_H_ANSI 1
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  define URI_NORMALIZE_H_UNICODE 1
 #  include <uriparser/UriDefsUnicode.h>
+# else
+#  define URI_NORMALIZE_H_CHAR16_T 1
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
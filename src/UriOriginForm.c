@@ -0,0 +1,291 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriOriginForm.c
+ * Splits absolute URIs into origin-form request-target and host.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriOriginForm.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriOriginForm.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriOriginForm.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+#endif
+
+
+
+static const URI_CHAR URI_FUNC(RootPath)[] = _UT("/");
+
+
+
+static UriBool URI_FUNC(AppendRange)(URI_CHAR * buffer, int maxChars,
+		int * written, const URI_CHAR * first, const URI_CHAR * afterLast) {
+	const int charsToWrite = (int)(afterLast - first);
+	if (charsToWrite > maxChars - *written) {
+		return URI_FALSE;
+	}
+	if (charsToWrite > 0) {
+		memcpy(buffer + *written, first, charsToWrite * sizeof(URI_CHAR));
+		*written += charsToWrite;
+	}
+	return URI_TRUE;
+}
+
+
+
+static UriBool URI_FUNC(AppendChar)(URI_CHAR * buffer, int maxChars,
+		int * written, URI_CHAR c) {
+	if (*written >= maxChars) {
+		return URI_FALSE;
+	}
+	buffer[*written] = c;
+	(*written)++;
+	return URI_TRUE;
+}
+
+
+
+/*
+ * Checks that <next> follows <walker> with only <slashCount> slashes
+ * and <separator> in between.  Comparing pointers first ensures that
+ * the characters inspected lie within the same text.
+ */
+static UriBool URI_FUNC(IsAdjacent)(const URI_CHAR * walker, int slashCount,
+		URI_CHAR separator, const URI_CHAR * next) {
+	int i;
+	if (next != walker + slashCount + 1) {
+		return URI_FALSE;
+	}
+	for (i = 0; i < slashCount; i++) {
+		if (walker[i] != _UT('/')) {
+			return URI_FALSE;
+		}
+	}
+	return (walker[slashCount] == separator) ? URI_TRUE : URI_FALSE;
+}
+
+
+
+/*
+ * Tries to reference host and request-target in the text that the URI
+ * was parsed from.  That text is only guaranteed to be around for
+ * non-owner URIs, and even then components need to be adjacent,
+ * e.g. uriAddBaseUriA may combine ranges of two different strings.
+ * Empty path segments do not point into the text, so their slashes
+ * can only be checked once followed by a non-empty segment,
+ * a query or a fragment.
+ */
+static UriBool URI_FUNC(OriginFormInPlace)(const URI_TYPE(Uri) * uri,
+		UriBool ipLiteral, URI_TYPE(TextRange) * requestTarget,
+		URI_TYPE(TextRange) * host) {
+	const URI_CHAR * hostFirst;
+	const URI_CHAR * walker;
+	const URI_TYPE(PathSegment) * segment;
+	int pendingSlashes = 0;
+
+	if (uri->owner) {
+		return URI_FALSE;
+	}
+
+	hostFirst = ipLiteral ? uri->hostText.first - 1 : uri->hostText.first;
+	walker = ipLiteral ? uri->hostText.afterLast + 1 : uri->hostText.afterLast;
+	if (uri->portText.first != NULL) {
+		if (!URI_FUNC(IsAdjacent)(walker, 0, _UT(':'), uri->portText.first)) {
+			return URI_FALSE;
+		}
+		walker = uri->portText.afterLast;
+	}
+	host->first = hostFirst;
+	host->afterLast = walker;
+
+	/* "http://example.org" and "http://example.org/" */
+	if ((uri->query.first == NULL) && ((uri->pathHead == NULL)
+			|| ((uri->pathHead->next == NULL)
+				&& (uri->pathHead->text.first == uri->pathHead->text.afterLast)))) {
+		requestTarget->first = URI_FUNC(RootPath);
+		requestTarget->afterLast = URI_FUNC(RootPath) + 1;
+		return URI_TRUE;
+	}
+	if (uri->pathHead == NULL) {
+		return URI_FALSE; /* "?query" needs a leading slash */
+	}
+
+	requestTarget->first = walker;
+	for (segment = uri->pathHead; segment != NULL; segment = segment->next) {
+		if (segment->text.first == segment->text.afterLast) {
+			pendingSlashes++;
+			continue;
+		}
+		if (!URI_FUNC(IsAdjacent)(walker, pendingSlashes, _UT('/'),
+				segment->text.first)) {
+			return URI_FALSE;
+		}
+		pendingSlashes = 0;
+		walker = segment->text.afterLast;
+	}
+
+	if (uri->query.first != NULL) {
+		if (!URI_FUNC(IsAdjacent)(walker, pendingSlashes, _UT('?'),
+				uri->query.first)) {
+			return URI_FALSE;
+		}
+		walker = uri->query.afterLast;
+	} else if (pendingSlashes > 0) {
+		if ((uri->fragment.first == NULL)
+				|| !URI_FUNC(IsAdjacent)(walker, pendingSlashes, _UT('#'),
+					uri->fragment.first)) {
+			return URI_FALSE;
+		}
+		walker += pendingSlashes;
+	}
+	requestTarget->afterLast = walker;
+	return URI_TRUE;
+}
+
+
+
+int URI_FUNC(ToOriginForm)(const URI_TYPE(Uri) * uri,
+		URI_TYPE(TextRange) * requestTarget, URI_TYPE(TextRange) * host,
+		URI_CHAR * buffer, int maxChars, int * charsWritten) {
+	const URI_TYPE(PathSegment) * segment;
+	UriBool ipLiteral;
+	int written = 0;
+
+	if (charsWritten != NULL) {
+		*charsWritten = 0;
+	}
+
+	/* Check params */
+	if ((uri == NULL) || (requestTarget == NULL) || (host == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (uri->hostText.first == NULL) {
+		return URI_ERROR_TOORIGINFORM_HOST_NOT_SET;
+	}
+	if ((buffer == NULL) || (maxChars < 0)) {
+		maxChars = 0;
+	}
+
+	ipLiteral = ((uri->hostData.ip6 != NULL)
+			|| (uri->hostData.ipFuture.first != NULL)) ? URI_TRUE : URI_FALSE;
+
+	if (URI_FUNC(OriginFormInPlace)(uri, ipLiteral, requestTarget, host)) {
+		return URI_SUCCESS;
+	}
+
+	/* Host */
+	if ((ipLiteral && !URI_FUNC(AppendChar)(buffer, maxChars, &written, _UT('[')))
+			|| !URI_FUNC(AppendRange)(buffer, maxChars, &written,
+				uri->hostText.first, uri->hostText.afterLast)
+			|| (ipLiteral && !URI_FUNC(AppendChar)(buffer, maxChars, &written, _UT(']')))) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	if (uri->portText.first != NULL) {
+		if (!URI_FUNC(AppendChar)(buffer, maxChars, &written, _UT(':'))
+				|| !URI_FUNC(AppendRange)(buffer, maxChars, &written,
+					uri->portText.first, uri->portText.afterLast)) {
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+	}
+	host->first = buffer;
+	host->afterLast = buffer + written;
+
+	/* Request-target */
+	requestTarget->first = buffer + written;
+	if (uri->pathHead == NULL) {
+		if (!URI_FUNC(AppendChar)(buffer, maxChars, &written, _UT('/'))) {
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+	}
+	for (segment = uri->pathHead; segment != NULL; segment = segment->next) {
+		if (!URI_FUNC(AppendChar)(buffer, maxChars, &written, _UT('/'))
+				|| !URI_FUNC(AppendRange)(buffer, maxChars, &written,
+					segment->text.first, segment->text.afterLast)) {
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+	}
+	if (uri->query.first != NULL) {
+		if (!URI_FUNC(AppendChar)(buffer, maxChars, &written, _UT('?'))
+				|| !URI_FUNC(AppendRange)(buffer, maxChars, &written,
+					uri->query.first, uri->query.afterLast)) {
+			return URI_ERROR_OUTPUT_TOO_LARGE;
+		}
+	}
+	requestTarget->afterLast = buffer + written;
+
+	if (charsWritten != NULL) {
+		*charsWritten = written;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+#endif
@@ -40,13 +40,19 @@
 /**
  * @file UriParse.c
  * Holds the RFC 3986 %URI parsing implementation.
- * NOTE: This source file includes itself twice.
+ * NOTE: This source file includes itself once per encoding.
  */
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriParse.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriParse.c"
@@ -60,9 +66,11 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -183,6 +191,7 @@ static const URI_CHAR * URI_FUNC(ParseQueryFrag)(URI_TYPE(ParserState) * state,
 static const URI_CHAR * URI_FUNC(ParseSegment)(URI_TYPE(ParserState) * state, const URI_CHAR * first, const URI_CHAR * afterLast, UriMemoryManager * memory);
 static const URI_CHAR * URI_FUNC(ParseSegmentNz)(URI_TYPE(ParserState) * state, const URI_CHAR * first, const URI_CHAR * afterLast, UriMemoryManager * memory);
 static const URI_CHAR * URI_FUNC(ParseSegmentNzNcOrScheme2)(URI_TYPE(ParserState) * state, const URI_CHAR * first, const URI_CHAR * afterLast, UriMemoryManager * memory);
+static UriBool URI_FUNC(ParseUriFast)(URI_TYPE(ParserState) * state, const URI_CHAR * first, const URI_CHAR * afterLast, UriMemoryManager * memory);
 static const URI_CHAR * URI_FUNC(ParseUriReference)(URI_TYPE(ParserState) * state, const URI_CHAR * first, const URI_CHAR * afterLast, UriMemoryManager * memory);
 static const URI_CHAR * URI_FUNC(ParseUriTail)(URI_TYPE(ParserState) * state, const URI_CHAR * first, const URI_CHAR * afterLast, UriMemoryManager * memory);
 static const URI_CHAR * URI_FUNC(ParseUriTailTwo)(URI_TYPE(ParserState) * state, const URI_CHAR * first, const URI_CHAR * afterLast, UriMemoryManager * memory);
@@ -193,6 +202,8 @@ static UriBool URI_FUNC(OnExitOwnHostUserInfo)(URI_TYPE(ParserState) * state, co
 static UriBool URI_FUNC(OnExitOwnPortUserInfo)(URI_TYPE(ParserState) * state, const URI_CHAR * first, UriMemoryManager * memory);
 static UriBool URI_FUNC(OnExitSegmentNzNcOrScheme2)(URI_TYPE(ParserState) * state, const URI_CHAR * first, UriMemoryManager * memory);
 static void URI_FUNC(OnExitPartHelperTwo)(URI_TYPE(ParserState) * state);
+static void URI_FUNC(OnExitPort)(URI_TYPE(ParserState) * state);
+static void URI_FUNC(OnExitScheme)(URI_TYPE(ParserState) * state);
 
 static void URI_FUNC(ResetParserStateExceptUri)(URI_TYPE(ParserState) * state);
 
@@ -203,7 +214,17 @@ static UriBool URI_FUNC(PushPathSegment)(URI_TYPE(ParserState) * state,
 static void URI_FUNC(StopSyntax)(URI_TYPE(ParserState) * state, const URI_CHAR * errorPos, UriMemoryManager * memory);
 static void URI_FUNC(StopMalloc)(URI_TYPE(ParserState) * state, UriMemoryManager * memory);
 
+static const URI_CHAR * URI_FUNC(ParseIriChar)(URI_TYPE(ParserState) * state,
+		const URI_CHAR * first, const URI_CHAR * afterLast);
+
 static int URI_FUNC(ParseUriExMm)(URI_TYPE(ParserState) * state,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		UriParseInfo * info, UriBool iri, UriMemoryManager * memory);
+static int URI_FUNC(ParseSingleMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriParseInfo * info, UriBool iri,
+		UriMemoryManager * memory);
+static int URI_FUNC(ParseUriFull)(URI_TYPE(ParserState) * state,
 		const URI_CHAR * first, const URI_CHAR * afterLast,
 		UriMemoryManager * memory);
 
@@ -226,6 +247,33 @@ static URI_INLINE void URI_FUNC(StopMalloc)(URI_TYPE(ParserState) * state, UriMe
 
 
 
+/*
+ * [ucschar] and, inside the query, [iprivate] of RFC 3987 when parsing
+ * an IRI; returns the position after the character or NULL otherwise.
+ */
+static URI_INLINE const URI_CHAR * URI_FUNC(ParseIriChar)(
+		URI_TYPE(ParserState) * state, const URI_CHAR * first,
+		const URI_CHAR * afterLast) {
+	const UriParserExtras * const extras
+			= (const UriParserExtras *)state->reserved;
+	const URI_CHAR * afterIriChar;
+	unsigned long codePoint;
+
+	if ((extras == NULL) || !extras->iri) {
+		return NULL;
+	}
+
+	afterIriChar = URI_FUNC(DecodeCodePoint)(first, afterLast, &codePoint);
+	if ((afterIriChar == NULL)
+			|| !(uriIsIriUcsChar(codePoint)
+				|| (extras->inQuery && uriIsIriPrivate(codePoint)))) {
+		return NULL;
+	}
+	return afterIriChar;
+}
+
+
+
 /*
  * [authority]-><[>[ipLit2][authorityTwo]
  * [authority]->[ownHostUserInfoNz]
@@ -277,6 +325,14 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParseAuthority)(
 		return URI_FUNC(ParseOwnHostUserInfoNz)(state, first, afterLast, memory);
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				state->uri->userInfo.first = first; /* USERINFO BEGIN */
+				return URI_FUNC(ParseOwnHostUserInfoNz)(state, first, afterLast, memory);
+			}
+		}
 		/* "" regname host */
 		state->uri->hostText.first = URI_FUNC(SafeToPointTo);
 		state->uri->hostText.afterLast = URI_FUNC(SafeToPointTo);
@@ -304,6 +360,7 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParseAuthorityTwo)(URI_TYPE(ParserSt
 			}
 			state->uri->portText.first = first + 1; /* PORT BEGIN */
 			state->uri->portText.afterLast = afterPort; /* PORT END */
+			URI_FUNC(OnExitPort)(state);
 			return afterPort;
 		}
 
@@ -373,6 +430,13 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParseHierPart)(
 		return URI_FUNC(ParsePartHelperTwo)(state, first + 1, afterLast, memory);
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParsePathRootless)(state, first, afterLast, memory);
+			}
+		}
 		return first;
 	}
 }
@@ -887,6 +951,7 @@ static const URI_CHAR * URI_FUNC(ParseIPv6address2)(
  * [mustBeSegmentNzNc]->[uriTail] // can take <NULL>
  * [mustBeSegmentNzNc]-></>[segment][zeroMoreSlashSegs][uriTail]
  * [mustBeSegmentNzNc]-><@>[mustBeSegmentNzNc]
+ * [mustBeSegmentNzNc]->[ucschar][mustBeSegmentNzNc] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseMustBeSegmentNzNc)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
@@ -957,6 +1022,13 @@ static const URI_CHAR * URI_FUNC(ParseMustBeSegmentNzNc)(
 		}
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseMustBeSegmentNzNc)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		if (!URI_FUNC(PushPathSegment)(state, state->uri->scheme.first, first, memory)) { /* SEGMENT BOTH */
 			URI_FUNC(StopMalloc)(state, memory);
 			return NULL;
@@ -1023,6 +1095,7 @@ static URI_INLINE UriBool URI_FUNC(OnExitOwnHost2)(
 /*
  * [ownHost2]->[authorityTwo] // can take <NULL>
  * [ownHost2]->[pctSubUnres][ownHost2]
+ * [ownHost2]->[ucschar][ownHost2] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseOwnHost2)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
@@ -1064,6 +1137,13 @@ static const URI_CHAR * URI_FUNC(ParseOwnHost2)(
 		}
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseOwnHost2)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		if (!URI_FUNC(OnExitOwnHost2)(state, first, memory)) {
 			URI_FUNC(StopMalloc)(state, memory);
 			return NULL;
@@ -1136,6 +1216,13 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParseOwnHostUserInfo)(
 		return URI_FUNC(ParseOwnHostUserInfoNz)(state, first, afterLast, memory);
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseOwnHostUserInfoNz)(state, first, afterLast, memory);
+			}
+		}
 		if (!URI_FUNC(OnExitOwnHostUserInfo)(state, first, memory)) {
 			URI_FUNC(StopMalloc)(state, memory);
 			return NULL;
@@ -1150,6 +1237,7 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParseOwnHostUserInfo)(
  * [ownHostUserInfoNz]->[pctSubUnres][ownHostUserInfo]
  * [ownHostUserInfoNz]-><:>[ownPortUserInfo]
  * [ownHostUserInfoNz]-><@>[ownHost]
+ * [ownHostUserInfoNz]->[ucschar][ownHostUserInfo] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseOwnHostUserInfoNz)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
@@ -1198,6 +1286,13 @@ static const URI_CHAR * URI_FUNC(ParseOwnHostUserInfoNz)(
 		return URI_FUNC(ParseOwnHost)(state, first + 1, afterLast, memory);
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseOwnHostUserInfo)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		URI_FUNC(StopSyntax)(state, first, memory);
 		return NULL;
 	}
@@ -1211,6 +1306,7 @@ static URI_INLINE UriBool URI_FUNC(OnExitOwnPortUserInfo)(
 	state->uri->hostText.first = state->uri->userInfo.first; /* Host instead of userInfo, update */
 	state->uri->userInfo.first = NULL; /* Not a userInfo, reset */
 	state->uri->portText.afterLast = first; /* PORT END */
+	URI_FUNC(OnExitPort)(state);
 
 	/* Valid IPv4 or just a regname? */
 	state->uri->hostData.ip4 = memory->malloc(memory, 1 * sizeof(UriIp4)); /* Freed when stopping on parse error */
@@ -1240,6 +1336,7 @@ static URI_INLINE UriBool URI_FUNC(OnExitOwnPortUserInfo)(
  * [ownPortUserInfo]-><:>[ownUserInfo]
  * [ownPortUserInfo]-><@>[ownHost]
  * [ownPortUserInfo]-><NULL>
+ * [ownPortUserInfo]->[ucschar][ownUserInfo] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseOwnPortUserInfo)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
@@ -1300,6 +1397,15 @@ static const URI_CHAR * URI_FUNC(ParseOwnPortUserInfo)(
 		return URI_FUNC(ParseOwnHost)(state, first + 1, afterLast, memory);
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				state->uri->hostText.afterLast = NULL; /* Not a host, reset */
+				state->uri->portText.first = NULL; /* Not a port, reset */
+				return URI_FUNC(ParseOwnUserInfo)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		if (!URI_FUNC(OnExitOwnPortUserInfo)(state, first, memory)) {
 			URI_FUNC(StopMalloc)(state, memory);
 			return NULL;
@@ -1314,6 +1420,7 @@ static const URI_CHAR * URI_FUNC(ParseOwnPortUserInfo)(
  * [ownUserInfo]->[pctSubUnres][ownUserInfo]
  * [ownUserInfo]-><:>[ownUserInfo]
  * [ownUserInfo]-><@>[ownHost]
+ * [ownUserInfo]->[ucschar][ownUserInfo] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseOwnUserInfo)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
@@ -1361,6 +1468,13 @@ static const URI_CHAR * URI_FUNC(ParseOwnUserInfo)(
 		return URI_FUNC(ParseOwnHost)(state, first + 1, afterLast, memory);
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseOwnUserInfo)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		URI_FUNC(StopSyntax)(state, first, memory);
 		return NULL;
 	}
@@ -1489,6 +1603,22 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParsePathAbsNoLeadSlash)(
 		}
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				const URI_CHAR * const afterSegmentNz
+						= URI_FUNC(ParseSegment)(state, afterIriChar, afterLast, memory);
+				if (afterSegmentNz == NULL) {
+					return NULL;
+				}
+				if (!URI_FUNC(PushPathSegment)(state, first, afterSegmentNz, memory)) { /* SEGMENT BOTH */
+					URI_FUNC(StopMalloc)(state, memory);
+					return NULL;
+				}
+				return URI_FUNC(ParseZeroMoreSlashSegs)(state, afterSegmentNz, afterLast, memory);
+			}
+		}
 		return first;
 	}
 }
@@ -1522,6 +1652,7 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParsePathRootless)(
  * [pchar]->[unreserved]
  * [pchar]-><:>
  * [pchar]-><@>
+ * [pchar]->[ucschar] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParsePchar)(URI_TYPE(ParserState) * state,
 		const URI_CHAR * first, const URI_CHAR * afterLast,
@@ -1557,6 +1688,13 @@ static const URI_CHAR * URI_FUNC(ParsePchar)(URI_TYPE(ParserState) * state,
 		return first + 1;
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return afterIriChar;
+			}
+		}
 		URI_FUNC(StopSyntax)(state, first, memory);
 		return NULL;
 	}
@@ -1689,6 +1827,8 @@ static const URI_CHAR * URI_FUNC(ParsePort)(URI_TYPE(ParserState) * state, const
  * [queryFrag]-></>[queryFrag]
  * [queryFrag]-><?>[queryFrag]
  * [queryFrag]-><NULL>
+ * [queryFrag]->[ucschar][queryFrag] // IRI mode only
+ * [queryFrag]->[iprivate][queryFrag] // IRI mode only, query only
  */
 static const URI_CHAR * URI_FUNC(ParseQueryFrag)(URI_TYPE(ParserState) * state,
 		const URI_CHAR * first, const URI_CHAR * afterLast,
@@ -1732,6 +1872,13 @@ static const URI_CHAR * URI_FUNC(ParseQueryFrag)(URI_TYPE(ParserState) * state,
 		return URI_FUNC(ParseQueryFrag)(state, first + 1, afterLast, memory);
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseQueryFrag)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		return first;
 	}
 }
@@ -1741,6 +1888,7 @@ static const URI_CHAR * URI_FUNC(ParseQueryFrag)(URI_TYPE(ParserState) * state,
 /*
  * [segment]->[pchar][segment]
  * [segment]-><NULL>
+ * [segment]->[ucschar][segment] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseSegment)(URI_TYPE(ParserState) * state,
 		const URI_CHAR * first, const URI_CHAR * afterLast,
@@ -1780,6 +1928,13 @@ static const URI_CHAR * URI_FUNC(ParseSegment)(URI_TYPE(ParserState) * state,
 		}
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseSegment)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		return first;
 	}
 }
@@ -1803,6 +1958,31 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParseSegmentNz)(
 
 
 
+static URI_INLINE void URI_FUNC(OnExitPort)(URI_TYPE(ParserState) * state) {
+	const UriParserExtras * const extras
+			= (const UriParserExtras *)state->reserved;
+	if ((extras != NULL) && (extras->info != NULL)) {
+		UriParseInfo * const info = extras->info;
+		info->portOverflow = (URI_FUNC(ParsePortValue)(&info->port,
+				state->uri->portText.first, state->uri->portText.afterLast)
+				== URI_ERROR_PORT_OUT_OF_RANGE) ? URI_TRUE : URI_FALSE;
+	}
+}
+
+
+
+static URI_INLINE void URI_FUNC(OnExitScheme)(URI_TYPE(ParserState) * state) {
+	const UriParserExtras * const extras
+			= (const UriParserExtras *)state->reserved;
+	if ((extras != NULL) && (extras->info != NULL)) {
+		UriParseInfo * const info = extras->info;
+		info->scheme = URI_FUNC(IdentifyScheme)(state->uri->scheme.first,
+				state->uri->scheme.afterLast);
+	}
+}
+
+
+
 static URI_INLINE UriBool URI_FUNC(OnExitSegmentNzNcOrScheme2)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
 		UriMemoryManager * memory) {
@@ -1838,6 +2018,7 @@ static URI_INLINE UriBool URI_FUNC(OnExitSegmentNzNcOrScheme2)(
  * [segmentNzNcOrScheme2]-><=>[mustBeSegmentNzNc]
  * [segmentNzNcOrScheme2]-><'>[mustBeSegmentNzNc]
  * [segmentNzNcOrScheme2]-><->[segmentNzNcOrScheme2]
+ * [segmentNzNcOrScheme2]->[ucschar][mustBeSegmentNzNc] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseSegmentNzNcOrScheme2)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
@@ -1916,10 +2097,18 @@ static const URI_CHAR * URI_FUNC(ParseSegmentNzNcOrScheme2)(
 			if (afterHierPart == NULL) {
 				return NULL;
 			}
+			URI_FUNC(OnExitScheme)(state);
 			return URI_FUNC(ParseUriTail)(state, afterHierPart, afterLast, memory);
 		}
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				return URI_FUNC(ParseMustBeSegmentNzNc)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		if (!URI_FUNC(OnExitSegmentNzNcOrScheme2)(state, first, memory)) {
 			URI_FUNC(StopMalloc)(state, memory);
 			return NULL;
@@ -1930,6 +2119,170 @@ static const URI_CHAR * URI_FUNC(ParseSegmentNzNcOrScheme2)(
 
 
 
+/*
+ * Skips characters of the given fast path class and valid pct-encoded
+ * octets, returns the first position that matches neither.
+ */
+static URI_INLINE const URI_CHAR * URI_FUNC(ScanFast)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, unsigned char mask) {
+	while (first < afterLast) {
+		if (URI_FAST_CHAR_IS(*first, mask)) {
+			first++;
+		} else if ((*first == _UT('%'))
+				&& (afterLast - first >= 3)
+				&& URI_FAST_CHAR_IS(first[1], URI_FAST_HEXDIG)
+				&& URI_FAST_CHAR_IS(first[2], URI_FAST_HEXDIG)) {
+			first += 3;
+		} else {
+			break;
+		}
+	}
+	return first;
+}
+
+
+
+/*
+ * Speculative fast path for the shape of most URIs in the wild:
+ *
+ *   scheme "://" reg-name [ ":" port ] path-abempty [ "?" query ] [ "#" fragment ]
+ *
+ * with a non-empty host made of ALPHA / DIGIT / "-" / "." / "_" / "~" only.
+ * A first pass validates and records offsets without touching the URI,
+ * so bailing out on anything unusual (user info, IP literals, sub-delims
+ * or percent-encoding in the host, syntax errors, ..) costs nothing.
+ * A second pass then produces exactly what [uriReference] would produce.
+ *
+ * Returns URI_FALSE if the full grammar needs to run, URI_TRUE otherwise,
+ * with the outcome in state->errorCode.
+ */
+static UriBool URI_FUNC(ParseUriFast)(URI_TYPE(ParserState) * state,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		UriMemoryManager * memory) {
+	URI_TYPE(Uri) * const uri = state->uri;
+	const URI_CHAR * walker = first;
+	const URI_CHAR * afterScheme;
+	const URI_CHAR * hostFirst;
+	const URI_CHAR * afterHost;
+	const URI_CHAR * portFirst = NULL;
+	const URI_CHAR * afterAuthority;
+	const URI_CHAR * afterPath;
+	const URI_CHAR * queryFirst = NULL;
+	const URI_CHAR * afterQuery = NULL;
+	const URI_CHAR * fragmentFirst = NULL;
+	UriBool digitsAndDotsOnly = URI_TRUE;
+
+	/* Scheme */
+	if ((walker >= afterLast) || !URI_FAST_CHAR_IS(*walker, URI_FAST_ALPHA)) {
+		return URI_FALSE;
+	}
+	do {
+		walker++;
+	} while ((walker < afterLast) && URI_FAST_CHAR_IS(*walker, URI_FAST_SCHEME));
+	afterScheme = walker;
+	if ((afterLast - walker < 3)
+			|| (walker[0] != _UT(':'))
+			|| (walker[1] != _UT('/'))
+			|| (walker[2] != _UT('/'))) {
+		return URI_FALSE;
+	}
+	walker += 3;
+
+	/* Host */
+	hostFirst = walker;
+	while ((walker < afterLast) && URI_FAST_CHAR_IS(*walker, URI_FAST_HOST)) {
+		if ((*walker != _UT('.')) && ((*walker < _UT('0')) || (*walker > _UT('9')))) {
+			digitsAndDotsOnly = URI_FALSE;
+		}
+		walker++;
+	}
+	afterHost = walker;
+	if (afterHost == hostFirst) {
+		return URI_FALSE;
+	}
+
+	/* Port */
+	if ((walker < afterLast) && (*walker == _UT(':'))) {
+		walker++;
+		portFirst = walker;
+		while ((walker < afterLast) && (*walker >= _UT('0')) && (*walker <= _UT('9'))) {
+			walker++;
+		}
+	}
+	afterAuthority = walker;
+
+	/* Path, query and fragment */
+	if ((walker < afterLast) && (*walker != _UT('/'))
+			&& (*walker != _UT('?')) && (*walker != _UT('#'))) {
+		return URI_FALSE;
+	}
+	afterPath = URI_FUNC(ScanFast)(walker, afterLast, URI_FAST_PATH);
+	walker = afterPath;
+	if ((walker < afterLast) && (*walker == _UT('?'))) {
+		queryFirst = walker + 1;
+		afterQuery = URI_FUNC(ScanFast)(queryFirst, afterLast, URI_FAST_QUERY);
+		walker = afterQuery;
+	}
+	if ((walker < afterLast) && (*walker == _UT('#'))) {
+		fragmentFirst = walker + 1;
+		walker = URI_FUNC(ScanFast)(fragmentFirst, afterLast, URI_FAST_QUERY);
+	}
+	if (walker != afterLast) {
+		return URI_FALSE;
+	}
+
+	/* Valid, now fill the URI */
+	uri->scheme.first = first; /* SCHEME BEGIN */
+	uri->scheme.afterLast = afterScheme; /* SCHEME END */
+	URI_FUNC(OnExitScheme)(state);
+	uri->hostText.first = hostFirst; /* HOST BEGIN */
+	uri->hostText.afterLast = afterHost; /* HOST END */
+	if (digitsAndDotsOnly) {
+		/* Valid IPv4 or just a regname? */
+		uri->hostData.ip4 = memory->malloc(memory, 1 * sizeof(UriIp4)); /* Freed when stopping on parse error */
+		if (uri->hostData.ip4 == NULL) {
+			URI_FUNC(StopMalloc)(state, memory);
+			return URI_TRUE;
+		}
+		if (URI_FUNC(ParseIpFourAddress)(uri->hostData.ip4->data,
+				hostFirst, afterHost)) {
+			/* Not IPv4 */
+			memory->free(memory, uri->hostData.ip4);
+			uri->hostData.ip4 = NULL;
+		}
+	}
+	if (portFirst != NULL) {
+		uri->portText.first = portFirst; /* PORT BEGIN */
+		uri->portText.afterLast = afterAuthority; /* PORT END */
+		URI_FUNC(OnExitPort)(state);
+	}
+
+	walker = afterAuthority;
+	while (walker < afterPath) {
+		const URI_CHAR * const segmentFirst = walker + 1;
+		walker = segmentFirst;
+		while ((walker < afterPath) && (*walker != _UT('/'))) {
+			walker++;
+		}
+		if (!URI_FUNC(PushPathSegment)(state, segmentFirst, walker, memory)) { /* SEGMENT BOTH */
+			URI_FUNC(StopMalloc)(state, memory);
+			return URI_TRUE;
+		}
+	}
+
+	if (queryFirst != NULL) {
+		uri->query.first = queryFirst; /* QUERY BEGIN */
+		uri->query.afterLast = afterQuery; /* QUERY END */
+	}
+	if (fragmentFirst != NULL) {
+		uri->fragment.first = fragmentFirst; /* FRAGMENT BEGIN */
+		uri->fragment.afterLast = afterLast; /* FRAGMENT END */
+	}
+	return URI_TRUE;
+}
+
+
+
 /*
  * [uriReference]->[ALPHA][segmentNzNcOrScheme2]
  * [uriReference]->[DIGIT][mustBeSegmentNzNc]
@@ -1942,6 +2295,7 @@ static const URI_CHAR * URI_FUNC(ParseSegmentNzNcOrScheme2)(
  * [uriReference]-><_>[mustBeSegmentNzNc]
  * [uriReference]-><~>[mustBeSegmentNzNc]
  * [uriReference]-><->[mustBeSegmentNzNc]
+ * [uriReference]->[ucschar][mustBeSegmentNzNc] // IRI mode only
  */
 static const URI_CHAR * URI_FUNC(ParseUriReference)(
 		URI_TYPE(ParserState) * state, const URI_CHAR * first,
@@ -1997,6 +2351,14 @@ static const URI_CHAR * URI_FUNC(ParseUriReference)(
 		}
 
 	default:
+		{
+			const URI_CHAR * const afterIriChar
+					= URI_FUNC(ParseIriChar)(state, first, afterLast);
+			if (afterIriChar != NULL) {
+				state->uri->scheme.first = first; /* SEGMENT BEGIN, ABUSE SCHEME POINTER */
+				return URI_FUNC(ParseMustBeSegmentNzNc)(state, afterIriChar, afterLast, memory);
+			}
+		}
 		return URI_FUNC(ParseUriTail)(state, first, afterLast, memory);
 	}
 }
@@ -2030,8 +2392,15 @@ static URI_INLINE const URI_CHAR * URI_FUNC(ParseUriTail)(
 
 	case _UT('?'):
 		{
-			const URI_CHAR * const afterQueryFrag
-					= URI_FUNC(ParseQueryFrag)(state, first + 1, afterLast, memory);
+			UriParserExtras * const extras = (UriParserExtras *)state->reserved;
+			const URI_CHAR * afterQueryFrag;
+			if (extras != NULL) {
+				extras->inQuery = URI_TRUE;
+			}
+			afterQueryFrag = URI_FUNC(ParseQueryFrag)(state, first + 1, afterLast, memory);
+			if (extras != NULL) {
+				extras->inQuery = URI_FALSE;
+			}
 			if (afterQueryFrag == NULL) {
 				return NULL;
 			}
@@ -2152,16 +2521,16 @@ static URI_INLINE UriBool URI_FUNC(PushPathSegment)(
 
 int URI_FUNC(ParseUriEx)(URI_TYPE(ParserState) * state,
 		const URI_CHAR * first, const URI_CHAR * afterLast) {
-	return URI_FUNC(ParseUriExMm)(state, first, afterLast, NULL);
+	return URI_FUNC(ParseUriExMm)(state, first, afterLast, NULL, URI_FALSE,
+			NULL);
 }
 
 
 
 static int URI_FUNC(ParseUriExMm)(URI_TYPE(ParserState) * state,
 		const URI_CHAR * first, const URI_CHAR * afterLast,
-		UriMemoryManager * memory) {
-	const URI_CHAR * afterUriReference;
-	URI_TYPE(Uri) * uri;
+		UriParseInfo * info, UriBool iri, UriMemoryManager * memory) {
+	UriParserExtras extras;
 
 	/* Check params */
 	if ((state == NULL) || (first == NULL) || (afterLast == NULL)) {
@@ -2169,14 +2538,39 @@ static int URI_FUNC(ParseUriExMm)(URI_TYPE(ParserState) * state,
 	}
 	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
 
-	uri = state->uri;
-
 	/* Init parser */
 	URI_FUNC(ResetParserStateExceptUri)(state);
-	URI_FUNC(ResetUri)(uri);
+	URI_FUNC(ResetUri)(state->uri);
+	if ((info != NULL) || iri) {
+		if (info != NULL) {
+			memset(info, 0, sizeof(UriParseInfo));
+		}
+		extras.info = info;
+		extras.iri = iri;
+		extras.inQuery = URI_FALSE;
+		state->reserved = &extras; /* Read by the OnExit* hooks and ParseIriChar */
+	}
+
+	/* Parse; non-ASCII always leaves the fast path */
+	if (!URI_FUNC(ParseUriFast)(state, first, afterLast, memory)) {
+		URI_FUNC(ParseUriFull)(state, first, afterLast, memory);
+	}
+	state->reserved = NULL;
+
+	/* Component flags are a post-pass, only paid for when asked for */
+	if ((info != NULL) && (state->errorCode == URI_SUCCESS)) {
+		URI_FUNC(CollectComponentFlags)(state->uri, info);
+	}
+	return state->errorCode;
+}
+
 
-	/* Parse */
-	afterUriReference = URI_FUNC(ParseUriReference)(state, first, afterLast, memory);
+
+static int URI_FUNC(ParseUriFull)(URI_TYPE(ParserState) * state,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		UriMemoryManager * memory) {
+	const URI_CHAR * const afterUriReference
+			= URI_FUNC(ParseUriReference)(state, first, afterLast, memory);
 	if (afterUriReference == NULL) {
 		/* Waterproof errorPos <= afterLast */
 		if (state->errorPos && (state->errorPos > afterLast)) {
@@ -2227,6 +2621,58 @@ int URI_FUNC(ParseSingleUriEx)(URI_TYPE(Uri) * uri,
 int URI_FUNC(ParseSingleUriExMm)(URI_TYPE(Uri) * uri,
 		const URI_CHAR * first, const URI_CHAR * afterLast,
 		const URI_CHAR ** errorPos, UriMemoryManager * memory) {
+	return URI_FUNC(ParseSingleUriInfoExMm)(uri, first, afterLast, errorPos,
+			NULL, memory);
+}
+
+
+
+int URI_FUNC(ParseSingleUriInfoEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriParseInfo * info) {
+	if ((afterLast == NULL) && (first != NULL)) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	return URI_FUNC(ParseSingleUriInfoExMm)(uri, first, afterLast, errorPos,
+			info, NULL);
+}
+
+
+
+int URI_FUNC(ParseSingleUriInfoExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriParseInfo * info,
+		UriMemoryManager * memory) {
+	return URI_FUNC(ParseSingleMm)(uri, first, afterLast, errorPos, info,
+			URI_FALSE, memory);
+}
+
+
+
+int URI_FUNC(ParseSingleIriEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos) {
+	if ((afterLast == NULL) && (first != NULL)) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	return URI_FUNC(ParseSingleIriExMm)(uri, first, afterLast, errorPos, NULL);
+}
+
+
+
+int URI_FUNC(ParseSingleIriExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory) {
+	return URI_FUNC(ParseSingleMm)(uri, first, afterLast, errorPos, NULL,
+			URI_TRUE, memory);
+}
+
+
+
+static int URI_FUNC(ParseSingleMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriParseInfo * info, UriBool iri,
+		UriMemoryManager * memory) {
 	URI_TYPE(ParserState) state;
 	int res;
 
@@ -2238,7 +2684,7 @@ int URI_FUNC(ParseSingleUriExMm)(URI_TYPE(Uri) * uri,
 
 	state.uri = uri;
 
-	res = URI_FUNC(ParseUriExMm)(&state, first, afterLast, memory);
+	res = URI_FUNC(ParseUriExMm)(&state, first, afterLast, info, iri, memory);
 
 	if (res != URI_SUCCESS) {
 		if (errorPos != NULL) {
@@ -2252,6 +2698,209 @@ int URI_FUNC(ParseSingleUriExMm)(URI_TYPE(Uri) * uri,
 
 
 
+int URI_FUNC(ParseOriginFormEx)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos) {
+	if ((afterLast == NULL) && (first != NULL)) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	return URI_FUNC(ParseOriginFormExMm)(uri, first, afterLast, errorPos, NULL);
+}
+
+
+
+/*
+ * origin-form   = absolute-path [ "?" query ]
+ * absolute-path = 1*( "/" segment )
+ * asterisk-form = "*"
+ */
+int URI_FUNC(ParseOriginFormExMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory) {
+	URI_TYPE(ParserState) state;
+	const URI_CHAR * afterPath;
+	const URI_CHAR * walker;
+
+	/* Check params */
+	if ((uri == NULL) || (first == NULL) || (afterLast == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	state.uri = uri;
+	URI_FUNC(ResetParserStateExceptUri)(&state);
+	URI_FUNC(ResetUri)(uri);
+
+	/* Asterisk-form */
+	if ((afterLast - first == 1) && (first[0] == _UT('*'))) {
+		if (!URI_FUNC(PushPathSegment)(&state, first, afterLast, memory)) { /* SEGMENT BOTH */
+			URI_FUNC(StopMalloc)(&state, memory);
+			return state.errorCode;
+		}
+		return URI_SUCCESS;
+	}
+
+	/* Validate origin-form before touching the URI */
+	if ((first >= afterLast) || (first[0] != _UT('/'))) {
+		if (errorPos != NULL) {
+			*errorPos = first;
+		}
+		return URI_ERROR_SYNTAX;
+	}
+	afterPath = URI_FUNC(ScanFast)(first + 1, afterLast, URI_FAST_PATH);
+	walker = afterPath;
+	if ((walker < afterLast) && (walker[0] == _UT('?'))) {
+		walker = URI_FUNC(ScanFast)(walker + 1, afterLast, URI_FAST_QUERY);
+	}
+	if (walker != afterLast) {
+		if (errorPos != NULL) {
+			*errorPos = walker;
+		}
+		return URI_ERROR_SYNTAX;
+	}
+
+	/* Fill the URI */
+	uri->absolutePath = URI_TRUE;
+	if (afterPath > first + 1) {
+		walker = first;
+		while (walker < afterPath) {
+			const URI_CHAR * const segmentFirst = walker + 1;
+			walker = segmentFirst;
+			while ((walker < afterPath) && (walker[0] != _UT('/'))) {
+				walker++;
+			}
+			if (!URI_FUNC(PushPathSegment)(&state, segmentFirst, walker, memory)) { /* SEGMENT BOTH */
+				URI_FUNC(StopMalloc)(&state, memory);
+				return state.errorCode;
+			}
+		}
+	}
+	if (afterPath < afterLast) {
+		uri->query.first = afterPath + 1; /* QUERY BEGIN */
+		uri->query.afterLast = afterLast; /* QUERY END */
+	}
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(ParseAuthorityEx)(URI_TYPE(Authority) * authority,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos) {
+	if ((afterLast == NULL) && (first != NULL)) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	return URI_FUNC(ParseAuthorityExMm)(authority, first, afterLast, errorPos, NULL);
+}
+
+
+
+int URI_FUNC(ParseAuthorityExMm)(URI_TYPE(Authority) * authority,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory) {
+	URI_TYPE(ParserState) state;
+	URI_TYPE(Uri) uri;
+	UriScratchMemoryManager scratch;
+	const URI_CHAR * afterAuthority;
+
+	/* Check params */
+	if ((authority == NULL) || (first == NULL) || (afterLast == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	/* Host data goes to scratch storage rather than the heap */
+	uriInitScratchMemoryManager(&scratch, memory);
+	memory = &scratch.manager;
+
+	state.uri = &uri;
+	URI_FUNC(ResetParserStateExceptUri)(&state);
+	URI_FUNC(ResetUri)(&uri);
+
+	afterAuthority = URI_FUNC(ParseAuthority)(&state, first, afterLast, memory);
+	if (afterAuthority == NULL) {
+		/* Failed, host data freed by parser */
+		if ((state.errorCode == URI_ERROR_SYNTAX) && (errorPos != NULL)) {
+			*errorPos = state.errorPos;
+		}
+		return state.errorCode;
+	}
+	if (afterAuthority != afterLast) {
+		/* Path, query or fragment following */
+		URI_FUNC(FreeUriMembersMm)(&uri, memory);
+		if (errorPos != NULL) {
+			*errorPos = afterAuthority;
+		}
+		return URI_ERROR_SYNTAX;
+	}
+
+	memset(authority, 0, sizeof(URI_TYPE(Authority)));
+	authority->userInfo = uri.userInfo;
+	if (uri.hostText.first == URI_FUNC(SafeToPointTo)) {
+		/* Empty input, keep pointing into it */
+		authority->hostText.first = first;
+		authority->hostText.afterLast = first;
+	} else {
+		authority->hostText = uri.hostText;
+	}
+	authority->portText = uri.portText;
+	if (uri.hostData.ip4 != NULL) {
+		authority->hostType = URI_HOST_TYPE_IP4;
+		authority->ip4 = *uri.hostData.ip4;
+	} else if (uri.hostData.ip6 != NULL) {
+		authority->hostType = URI_HOST_TYPE_IP6;
+		authority->ip6 = *uri.hostData.ip6;
+	} else if (uri.hostData.ipFuture.first != NULL) {
+		authority->hostType = URI_HOST_TYPE_IPFUTURE;
+	} else {
+		authority->hostType = URI_HOST_TYPE_REGNAME;
+	}
+
+	URI_FUNC(FreeUriMembersMm)(&uri, memory);
+	return URI_SUCCESS;
+}
+
+
+
+/*
+ * Parses text as if preceded by "//", i.e. as the part of a network-path
+ * reference after the two slashes.  Used by uriFindUriA for "www."
+ * candidates.  Expects a complete memory manager.
+ */
+int URI_FUNC(ParseNetworkPathMm)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos, UriMemoryManager * memory) {
+	URI_TYPE(ParserState) state;
+	const URI_CHAR * walker;
+
+	state.uri = uri;
+	URI_FUNC(ResetParserStateExceptUri)(&state);
+	URI_FUNC(ResetUri)(uri);
+
+	walker = URI_FUNC(ParseAuthority)(&state, first, afterLast, memory);
+	if (walker != NULL) {
+		walker = URI_FUNC(ParsePathAbsEmpty)(&state, walker, afterLast, memory);
+	}
+	if (walker != NULL) {
+		URI_FUNC(FixEmptyTrailSegment)(uri, memory);
+		walker = URI_FUNC(ParseUriTail)(&state, walker, afterLast, memory);
+	}
+	if ((walker != NULL) && (walker != afterLast)) {
+		URI_FUNC(StopSyntax)(&state, walker, memory);
+		walker = NULL;
+	}
+	if (walker == NULL) {
+		if ((state.errorCode == URI_ERROR_SYNTAX) && (errorPos != NULL)) {
+			/* Waterproof errorPos <= afterLast */
+			*errorPos = (state.errorPos > afterLast) ? afterLast : state.errorPos;
+		}
+		return state.errorCode;
+	}
+	return URI_SUCCESS;
+}
+
+
+
 void URI_FUNC(FreeUriMembers)(URI_TYPE(Uri) * uri) {
 	URI_FUNC(FreeUriMembersMm)(uri, NULL);
 }
@@ -2375,6 +3024,46 @@ UriBool URI_FUNC(_TESTING_ONLY_ParseIpSix)(const URI_CHAR * text) {
 
 
 
+/* Like uriParseSingleUriEx but with the fast path only */
+UriBool URI_FUNC(_TESTING_ONLY_ParseUriFast)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast) {
+	UriMemoryManager * const memory = &defaultMemoryManager;
+	URI_TYPE(ParserState) state;
+
+	state.uri = uri;
+	URI_FUNC(ResetParserStateExceptUri)(&state);
+	URI_FUNC(ResetUri)(uri);
+	if (!URI_FUNC(ParseUriFast)(&state, first, afterLast, memory)) {
+		return URI_FALSE;
+	}
+	return (state.errorCode == URI_SUCCESS) ? URI_TRUE : URI_FALSE;
+}
+
+
+
+/* Like uriParseSingleUriEx but bypassing the fast path */
+int URI_FUNC(_TESTING_ONLY_ParseUriFull)(URI_TYPE(Uri) * uri,
+		const URI_CHAR * first, const URI_CHAR * afterLast,
+		const URI_CHAR ** errorPos) {
+	UriMemoryManager * const memory = &defaultMemoryManager;
+	URI_TYPE(ParserState) state;
+	int res;
+
+	state.uri = uri;
+	URI_FUNC(ResetParserStateExceptUri)(&state);
+	URI_FUNC(ResetUri)(uri);
+	res = URI_FUNC(ParseUriFull)(&state, first, afterLast, memory);
+	if (res != URI_SUCCESS) {
+		if (errorPos != NULL) {
+			*errorPos = state.errorPos;
+		}
+		URI_FUNC(FreeUriMembersMm)(uri, memory);
+	}
+	return res;
+}
+
+
+
 UriBool URI_FUNC(_TESTING_ONLY_ParseIpFour)(const URI_CHAR * text) {
 	unsigned char octets[4];
 	int res = URI_FUNC(ParseIpFourAddress)(octets, text, text + URI_STRLEN(text));
@@ -43,6 +43,27 @@
 
 
 
+const unsigned char uriFastCharClass[128] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0x00: .. .. .. .. .. .. .. .. */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0x08: .. .. .. .. .. .. .. .. */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0x10: .. .. .. .. .. .. .. .. */
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  /* 0x18: .. .. .. .. .. .. .. .. */
+	0x00, 0x0c, 0x00, 0x00, 0x0c, 0x00, 0x0c, 0x0c,  /* 0x20: .. ! " # $ % & ' */
+	0x0c, 0x0c, 0x0c, 0x0d, 0x0c, 0x0f, 0x0f, 0x0c,  /* 0x28: ( ) * + , - . / */
+	0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f,  /* 0x30: 0 1 2 3 4 5 6 7 */
+	0x1f, 0x1f, 0x0c, 0x0c, 0x00, 0x0c, 0x00, 0x08,  /* 0x38: 8 9 : ; < = > ? */
+	0x0c, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x2f,  /* 0x40: @ A B C D E F G */
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f,  /* 0x48: H I J K L M N O */
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f,  /* 0x50: P Q R S T U V W */
+	0x2f, 0x2f, 0x2f, 0x00, 0x00, 0x00, 0x00, 0x0e,  /* 0x58: X Y Z [ \ ] ^ _ */
+	0x00, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x2f,  /* 0x60: ` a b c d e f g */
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f,  /* 0x68: h i j k l m n o */
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f,  /* 0x70: p q r s t u v w */
+	0x2f, 0x2f, 0x2f, 0x00, 0x00, 0x00, 0x0e, 0x00,  /* 0x78: x y z { | } ~ .. */
+};
+
+
+
 void uriWriteQuadToDoubleByte(const unsigned char * hexDigits, int digitCount, unsigned char * output) {
 	switch (digitCount) {
 	case 1:
@@ -88,3 +109,41 @@ unsigned char uriGetOctetValue(const unsigned char * digits, int digitCount) {
 
 	}
 }
+
+
+
+/*
+ * ucschar = %xA0-D7FF / %xF900-FDCF / %xFDF0-FFEF
+ *         / %x10000-1FFFD / %x20000-2FFFD / %x30000-3FFFD
+ *         / %x40000-4FFFD / %x50000-5FFFD / %x60000-6FFFD
+ *         / %x70000-7FFFD / %x80000-8FFFD / %x90000-9FFFD
+ *         / %xA0000-AFFFD / %xB0000-BFFFD / %xC0000-CFFFD
+ *         / %xD0000-DFFFD / %xE1000-EFFFD
+ */
+UriBool uriIsIriUcsChar(unsigned long codePoint) {
+	if (codePoint < 0x10000) {
+		return (((codePoint >= 0xA0) && (codePoint <= 0xD7FF))
+				|| ((codePoint >= 0xF900) && (codePoint <= 0xFDCF))
+				|| ((codePoint >= 0xFDF0) && (codePoint <= 0xFFEF)))
+				? URI_TRUE : URI_FALSE;
+	}
+	if ((codePoint >= 0xE0000) && (codePoint < 0xE1000)) {
+		return URI_FALSE;
+	}
+	return ((codePoint < 0xF0000) && ((codePoint & 0xFFFF) <= 0xFFFD))
+			? URI_TRUE : URI_FALSE;
+}
+
+
+
+/*
+ * iprivate = %xE000-F8FF / %xF0000-FFFFD / %x100000-10FFFD
+ */
+UriBool uriIsIriPrivate(unsigned long codePoint) {
+	if (codePoint < 0x10000) {
+		return ((codePoint >= 0xE000) && (codePoint <= 0xF8FF))
+				? URI_TRUE : URI_FALSE;
+	}
+	return ((codePoint >= 0xF0000) && (codePoint <= 0x10FFFF)
+			&& ((codePoint & 0xFFFF) <= 0xFFFD)) ? URI_TRUE : URI_FALSE;
+}
@@ -50,6 +50,34 @@ void uriWriteQuadToDoubleByte(const unsigned char * hexDigits, int digitCount,
 		unsigned char * output);
 unsigned char uriGetOctetValue(const unsigned char * digits, int digitCount);
 
+UriBool uriIsIriUcsChar(unsigned long codePoint);
+UriBool uriIsIriPrivate(unsigned long codePoint);
+
+
+
+/* Behind URI_TYPE(ParserState).reserved while parsing, may be NULL */
+typedef struct UriParserExtrasStruct {
+	UriParseInfo * info; /* Scheme and port filled by the OnExit* hooks, may be NULL */
+	UriBool iri; /* Accept ucschar (and iprivate in the query), RFC 3987 */
+	UriBool inQuery; /* Inside the query rather than the fragment */
+} UriParserExtras;
+
+
+
+/* Character classes of the fast paths in UriParse.c and UriFind.c */
+#define URI_FAST_SCHEME  0x01  /* ALPHA / DIGIT / "+" / "-" / "." */
+#define URI_FAST_HOST    0x02  /* ALPHA / DIGIT / "-" / "." / "_" / "~" */
+#define URI_FAST_PATH    0x04  /* pchar (except pct-encoded) / "/" */
+#define URI_FAST_QUERY   0x08  /* URI_FAST_PATH / "?" */
+#define URI_FAST_HEXDIG  0x10
+#define URI_FAST_ALPHA   0x20
+
+extern const unsigned char uriFastCharClass[128];
+
+/* Works with both char and wchar_t, anything non-ASCII has no class */
+#define URI_FAST_CHAR_IS(c, mask) \
+	(((unsigned int)(c) < 128) && ((uriFastCharClass[(unsigned int)(c)] & (mask)) != 0))
+
 
 
 #endif /* URI_PARSE_BASE_H */
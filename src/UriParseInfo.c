@@ -0,0 +1,290 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriParseInfo.c
+ * Holds facts about a %URI collected while parsing.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriParseInfo.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriParseInfo.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriParseInfo.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriMemory.h"
+#endif
+
+
+
+UriScheme URI_FUNC(IdentifyScheme)(const URI_CHAR * first,
+		const URI_CHAR * afterLast) {
+	URI_CHAR lower[6];
+	size_t len;
+	size_t i;
+
+	if (first == NULL) {
+		return URI_SCHEME_NONE;
+	}
+	if ((afterLast == NULL) || (afterLast < first)
+			|| ((size_t)(afterLast - first) > sizeof(lower) / sizeof(URI_CHAR))) {
+		return URI_SCHEME_UNKNOWN;
+	}
+
+	len = (size_t)(afterLast - first);
+	for (i = 0; i < len; i++) {
+		const URI_CHAR c = first[i];
+		lower[i] = ((c >= _UT('A')) && (c <= _UT('Z')))
+				? (URI_CHAR)(c + (_UT('a') - _UT('A')))
+				: c;
+	}
+
+#define URI_MATCHES(literal) \
+	(memcmp(lower, _UT(literal), len * sizeof(URI_CHAR)) == 0)
+
+	switch (len) {
+	case 2:
+		if (URI_MATCHES("ws")) {
+			return URI_SCHEME_WS;
+		}
+		break;
+
+	case 3:
+		if (URI_MATCHES("wss")) {
+			return URI_SCHEME_WSS;
+		} else if (URI_MATCHES("ftp")) {
+			return URI_SCHEME_FTP;
+		} else if (URI_MATCHES("urn")) {
+			return URI_SCHEME_URN;
+		}
+		break;
+
+	case 4:
+		if (URI_MATCHES("http")) {
+			return URI_SCHEME_HTTP;
+		} else if (URI_MATCHES("file")) {
+			return URI_SCHEME_FILE;
+		} else if (URI_MATCHES("data")) {
+			return URI_SCHEME_DATA;
+		}
+		break;
+
+	case 5:
+		if (URI_MATCHES("https")) {
+			return URI_SCHEME_HTTPS;
+		}
+		break;
+
+	case 6:
+		if (URI_MATCHES("mailto")) {
+			return URI_SCHEME_MAILTO;
+		}
+		break;
+	}
+
+#undef URI_MATCHES
+
+	return URI_SCHEME_UNKNOWN;
+}
+
+
+static unsigned int URI_FUNC(RangeFlags)(const URI_CHAR * first,
+		const URI_CHAR * afterLast) {
+	unsigned int flags = URI_HAS_NOTHING;
+
+	if ((first == NULL) || (afterLast == NULL)) {
+		return URI_HAS_NOTHING;
+	}
+
+	for (; first < afterLast; first++) {
+		const URI_CHAR c = first[0];
+		if (c == _UT('%')) {
+			flags |= URI_HAS_PERCENT;
+			if ((afterLast - first >= 3)
+					&& (URI_FUNC(HexdigToInt)(first[1]) >= 8)) {
+				flags |= URI_HAS_NON_ASCII;
+			}
+		} else if ((c >= _UT('A')) && (c <= _UT('Z'))) {
+			flags |= URI_HAS_UPPERCASE;
+		} else if ((unsigned long)c > 127) {
+			flags |= URI_HAS_NON_ASCII;
+		}
+	}
+	return flags;
+}
+
+
+
+int URI_FUNC(CollectComponentFlags)(const URI_TYPE(Uri) * uri,
+		UriParseInfo * info) {
+	const URI_TYPE(PathSegment) * walker;
+	unsigned int pathFlags = URI_HAS_NOTHING;
+
+	if ((uri == NULL) || (info == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	info->schemeFlags = URI_FUNC(RangeFlags)(uri->scheme.first, uri->scheme.afterLast);
+	info->userInfoFlags = URI_FUNC(RangeFlags)(uri->userInfo.first, uri->userInfo.afterLast);
+	info->hostFlags = URI_FUNC(RangeFlags)(uri->hostText.first, uri->hostText.afterLast);
+	if ((uri->hostData.ip4 != NULL)
+			|| (uri->hostData.ip6 != NULL)
+			|| (uri->hostData.ipFuture.first != NULL)) {
+		info->hostFlags |= URI_HAS_IP_HOST;
+	}
+
+	for (walker = uri->pathHead; walker != NULL; walker = walker->next) {
+		const URI_CHAR * const first = walker->text.first;
+		const URI_CHAR * const afterLast = walker->text.afterLast;
+		const size_t len = (size_t)(afterLast - first);
+
+		if (len == 0) {
+			pathFlags |= URI_HAS_EMPTY_SEGMENT;
+		} else if (((len == 1) && (first[0] == _UT('.')))
+				|| ((len == 2) && (first[0] == _UT('.')) && (first[1] == _UT('.')))) {
+			pathFlags |= URI_HAS_DOT_SEGMENT;
+		} else {
+			pathFlags |= URI_FUNC(RangeFlags)(first, afterLast);
+		}
+	}
+	info->pathFlags = pathFlags;
+
+	info->queryFlags = URI_FUNC(RangeFlags)(uri->query.first, uri->query.afterLast);
+	info->fragmentFlags = URI_FUNC(RangeFlags)(uri->fragment.first, uri->fragment.afterLast);
+	return URI_SUCCESS;
+}
+
+
+
+unsigned int URI_FUNC(NormalizeSyntaxMaskFromInfo)(
+		const URI_TYPE(Uri) * uri, const UriParseInfo * info) {
+	unsigned int mask = URI_NORMALIZED;
+
+	if ((uri == NULL) || (info == NULL)) {
+		return URI_NORMALIZED;
+	}
+
+	if (info->schemeFlags & URI_HAS_UPPERCASE) {
+		mask |= URI_NORMALIZE_SCHEME;
+	}
+	if (info->userInfoFlags & URI_HAS_PERCENT) {
+		mask |= URI_NORMALIZE_USER_INFO;
+	}
+	if (info->hostFlags & (URI_HAS_UPPERCASE | URI_HAS_PERCENT)) {
+		mask |= URI_NORMALIZE_HOST;
+	}
+	if ((uri->portText.first != NULL)
+			&& (uri->portText.afterLast - uri->portText.first > 1)
+			&& (uri->portText.first[0] == _UT('0'))) {
+		mask |= URI_NORMALIZE_PORT;
+	}
+	if (info->pathFlags & (URI_HAS_DOT_SEGMENT | URI_HAS_PERCENT)) {
+		mask |= URI_NORMALIZE_PATH;
+	}
+	if (info->queryFlags & URI_HAS_PERCENT) {
+		mask |= URI_NORMALIZE_QUERY;
+	}
+	if (info->fragmentFlags & URI_HAS_PERCENT) {
+		mask |= URI_NORMALIZE_FRAGMENT;
+	}
+	return mask;
+}
+
+
+
+int URI_FUNC(NormalizeSyntaxInfoMm)(URI_TYPE(Uri) * uri,
+		UriParseInfo * info, UriMemoryManager * memory) {
+	unsigned int mask;
+	int res;
+
+	if ((uri == NULL) || (info == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	mask = URI_FUNC(NormalizeSyntaxMaskFromInfo)(uri, info);
+	if (mask == URI_NORMALIZED) {
+		return URI_SUCCESS;
+	}
+
+	res = URI_FUNC(NormalizeSyntaxExMm)(uri, mask, memory);
+	if (res != URI_SUCCESS) {
+		return res;
+	}
+	return URI_FUNC(CollectComponentFlags)(uri, info);
+}
+
+
+
+int URI_FUNC(NormalizeSyntaxInfo)(URI_TYPE(Uri) * uri, UriParseInfo * info) {
+	return URI_FUNC(NormalizeSyntaxInfoMm)(uri, info, NULL);
+}
+
+
+
+#endif
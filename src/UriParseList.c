@@ -0,0 +1,192 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriParseList.c
+ * Parses buffers holding many URIs.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriParseList.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriParseList.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriParseList.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriMemory.h"
+#endif
+
+
+
+static URI_INLINE UriBool URI_FUNC(IsBlank)(URI_CHAR c) {
+	return ((c == _UT(' ')) || (c == _UT('\t')) || (c == _UT('\r')))
+			? URI_TRUE : URI_FALSE;
+}
+
+
+
+static URI_INLINE UriBool URI_FUNC(IsWhitespace)(URI_CHAR c) {
+	return (URI_FUNC(IsBlank)(c) || (c == _UT('\n')) || (c == _UT('\f'))
+			|| (c == _UT('\v'))) ? URI_TRUE : URI_FALSE;
+}
+
+
+
+int URI_FUNC(ParseUriListEx)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, UriListDelimiter delimiter,
+		URI_TYPE(ParseUriListCallback) callback, void * userData) {
+	if ((afterLast == NULL) && (first != NULL)) {
+		afterLast = first + URI_STRLEN(first);
+	}
+	return URI_FUNC(ParseUriListExMm)(first, afterLast, delimiter, callback,
+			userData, NULL);
+}
+
+
+
+int URI_FUNC(ParseUriListExMm)(const URI_CHAR * first,
+		const URI_CHAR * afterLast, UriListDelimiter delimiter,
+		URI_TYPE(ParseUriListCallback) callback, void * userData,
+		UriMemoryManager * memory) {
+	URI_TYPE(Uri) uri;
+	UriArenaMemoryManager arena;
+	const URI_CHAR * walker = first;
+	int res = URI_SUCCESS;
+
+	/* Check params */
+	if ((first == NULL) || (afterLast == NULL) || (callback == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	/* Each URI is dropped as a whole after the callback returns, so its
+	 * path segments and IP addresses are served from a rewindable arena
+	 * rather than allocated and freed one by one. */
+	uriInitArenaMemoryManager(&arena, memory);
+
+	while (walker < afterLast) {
+		const URI_CHAR * itemFirst;
+		const URI_CHAR * itemAfterLast;
+		const URI_CHAR * errorPos = NULL;
+		UriBool proceed;
+
+		if (delimiter == URI_LIST_LINES) {
+			const URI_CHAR * const newline
+					= URI_MEMCHR(walker, _UT('\n'), (size_t)(afterLast - walker));
+			itemFirst = walker;
+			itemAfterLast = (newline != NULL) ? newline : afterLast;
+			walker = (newline != NULL) ? newline + 1 : afterLast;
+
+			/* Trim blanks, including the "\r" of "\r\n" */
+			while ((itemFirst < itemAfterLast) && URI_FUNC(IsBlank)(*itemFirst)) {
+				itemFirst++;
+			}
+			while ((itemAfterLast > itemFirst)
+					&& URI_FUNC(IsBlank)(itemAfterLast[-1])) {
+				itemAfterLast--;
+			}
+		} else {
+			while ((walker < afterLast) && URI_FUNC(IsWhitespace)(*walker)) {
+				walker++;
+			}
+			itemFirst = walker;
+			while ((walker < afterLast) && !URI_FUNC(IsWhitespace)(*walker)) {
+				walker++;
+			}
+			itemAfterLast = walker;
+		}
+
+		if (itemFirst == itemAfterLast) {
+			continue;
+		}
+
+		res = URI_FUNC(ParseSingleUriExMm)(&uri, itemFirst, itemAfterLast,
+				&errorPos, &arena.manager);
+		if (res == URI_SUCCESS) {
+			proceed = callback(userData, &uri, itemFirst, itemAfterLast,
+					URI_SUCCESS, NULL);
+		} else if (res == URI_ERROR_SYNTAX) {
+			proceed = callback(userData, NULL, itemFirst, itemAfterLast,
+					res, errorPos);
+			res = URI_SUCCESS;
+		} else {
+			break;
+		}
+		uriRewindArena(&arena);
+
+		if (!proceed) {
+			break;
+		}
+	}
+
+	uriRewindArena(&arena);
+	return res;
+}
+
+
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriPublicSuffix.c
+ * Holds the registrable domain lookup implementation.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriPublicSuffix.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriPublicSuffix.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriPublicSuffix.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriPublicSuffixBase.h"
+#endif
+
+
+
+static int URI_FUNC(ComparePublicSuffixLabel)(const URI_CHAR * first,
+		unsigned int length, const char * label, unsigned int labelLength) {
+	const unsigned int common = (length < labelLength) ? length : labelLength;
+	unsigned int i;
+
+	for (i = 0; i < common; i++) {
+		unsigned long c = (sizeof(URI_CHAR) == 1)
+				? (unsigned long)(unsigned char)first[i]
+				: (unsigned long)first[i];
+		const unsigned long l = (unsigned char)label[i];
+		if ((c >= 'A') && (c <= 'Z')) {
+			c += 'a' - 'A';
+		}
+		if (c != l) {
+			return (c < l) ? -1 : 1;
+		}
+	}
+	return (int)length - (int)labelLength;
+}
+
+
+
+static const UriPublicSuffixNode * URI_FUNC(FindPublicSuffixChild)(
+		const UriPublicSuffixList * psl, const UriPublicSuffixNode * node,
+		const URI_CHAR * first, const URI_CHAR * afterLast) {
+	const unsigned int length = (unsigned int)(afterLast - first);
+	unsigned int low = node->firstChild;
+	unsigned int high = low + node->childCount;
+
+	if (length > 255) {
+		return NULL;
+	}
+	if (sizeof(URI_CHAR) > 1) {
+		/* Non-ASCII labels of the list are UTF-8, wide hosts cannot match */
+		const URI_CHAR * walker;
+		for (walker = first; walker < afterLast; walker++) {
+			if ((unsigned long)*walker >= 0x80) {
+				return NULL;
+			}
+		}
+	}
+
+	while (low < high) {
+		const unsigned int middle = low + (high - low) / 2;
+		const UriPublicSuffixNode * const child = psl->nodes + middle;
+		const int res = URI_FUNC(ComparePublicSuffixLabel)(first, length,
+				psl->labels + child->labelOffset, child->labelLength);
+		if (res == 0) {
+			return child;
+		} else if (res < 0) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+	return NULL;
+}
+
+
+
+int URI_FUNC(RegistrableDomain)(const URI_TYPE(Uri) * uri,
+		const UriHostLabels * labels, const UriPublicSuffixList * psl,
+		URI_TYPE(TextRange) * registrableDomain,
+		URI_TYPE(TextRange) * publicSuffix) {
+	UriHostLabels ownLabels;
+	const UriPublicSuffixNode * node;
+	const URI_CHAR * host;
+	const URI_CHAR * hostAfterLast;
+	int suffixCount = 1;  /* The implicit rule "*" */
+	int depth = 0;
+	int i;
+
+	if ((uri == NULL) || (psl == NULL) || (registrableDomain == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	if (labels == NULL) {
+		const int res = URI_FUNC(IndexHostLabels)(uri, &ownLabels);
+		if (res != URI_SUCCESS) {
+			return res;
+		}
+		labels = &ownLabels;
+	}
+
+	host = uri->hostText.first;
+	hostAfterLast = host + labels->offsets[labels->count] - 1;
+
+	/* Walk the trie right to left, exception rules beat all others
+	 * and longer rules beat shorter ones */
+	node = psl->nodes;
+	for (i = labels->count - 1; i >= 0; i--) {
+		const UriPublicSuffixNode * const child = URI_FUNC(FindPublicSuffixChild)(
+				psl, node, host + labels->offsets[i],
+				host + labels->offsets[i + 1] - 1);
+		if ((child != NULL) && (child->flags & URI_PSL_EXCEPTION)) {
+			suffixCount = depth;
+			break;
+		}
+		if ((node->flags & URI_PSL_WILDCARD) && (depth + 1 > suffixCount)) {
+			suffixCount = depth + 1;
+		}
+		if (child == NULL) {
+			break;
+		}
+		depth++;
+		if ((child->flags & URI_PSL_RULE) && (depth > suffixCount)) {
+			suffixCount = depth;
+		}
+		node = child;
+	}
+	if (suffixCount > labels->count) {
+		suffixCount = labels->count;  /* i.e. an empty host */
+	}
+
+	if (suffixCount > 0) {
+		if (publicSuffix != NULL) {
+			publicSuffix->first = host + labels->offsets[labels->count - suffixCount];
+			publicSuffix->afterLast = hostAfterLast;
+		}
+	} else if (publicSuffix != NULL) {
+		publicSuffix->first = NULL;
+		publicSuffix->afterLast = NULL;
+	}
+
+	if (suffixCount < labels->count) {
+		registrableDomain->first = host
+				+ labels->offsets[labels->count - suffixCount - 1];
+		registrableDomain->afterLast = hostAfterLast;
+	} else {
+		registrableDomain->first = NULL;
+		registrableDomain->afterLast = NULL;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+
+#endif
@@ -0,0 +1,364 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriPublicSuffixBase.c
+ * Holds the public suffix list compiler, independent of the encoding pass.
+ */
+
+#ifndef URI_DOXYGEN
+# include "UriPublicSuffixBase.h"
+# include "UriMemory.h"
+#endif
+
+
+
+#define URI_PSL_MAX_LABEL  63  /* DNS limit, RFC 1034 section 3.1 */
+
+
+
+/* Trie node while compiling, children in a singly linked list */
+typedef struct UriPslBuildNodeStruct {
+	unsigned int labelOffset;
+	unsigned int firstChild; /* 0 for none, the root is no child */
+	unsigned int nextSibling; /* 0 for none */
+	unsigned char labelLength;
+	unsigned char flags;
+} UriPslBuildNode;
+
+
+
+typedef struct UriPslBuilderStruct {
+	UriMemoryManager * memory;
+	UriPslBuildNode * nodes;
+	unsigned int nodeCount;
+	unsigned int nodeCapacity;
+	char * labels; /* Never longer than the list text */
+	unsigned int labelsUsed;
+} UriPslBuilder;
+
+
+
+static int uriPslCompareLabels(const char * a, unsigned int aLength,
+		const char * b, unsigned int bLength) {
+	const int res = memcmp(a, b, (aLength < bLength) ? aLength : bLength);
+	if (res != 0) {
+		return res;
+	}
+	return (int)aLength - (int)bLength;
+}
+
+
+
+static int uriPslAddNode(UriPslBuilder * builder, unsigned int parent,
+		const char * first, unsigned int length, unsigned int * index) {
+	UriPslBuildNode * node;
+	unsigned int child = builder->nodes[parent].firstChild;
+	char * label;
+	unsigned int i;
+
+	/* Labels in the pool are lowercase already */
+	while (child != 0) {
+		const UriPslBuildNode * const candidate = builder->nodes + child;
+		if (candidate->labelLength == length) {
+			for (i = 0; i < length; i++) {
+				const char c = ((first[i] >= 'A') && (first[i] <= 'Z'))
+						? (char)(first[i] + ('a' - 'A'))
+						: first[i];
+				if (builder->labels[candidate->labelOffset + i] != c) {
+					break;
+				}
+			}
+			if (i == length) {
+				*index = child;
+				return URI_SUCCESS;
+			}
+		}
+		child = candidate->nextSibling;
+	}
+
+	if (builder->nodeCount == builder->nodeCapacity) {
+		UriPslBuildNode * const nodes = builder->memory->reallocarray(
+				builder->memory, builder->nodes, builder->nodeCapacity * 2,
+				sizeof(UriPslBuildNode));
+		if (nodes == NULL) {
+			return URI_ERROR_MALLOC;
+		}
+		builder->nodes = nodes;
+		builder->nodeCapacity *= 2;
+	}
+
+	label = builder->labels + builder->labelsUsed;
+	for (i = 0; i < length; i++) {
+		label[i] = ((first[i] >= 'A') && (first[i] <= 'Z'))
+				? (char)(first[i] + ('a' - 'A'))
+				: first[i];
+	}
+
+	node = builder->nodes + builder->nodeCount;
+	node->labelOffset = builder->labelsUsed;
+	node->labelLength = (unsigned char)length;
+	node->flags = 0;
+	node->firstChild = 0;
+	node->nextSibling = builder->nodes[parent].firstChild;
+	builder->nodes[parent].firstChild = builder->nodeCount;
+	builder->labelsUsed += length;
+	*index = builder->nodeCount++;
+	return URI_SUCCESS;
+}
+
+
+
+static int uriPslAddRule(UriPslBuilder * builder, const char * first,
+		const char * afterLast, const char ** errorPos) {
+	const char * const ruleFirst = first;
+	unsigned char flags = URI_PSL_RULE;
+	unsigned int node = 0;
+	const char * labelAfterLast = afterLast;
+
+	if (*first == '!') {
+		flags = URI_PSL_EXCEPTION;
+		first++;
+	}
+	if ((afterLast - first == 1) && (*first == '*')) {
+		/* The implicit default rule */
+		return (flags == URI_PSL_RULE) ? URI_SUCCESS : URI_ERROR_SYNTAX;
+	}
+	if ((afterLast - first >= 2) && (first[0] == '*') && (first[1] == '.')) {
+		if (flags == URI_PSL_EXCEPTION) {
+			*errorPos = ruleFirst;
+			return URI_ERROR_SYNTAX;
+		}
+		flags = URI_PSL_WILDCARD;
+		first += 2;
+	}
+
+	/* Labels right to left */
+	for (;;) {
+		const char * labelFirst = labelAfterLast;
+		unsigned int length;
+		int res;
+
+		while ((labelFirst > first) && (labelFirst[-1] != '.')) {
+			labelFirst--;
+			if (*labelFirst == '*') {
+				*errorPos = ruleFirst;
+				return URI_ERROR_SYNTAX;
+			}
+		}
+		length = (unsigned int)(labelAfterLast - labelFirst);
+		if ((length == 0) || (length > URI_PSL_MAX_LABEL)) {
+			*errorPos = ruleFirst;
+			return URI_ERROR_SYNTAX;
+		}
+
+		res = uriPslAddNode(builder, node, labelFirst, length, &node);
+		if (res != URI_SUCCESS) {
+			return res;
+		}
+
+		if (labelFirst == first) {
+			break;
+		}
+		labelAfterLast = labelFirst - 1;
+	}
+
+	builder->nodes[node].flags |= flags;
+	return URI_SUCCESS;
+}
+
+
+
+/* Lays out the trie breadth-first with adjacent, sorted children */
+static int uriPslFlatten(UriPslBuilder * builder, UriPublicSuffixList ** psl) {
+	UriMemoryManager * const memory = builder->memory;
+	const size_t nodesSize = builder->nodeCount * sizeof(UriPublicSuffixNode);
+	UriPublicSuffixList * list;
+	UriPublicSuffixNode * nodes;
+	unsigned int * order;
+	unsigned int filled = 1;
+	unsigned int f;
+
+	order = memory->reallocarray(memory, NULL, builder->nodeCount,
+			sizeof(unsigned int));
+	if (order == NULL) {
+		return URI_ERROR_MALLOC;
+	}
+	list = memory->malloc(memory, sizeof(UriPublicSuffixList) + nodesSize
+			+ builder->labelsUsed);
+	if (list == NULL) {
+		memory->free(memory, order);
+		return URI_ERROR_MALLOC;
+	}
+	nodes = (UriPublicSuffixNode *)(list + 1);
+
+	order[0] = 0;
+	for (f = 0; f < builder->nodeCount; f++) {
+		const UriPslBuildNode * const source = builder->nodes + order[f];
+		const unsigned int childrenFirst = filled;
+		unsigned int child;
+		unsigned int i;
+
+		for (child = source->firstChild; child != 0;
+				child = builder->nodes[child].nextSibling) {
+			const UriPslBuildNode * const inserted = builder->nodes + child;
+			/* Insertion sort, sibling lists are short but for the TLDs */
+			for (i = filled; i > childrenFirst; i--) {
+				const UriPslBuildNode * const before = builder->nodes + order[i - 1];
+				if (uriPslCompareLabels(builder->labels + before->labelOffset,
+						before->labelLength,
+						builder->labels + inserted->labelOffset,
+						inserted->labelLength) <= 0) {
+					break;
+				}
+				order[i] = order[i - 1];
+			}
+			order[i] = child;
+			filled++;
+		}
+
+		nodes[f].labelOffset = source->labelOffset;
+		nodes[f].labelLength = source->labelLength;
+		nodes[f].flags = source->flags;
+		nodes[f].firstChild = childrenFirst;
+		nodes[f].childCount = filled - childrenFirst;
+	}
+
+	list->memory = memory;
+	list->nodes = nodes;
+	list->nodeCount = builder->nodeCount;
+	list->labels = (const char *)nodes + nodesSize;
+	memcpy((char *)nodes + nodesSize, builder->labels, builder->labelsUsed);
+
+	memory->free(memory, order);
+	*psl = list;
+	return URI_SUCCESS;
+}
+
+
+
+int uriCompilePublicSuffixListMm(UriPublicSuffixList ** psl,
+		const char * first, const char * afterLast, const char ** errorPos,
+		UriMemoryManager * memory) {
+	UriPslBuilder builder;
+	const char * lineFirst;
+	int res = URI_SUCCESS;
+
+	if ((psl == NULL) || (first == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+	if (afterLast == NULL) {
+		afterLast = first + strlen(first);
+	}
+
+	builder.memory = memory;
+	builder.nodeCapacity = 256;
+	builder.nodeCount = 1;
+	builder.labelsUsed = 0;
+	builder.nodes = memory->reallocarray(memory, NULL, builder.nodeCapacity,
+			sizeof(UriPslBuildNode));
+	builder.labels = memory->malloc(memory, (size_t)(afterLast - first) + 1);
+	if ((builder.nodes == NULL) || (builder.labels == NULL)) {
+		if (builder.nodes != NULL) {
+			memory->free(memory, builder.nodes);
+		}
+		if (builder.labels != NULL) {
+			memory->free(memory, builder.labels);
+		}
+		return URI_ERROR_MALLOC;
+	}
+	memset(builder.nodes, 0, sizeof(UriPslBuildNode));
+
+	for (lineFirst = first; lineFirst < afterLast; ) {
+		const char * ruleFirst = lineFirst;
+		const char * ruleAfterLast;
+		const char * lineAfterLast = lineFirst;
+
+		while ((lineAfterLast < afterLast) && (*lineAfterLast != '\n')) {
+			lineAfterLast++;
+		}
+		while ((ruleFirst < lineAfterLast)
+				&& ((*ruleFirst == ' ') || (*ruleFirst == '\t')
+					|| (*ruleFirst == '\r'))) {
+			ruleFirst++;
+		}
+		ruleAfterLast = ruleFirst;
+		while ((ruleAfterLast < lineAfterLast) && (*ruleAfterLast != ' ')
+				&& (*ruleAfterLast != '\t') && (*ruleAfterLast != '\r')) {
+			ruleAfterLast++;
+		}
+
+		if ((ruleAfterLast > ruleFirst)
+				&& !((ruleAfterLast - ruleFirst >= 2)
+					&& (ruleFirst[0] == '/') && (ruleFirst[1] == '/'))) {
+			const char * rulePos = ruleFirst;
+			res = uriPslAddRule(&builder, ruleFirst, ruleAfterLast, &rulePos);
+			if (res != URI_SUCCESS) {
+				if ((res == URI_ERROR_SYNTAX) && (errorPos != NULL)) {
+					*errorPos = rulePos;
+				}
+				break;
+			}
+		}
+
+		lineFirst = lineAfterLast + 1;
+	}
+
+	if (res == URI_SUCCESS) {
+		res = uriPslFlatten(&builder, psl);
+	}
+	memory->free(memory, builder.nodes);
+	memory->free(memory, builder.labels);
+	return res;
+}
+
+
+
+int uriCompilePublicSuffixList(UriPublicSuffixList ** psl,
+		const char * first, const char * afterLast, const char ** errorPos) {
+	return uriCompilePublicSuffixListMm(psl, first, afterLast, errorPos, NULL);
+}
+
+
+
+void uriFreePublicSuffixList(UriPublicSuffixList * psl) {
+	if (psl != NULL) {
+		psl->memory->free(psl->memory, psl);
+	}
+}
@@ -0,0 +1,80 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef URI_PUBLIC_SUFFIX_BASE_H
+#define URI_PUBLIC_SUFFIX_BASE_H 1
+
+
+
+#include <uriparser/UriBase.h>
+
+
+
+/* Flags of UriPublicSuffixNode */
+#define URI_PSL_RULE       0x01  /* A rule ends here, e.g. "uk" in "co.uk" */
+#define URI_PSL_WILDCARD   0x02  /* Any label below is a rule, e.g. "*.ck" */
+#define URI_PSL_EXCEPTION  0x04  /* Not a rule after all, e.g. "!www.ck" */
+
+
+
+/*
+ * Trie node, labels are read right to left ("uk", then "co").
+ * Children of a node are adjacent and sorted by label, compared
+ * as unsigned bytes first and by length second, for binary search.
+ */
+typedef struct UriPublicSuffixNodeStruct {
+	unsigned int labelOffset; /* Into .labels of the list */
+	unsigned int firstChild; /* Index into .nodes of the list */
+	unsigned int childCount;
+	unsigned char labelLength;
+	unsigned char flags; /* See URI_PSL_RULE etc. */
+} UriPublicSuffixNode;
+
+
+
+/* Allocated as one block: the struct, then the nodes, then the labels */
+struct UriPublicSuffixListStruct {
+	UriMemoryManager * memory;
+	const UriPublicSuffixNode * nodes; /* Root first, with an empty label */
+	const char * labels; /* Lowercase, not terminated */
+	unsigned int nodeCount;
+};
+
+
+
+#endif /* URI_PUBLIC_SUFFIX_BASE_H */
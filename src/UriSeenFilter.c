@@ -0,0 +1,285 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriSeenFilter.c
+ * Holds the seen-URL filter, independent of the encoding pass.
+ */
+
+#ifndef URI_DOXYGEN
+# include <uriparser/UriBase.h>
+# include "UriMemory.h"
+#endif
+
+
+
+/*
+ * Split block Bloom filter, as used by Apache Parquet and Impala:
+ * a key picks one block of eight 32-bit words by its high bits
+ * and sets one bit per word by its low bits, so that inserts and
+ * lookups touch a single cache line and need no further hashing.
+ */
+#define URI_SEEN_WORDS_PER_BLOCK  8
+#define URI_SEEN_BITS_PER_BLOCK   256
+
+/* Bounds the bits per key chosen for a false positive rate */
+#define URI_SEEN_MAX_BITS_PER_KEY  128
+
+
+
+typedef struct UriSeenBlockStruct {
+	unsigned int words[URI_SEEN_WORDS_PER_BLOCK];
+} UriSeenBlock;
+
+
+
+struct UriSeenFilterStruct {
+	UriMemoryManager * memory;
+	UriSeenBlock * blocks; /* Within this allocation, aligned to their size */
+	UriUint64 blockCount; /* Less than 2^32 */
+	size_t byteSize; /* Of this allocation */
+};
+
+
+
+/* Odd multipliers picking the bit per word, from Apache Parquet */
+static const unsigned long uriSeenSalts[URI_SEEN_WORDS_PER_BLOCK] = {
+	0x47B6137BUL, 0x44974D91UL, 0x8824AD5BUL, 0xA2B7289DUL,
+	0x705495C7UL, 0x2DF1424BUL, 0x9EFC4947UL, 0x5C6BFB31UL
+};
+
+
+
+/*
+ * Bits are only ever set, so relaxed atomics suffice for concurrent
+ * inserts; without them, racing inserts into one block may lose bits.
+ */
+#if defined(__clang__) || (defined(__GNUC__) \
+		&& ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7))))
+# define URI_SEEN_FETCH_OR(word, bits) \
+	__atomic_fetch_or((word), (bits), __ATOMIC_RELAXED)
+# define URI_SEEN_LOAD(word)  __atomic_load_n((word), __ATOMIC_RELAXED)
+#elif defined(_MSC_VER)
+# include <intrin.h>
+# define URI_SEEN_FETCH_OR(word, bits) \
+	((unsigned int)_InterlockedOr((volatile long *)(word), (long)(bits)))
+# define URI_SEEN_LOAD(word)  (*(volatile const unsigned int *)(word))
+#else
+# define URI_SEEN_FETCH_OR(word, bits)  uriSeenFetchOr((word), (bits))
+# define URI_SEEN_LOAD(word)  (*(word))
+
+static unsigned int uriSeenFetchOr(unsigned int * word, unsigned int bits) {
+	const unsigned int before = *word;
+	*word = before | bits;
+	return before;
+}
+#endif
+
+
+
+/* Approximates e^-x for x >= 0 as (1 - x / 2^24)^(2^24) */
+static double uriSeenExpMinus(double x) {
+	double value = 1.0 - x / 16777216.0;
+	int i;
+	for (i = 0; i < 24; i++) {
+		value *= value;
+	}
+	return value;
+}
+
+
+
+/*
+ * False positive rate at a number of bits per key: block loads
+ * are Poisson-distributed, and with j keys in a block a lookup
+ * fails to notice the absence of its key if each of its eight bits
+ * was set by one of those keys, i.e. (1 - (31/32)^j)^8.
+ */
+static double uriSeenFalsePositiveRate(int bitsPerKey) {
+	const double load = (double)URI_SEEN_BITS_PER_BLOCK / bitsPerKey;
+	const int keysMax = (int)(4.0 * load) + 64;
+	double probability = uriSeenExpMinus(load);
+	double allClear = 1.0;
+	double rate = 0.0;
+	int keys;
+
+	for (keys = 0; keys <= keysMax; keys++) {
+		const double wordHit = 1.0 - allClear;
+		const double wordHit2 = wordHit * wordHit;
+		const double wordHit4 = wordHit2 * wordHit2;
+		rate += probability * wordHit4 * wordHit4;
+		allClear *= 31.0 / 32.0;
+		probability *= load / (keys + 1);
+	}
+	return rate;
+}
+
+
+
+static UriSeenBlock * uriSeenBlockOf(const UriSeenFilter * filter, UriUint64 hash) {
+	/* Maps the high 32 bits to [0, blockCount) without division */
+	return filter->blocks + (size_t)(((hash >> 32) * filter->blockCount) >> 32);
+}
+
+
+
+static unsigned int uriSeenBit(UriUint64 hash, int word) {
+	const unsigned long low = (unsigned long)(hash & 0xFFFFFFFFUL);
+	return 1U << (int)(((low * uriSeenSalts[word]) & 0xFFFFFFFFUL) >> 27);
+}
+
+
+
+int uriCreateSeenFilterMm(UriSeenFilter ** filter, UriUint64 expectedCount,
+		double falsePositiveRate, UriMemoryManager * memory) {
+	UriSeenFilter * created;
+	UriUint64 blockCount;
+	size_t blocksOffset;
+	size_t total;
+	int bitsPerKey;
+
+	if (filter == NULL) {
+		return URI_ERROR_NULL;
+	}
+	if (! ((falsePositiveRate > 0.0) && (falsePositiveRate < 1.0))) {
+		return URI_ERROR_SEENFILTER_RATE_INVALID;  /* also for NaN */
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	bitsPerKey = 1;
+	while ((bitsPerKey < URI_SEEN_MAX_BITS_PER_KEY)
+			&& (uriSeenFalsePositiveRate(bitsPerKey) > falsePositiveRate)) {
+		bitsPerKey++;
+	}
+
+	if (expectedCount == 0) {
+		expectedCount = 1;
+	}
+	if (expectedCount > ((((UriUint64)1) << 40) / (UriUint64)bitsPerKey)) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	blockCount = (expectedCount * (UriUint64)bitsPerKey
+			+ (URI_SEEN_BITS_PER_BLOCK - 1)) / URI_SEEN_BITS_PER_BLOCK;
+
+	/* One allocation: the struct, padding for alignment, the blocks */
+	blocksOffset = sizeof(UriSeenFilter) + sizeof(UriSeenBlock) - 1;
+	if (blockCount > ((size_t)-1 - blocksOffset) / sizeof(UriSeenBlock)) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	total = blocksOffset + (size_t)blockCount * sizeof(UriSeenBlock);
+	created = memory->malloc(memory, total);
+	if (created == NULL) {
+		return URI_ERROR_MALLOC;
+	}
+
+	blocksOffset = sizeof(UriSeenFilter);
+	blocksOffset += (sizeof(UriSeenBlock)
+			- ((size_t)((unsigned char *)created + blocksOffset)
+				% sizeof(UriSeenBlock))) % sizeof(UriSeenBlock);
+	created->memory = memory;
+	created->blocks = (UriSeenBlock *)(void *)((unsigned char *)created + blocksOffset);
+	created->blockCount = blockCount;
+	created->byteSize = total;
+	memset(created->blocks, 0, (size_t)blockCount * sizeof(UriSeenBlock));
+
+	*filter = created;
+	return URI_SUCCESS;
+}
+
+
+
+int uriCreateSeenFilter(UriSeenFilter ** filter, UriUint64 expectedCount,
+		double falsePositiveRate) {
+	return uriCreateSeenFilterMm(filter, expectedCount, falsePositiveRate, NULL);
+}
+
+
+
+void uriFreeSeenFilter(UriSeenFilter * filter) {
+	if (filter == NULL) {
+		return;
+	}
+	filter->memory->free(filter->memory, filter);
+}
+
+
+
+size_t uriSeenFilterByteSize(const UriSeenFilter * filter) {
+	return (filter == NULL) ? 0 : filter->byteSize;
+}
+
+
+
+UriBool uriSeenFilterInsert(UriSeenFilter * filter, UriUint64 hash) {
+	UriSeenBlock * block;
+	UriBool seen = URI_TRUE;
+	int i;
+
+	if (filter == NULL) {
+		return URI_FALSE;
+	}
+
+	block = uriSeenBlockOf(filter, hash);
+	for (i = 0; i < URI_SEEN_WORDS_PER_BLOCK; i++) {
+		const unsigned int bit = uriSeenBit(hash, i);
+		if ((URI_SEEN_FETCH_OR(&block->words[i], bit) & bit) == 0) {
+			seen = URI_FALSE;
+		}
+	}
+	return seen;
+}
+
+
+
+UriBool uriSeenFilterContains(const UriSeenFilter * filter, UriUint64 hash) {
+	const UriSeenBlock * block;
+	int i;
+
+	if (filter == NULL) {
+		return URI_FALSE;
+	}
+
+	block = uriSeenBlockOf(filter, hash);
+	for (i = 0; i < URI_SEEN_WORDS_PER_BLOCK; i++) {
+		const unsigned int bit = uriSeenBit(hash, i);
+		if ((URI_SEEN_LOAD(&block->words[i]) & bit) == 0) {
+			return URI_FALSE;
+		}
+	}
+	return URI_TRUE;
+}
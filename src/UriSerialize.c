@@ -0,0 +1,424 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ * All rights reserved.
+ *
+ * Redistribution and use in source  and binary forms, with or without
+ * modification, are permitted provided  that the following conditions
+ * are met:
+ *
+ *     1. Redistributions  of  source  code   must  retain  the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer.
+ *
+ *     2. Redistributions  in binary  form  must  reproduce the  above
+ *        copyright notice, this list  of conditions and the following
+ *        disclaimer  in  the  documentation  and/or  other  materials
+ *        provided with the distribution.
+ *
+ *     3. Neither the  name of the  copyright holder nor the  names of
+ *        its contributors may be used  to endorse or promote products
+ *        derived from  this software  without specific  prior written
+ *        permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND  ANY EXPRESS OR IMPLIED WARRANTIES,  INCLUDING, BUT NOT
+ * LIMITED TO,  THE IMPLIED WARRANTIES OF  MERCHANTABILITY AND FITNESS
+ * FOR  A  PARTICULAR  PURPOSE  ARE  DISCLAIMED.  IN  NO  EVENT  SHALL
+ * THE  COPYRIGHT HOLDER  OR CONTRIBUTORS  BE LIABLE  FOR ANY  DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL,  EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA,  OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file UriSerialize.c
+ * Holds the binary serialization of parsed URIs.
+ * NOTE: This source file includes itself once per encoding.
+ */
+
+/* What encodings are enabled? */
+#include <uriparser/UriDefsConfig.h>
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriSerialize.c"
+#  undef URI_PASS_CHAR16_T
+# endif
+# ifdef URI_ENABLE_ANSI
+#  define URI_PASS_ANSI 1
+#  include "UriSerialize.c"
+#  undef URI_PASS_ANSI
+# endif
+# ifdef URI_ENABLE_UNICODE
+#  define URI_PASS_UNICODE 1
+#  include "UriSerialize.c"
+#  undef URI_PASS_UNICODE
+# endif
+#else
+# ifdef URI_PASS_ANSI
+#  include <uriparser/UriDefsAnsi.h>
+# elif defined(URI_PASS_UNICODE)
+#  include <uriparser/UriDefsUnicode.h>
+#  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
+# endif
+
+
+
+#ifndef URI_DOXYGEN
+# include <uriparser/Uri.h>
+# include "UriCommon.h"
+# include "UriMemory.h"
+#endif
+
+
+
+#include <limits.h>
+
+
+
+/*
+ * Layout of a serialized URI, all numbers unsigned 32-bit little-endian:
+ *
+ *   0  "URI", format version             4 bytes
+ *   4  size of URI_CHAR, flags, host
+ *      type, zero                        4 bytes
+ *   8  total size in bytes               (multiple of 4)
+ *  12  length of the text in characters
+ *  16  number of path segments
+ *  20  scheme, user info, host text,
+ *      port, query and fragment as
+ *      offset and length into the text  48 bytes (offset ~0 for NULL)
+ *  68  IPv4 or IPv6 address             16 bytes
+ *  84  offset and length of each path
+ *      segment into the text             8 bytes each
+ *      text in native characters,
+ *      zero-padded to a multiple of 4
+ *
+ * The text starts 4-byte aligned, so a serialized URI in suitably
+ * aligned memory can be pointed into, and a sequence of them as well.
+ */
+#ifndef URI_SERIAL_HEADER_SIZE
+# define URI_SERIAL_VERSION        1
+# define URI_SERIAL_HEADER_SIZE    84
+# define URI_SERIAL_RANGE_COUNT    6
+# define URI_SERIAL_NULL           0xFFFFFFFFUL
+# define URI_SERIAL_ABSOLUTE_PATH  0x01  /* Flag */
+# define URI_SERIAL_HOST_REGNAME   0
+# define URI_SERIAL_HOST_IP4       1
+# define URI_SERIAL_HOST_IP6       2
+# define URI_SERIAL_HOST_IPFUTURE  3
+#endif
+
+
+
+static void URI_FUNC(WriteUint32)(unsigned char * dest, unsigned long value) {
+	dest[0] = (unsigned char)(value & 0xFF);
+	dest[1] = (unsigned char)((value >> 8) & 0xFF);
+	dest[2] = (unsigned char)((value >> 16) & 0xFF);
+	dest[3] = (unsigned char)((value >> 24) & 0xFF);
+}
+
+
+
+static unsigned long URI_FUNC(ReadUint32)(const unsigned char * source) {
+	return (unsigned long)source[0]
+			| ((unsigned long)source[1] << 8)
+			| ((unsigned long)source[2] << 16)
+			| ((unsigned long)source[3] << 24);
+}
+
+
+
+/*
+ * Appends a range to the text and its offset and length to entry.
+ * A NULL range keeps its NULL-ness, an empty range does not.
+ */
+static void URI_FUNC(WriteRange)(unsigned char * entry, unsigned char * text,
+		int * textLength, const URI_TYPE(TextRange) * range) {
+	const int length = URI_FUNC(RangeLength)(range);
+	if (range->first == NULL) {
+		URI_FUNC(WriteUint32)(entry, URI_SERIAL_NULL);
+		URI_FUNC(WriteUint32)(entry + 4, 0);
+		return;
+	}
+	memcpy(text + *textLength * sizeof(URI_CHAR), range->first,
+			length * sizeof(URI_CHAR));
+	URI_FUNC(WriteUint32)(entry, (unsigned long)*textLength);
+	URI_FUNC(WriteUint32)(entry + 4, (unsigned long)length);
+	*textLength += length;
+}
+
+
+
+/*
+ * Points range into text, with bounds checked so that
+ * corrupt input cannot make us point outside the buffer.
+ */
+static UriBool URI_FUNC(ReadRange)(URI_TYPE(TextRange) * range,
+		const unsigned char * entry, const URI_CHAR * text,
+		unsigned long textLength) {
+	const unsigned long offset = URI_FUNC(ReadUint32)(entry);
+	const unsigned long length = URI_FUNC(ReadUint32)(entry + 4);
+	if (offset == URI_SERIAL_NULL) {
+		range->first = NULL;
+		range->afterLast = NULL;
+		return (length == 0) ? URI_TRUE : URI_FALSE;
+	}
+	if ((offset > textLength) || (length > textLength - offset)) {
+		return URI_FALSE;
+	}
+	range->first = text + offset;
+	range->afterLast = text + offset + length;
+	return URI_TRUE;
+}
+
+
+
+static int URI_FUNC(SerializedSize)(const URI_TYPE(Uri) * uri,
+		int * textLength, int * segmentCount) {
+	const URI_TYPE(PathSegment) * walker;
+	size_t bytes;
+	size_t chars = (size_t)URI_FUNC(RangeLength)(&(uri->scheme))
+			+ URI_FUNC(RangeLength)(&(uri->userInfo))
+			+ URI_FUNC(RangeLength)(&(uri->hostText))
+			+ URI_FUNC(RangeLength)(&(uri->portText))
+			+ URI_FUNC(RangeLength)(&(uri->query))
+			+ URI_FUNC(RangeLength)(&(uri->fragment));
+	size_t segments = 0;
+
+	for (walker = uri->pathHead; walker != NULL; walker = walker->next) {
+		chars += URI_FUNC(RangeLength)(&(walker->text));
+		segments++;
+	}
+
+	bytes = URI_SERIAL_HEADER_SIZE + 8 * segments + chars * sizeof(URI_CHAR);
+	bytes = (bytes + 3) & ~(size_t)3;
+	if (bytes > (size_t)INT_MAX) {
+		return -1;
+	}
+	*textLength = (int)chars;
+	*segmentCount = (int)segments;
+	return (int)bytes;
+}
+
+
+
+int URI_FUNC(SerializeUriBytesRequired)(const URI_TYPE(Uri) * uri,
+		int * bytesRequired) {
+	int textLength;
+	int segmentCount;
+	int bytes;
+
+	if ((uri == NULL) || (bytesRequired == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	bytes = URI_FUNC(SerializedSize)(uri, &textLength, &segmentCount);
+	if (bytes < 0) {
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+	*bytesRequired = bytes;
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(SerializeUri)(void * dest, const URI_TYPE(Uri) * uri,
+		int maxBytes, int * bytesWritten) {
+	unsigned char * const out = (unsigned char *)dest;
+	const URI_TYPE(PathSegment) * walker;
+	unsigned char * entry;
+	unsigned char * text;
+	int textLength;
+	int segmentCount;
+	int written = 0;
+	int bytes;
+	int hostType = URI_SERIAL_HOST_REGNAME;
+
+	if ((dest == NULL) || (uri == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	bytes = URI_FUNC(SerializedSize)(uri, &textLength, &segmentCount);
+	if ((bytes < 0) || (bytes > maxBytes)) {
+		if (bytesWritten != NULL) {
+			*bytesWritten = 0;
+		}
+		return URI_ERROR_OUTPUT_TOO_LARGE;
+	}
+
+	memset(out, 0, bytes);
+	out[0] = 'U';
+	out[1] = 'R';
+	out[2] = 'I';
+	out[3] = URI_SERIAL_VERSION;
+	out[4] = (unsigned char)sizeof(URI_CHAR);
+	out[5] = uri->absolutePath ? URI_SERIAL_ABSOLUTE_PATH : 0;
+	if (uri->hostData.ip4 != NULL) {
+		hostType = URI_SERIAL_HOST_IP4;
+		memcpy(out + 68, uri->hostData.ip4->data, 4);
+	} else if (uri->hostData.ip6 != NULL) {
+		hostType = URI_SERIAL_HOST_IP6;
+		memcpy(out + 68, uri->hostData.ip6->data, 16);
+	} else if (uri->hostData.ipFuture.first != NULL) {
+		hostType = URI_SERIAL_HOST_IPFUTURE;
+	}
+	out[6] = (unsigned char)hostType;
+	URI_FUNC(WriteUint32)(out + 8, (unsigned long)bytes);
+	URI_FUNC(WriteUint32)(out + 12, (unsigned long)textLength);
+	URI_FUNC(WriteUint32)(out + 16, (unsigned long)segmentCount);
+
+	text = out + URI_SERIAL_HEADER_SIZE + 8 * segmentCount;
+	URI_FUNC(WriteRange)(out + 20, text, &written, &(uri->scheme));
+	URI_FUNC(WriteRange)(out + 28, text, &written, &(uri->userInfo));
+	URI_FUNC(WriteRange)(out + 36, text, &written, &(uri->hostText));
+	URI_FUNC(WriteRange)(out + 44, text, &written, &(uri->portText));
+	entry = out + URI_SERIAL_HEADER_SIZE;
+	for (walker = uri->pathHead; walker != NULL; walker = walker->next) {
+		URI_FUNC(WriteRange)(entry, text, &written, &(walker->text));
+		entry += 8;
+	}
+	URI_FUNC(WriteRange)(out + 52, text, &written, &(uri->query));
+	URI_FUNC(WriteRange)(out + 60, text, &written, &(uri->fragment));
+
+	if (bytesWritten != NULL) {
+		*bytesWritten = bytes;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(DeserializeUriMm)(URI_TYPE(Uri) * uri, const void * data,
+		int size, int * bytesRead, UriMemoryManager * memory) {
+	const unsigned char * const in = (const unsigned char *)data;
+	const URI_CHAR * text;
+	const unsigned char * entry;
+	unsigned long total;
+	unsigned long textLength;
+	unsigned long segmentCount;
+	unsigned long i;
+	int hostType;
+
+	if ((uri == NULL) || (data == NULL)) {
+		return URI_ERROR_NULL;
+	}
+	URI_CHECK_MEMORY_MANAGER(memory);  /* may return */
+
+	/* Check the header, ranges are checked one by one below */
+	if ((size < URI_SERIAL_HEADER_SIZE)
+			|| ((size_t)in % sizeof(URI_CHAR) != 0)
+			|| (in[0] != 'U') || (in[1] != 'R') || (in[2] != 'I')
+			|| (in[3] != URI_SERIAL_VERSION)
+			|| ((size_t)in[4] != sizeof(URI_CHAR))
+			|| ((in[5] & ~URI_SERIAL_ABSOLUTE_PATH) != 0)
+			|| (in[6] > URI_SERIAL_HOST_IPFUTURE)) {
+		return URI_ERROR_DESERIALIZE_MALFORMED;
+	}
+	total = URI_FUNC(ReadUint32)(in + 8);
+	textLength = URI_FUNC(ReadUint32)(in + 12);
+	segmentCount = URI_FUNC(ReadUint32)(in + 16);
+	if ((total > (unsigned long)size)
+			|| (total < URI_SERIAL_HEADER_SIZE)
+			|| ((total & 3) != 0)
+			|| (segmentCount > (total - URI_SERIAL_HEADER_SIZE) / 8)
+			|| (textLength > (total - URI_SERIAL_HEADER_SIZE - 8 * segmentCount)
+				/ sizeof(URI_CHAR))) {
+		return URI_ERROR_DESERIALIZE_MALFORMED;
+	}
+	hostType = in[6];
+	text = (const URI_CHAR *)(const void *)(in + URI_SERIAL_HEADER_SIZE
+			+ 8 * segmentCount);
+
+	URI_FUNC(ResetUri)(uri);
+	if (!URI_FUNC(ReadRange)(&(uri->scheme), in + 20, text, textLength)
+			|| !URI_FUNC(ReadRange)(&(uri->userInfo), in + 28, text, textLength)
+			|| !URI_FUNC(ReadRange)(&(uri->hostText), in + 36, text, textLength)
+			|| !URI_FUNC(ReadRange)(&(uri->portText), in + 44, text, textLength)
+			|| !URI_FUNC(ReadRange)(&(uri->query), in + 52, text, textLength)
+			|| !URI_FUNC(ReadRange)(&(uri->fragment), in + 60, text, textLength)
+			|| ((hostType != URI_SERIAL_HOST_REGNAME)
+				&& (uri->hostText.first == NULL))) {
+		URI_FUNC(ResetUri)(uri);
+		return URI_ERROR_DESERIALIZE_MALFORMED;
+	}
+	uri->absolutePath = (in[5] & URI_SERIAL_ABSOLUTE_PATH) ? URI_TRUE : URI_FALSE;
+	uri->owner = URI_FALSE;
+
+	/* From here on the URI owns memory, released by FreeUriMembersMm */
+	switch (hostType) {
+	case URI_SERIAL_HOST_IP4:
+		uri->hostData.ip4 = memory->malloc(memory, sizeof(UriIp4));
+		if (uri->hostData.ip4 == NULL) {
+			return URI_ERROR_MALLOC;
+		}
+		memcpy(uri->hostData.ip4->data, in + 68, 4);
+		break;
+
+	case URI_SERIAL_HOST_IP6:
+		uri->hostData.ip6 = memory->malloc(memory, sizeof(UriIp6));
+		if (uri->hostData.ip6 == NULL) {
+			return URI_ERROR_MALLOC;
+		}
+		memcpy(uri->hostData.ip6->data, in + 68, 16);
+		break;
+
+	case URI_SERIAL_HOST_IPFUTURE:
+		uri->hostData.ipFuture = uri->hostText;
+		break;
+
+	default:
+		break;
+	}
+
+	entry = in + URI_SERIAL_HEADER_SIZE;
+	for (i = 0; i < segmentCount; i++, entry += 8) {
+		URI_TYPE(PathSegment) * const segment
+				= memory->malloc(memory, sizeof(URI_TYPE(PathSegment)));
+		if (segment == NULL) {
+			URI_FUNC(FreeUriMembersMm)(uri, memory);
+			return URI_ERROR_MALLOC;
+		}
+		segment->next = NULL;
+		segment->reserved = NULL;
+		if (uri->pathTail == NULL) {
+			uri->pathHead = segment;
+		} else {
+			uri->pathTail->next = segment;
+		}
+		uri->pathTail = segment;
+		if (!URI_FUNC(ReadRange)(&(segment->text), entry, text, textLength)
+				|| (segment->text.first == NULL)) {
+			segment->text.first = text;
+			segment->text.afterLast = text;
+			URI_FUNC(FreeUriMembersMm)(uri, memory);
+			return URI_ERROR_DESERIALIZE_MALFORMED;
+		}
+	}
+
+	if (bytesRead != NULL) {
+		*bytesRead = (int)total;
+	}
+	return URI_SUCCESS;
+}
+
+
+
+int URI_FUNC(DeserializeUri)(URI_TYPE(Uri) * uri, const void * data,
+		int size, int * bytesRead) {
+	return URI_FUNC(DeserializeUriMm)(uri, data, size, bytesRead, NULL);
+}
+
+
+
+#endif
@@ -39,13 +39,19 @@
 /**
  * @file UriSetHostCommon.c
  * Holds code used by multiple SetHost* functions.
- * NOTE: This source file includes itself twice.
+ * NOTE: This source file includes itself once per encoding.
  */
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriSetHostCommon.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriSetHostCommon.c"
@@ -59,9 +65,11 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -71,7 +79,6 @@
 # include <uriparser/UriIp4.h>
 # include "UriCommon.h"
 # include "UriMemory.h"
-# include "UriSetHostBase.h"
 # include "UriSetHostCommon.h"
 #endif
 
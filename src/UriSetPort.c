@@ -38,8 +38,14 @@
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriSetPort.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriSetPort.c"
@@ -53,9 +59,11 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -106,6 +114,42 @@ UriBool URI_FUNC(IsWellFormedPort)(const URI_CHAR * first, const URI_CHAR * afte
 
 
 
+int URI_FUNC(ParsePortValue)(unsigned int * value,
+		const URI_CHAR * first, const URI_CHAR * afterLast) {
+	unsigned int sum = 0;
+	UriBool overflow = URI_FALSE;
+
+	if ((value == NULL) || (first == NULL) || (afterLast == NULL)) {
+		return URI_ERROR_NULL;
+	}
+
+	*value = 0;
+
+	for (; first < afterLast; first++) {
+		switch (first[0]) {
+			case URI_SET_DIGIT:
+				if (!overflow) {
+					sum = 10 * sum + (unsigned int)(first[0] - _UT('0'));
+					if (sum > 65535) {
+						overflow = URI_TRUE;  /* and keep validating */
+					}
+				}
+				break;
+			default:
+				return URI_ERROR_SYNTAX;
+		}
+	}
+
+	if (overflow) {
+		return URI_ERROR_PORT_OUT_OF_RANGE;
+	}
+
+	*value = sum;
+	return URI_SUCCESS;
+}
+
+
+
 int URI_FUNC(SetPortTextMm)(URI_TYPE(Uri) * uri,
 		const URI_CHAR * first,
 		const URI_CHAR * afterLast,
@@ -39,13 +39,19 @@
 /**
  * @file UriVersion.c
  * Implements a runtime version getter.
- * NOTE: This source file includes itself twice.
+ * NOTE: This source file includes itself once per encoding.
  */
 
 /* What encodings are enabled? */
 #include <uriparser/UriDefsConfig.h>
-#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE))
-/* Include SELF twice */
+#if (!defined(URI_PASS_ANSI) && !defined(URI_PASS_UNICODE) \
+	&& !defined(URI_PASS_CHAR16_T))
+/* Include SELF once per encoding */
+# ifdef URI_ENABLE_CHAR16_T
+#  define URI_PASS_CHAR16_T 1
+#  include "UriVersion.c"
+#  undef URI_PASS_CHAR16_T
+# endif
 # ifdef URI_ENABLE_ANSI
 #  define URI_PASS_ANSI 1
 #  include "UriVersion.c"
@@ -59,9 +65,11 @@
 #else
 # ifdef URI_PASS_ANSI
 #  include <uriparser/UriDefsAnsi.h>
-# else
+# elif defined(URI_PASS_UNICODE)
 #  include <uriparser/UriDefsUnicode.h>
 #  include <wchar.h>
+# else
+#  include <uriparser/UriDefsChar16.h>
 # endif
 
 
@@ -77,8 +85,10 @@ const URI_CHAR * URI_FUNC(BaseRuntimeVersion)(void) {
 	return URI_VER_ANSI;
 #elif defined(URI_PASS_UNICODE)
 	return URI_VER_UNICODE;
+#elif defined(URI_PASS_CHAR16_T)
+	return u"" URI_VER_ANSI;  /* the prefix carries over when concatenating */
 #else
-# error Either URI_PASS_ANSI or URI_PASS_UNICODE must be defined
+# error One of URI_PASS_ANSI, URI_PASS_UNICODE or URI_PASS_CHAR16_T must be defined
 #endif
 }
 
@@ -0,0 +1,241 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+bool isValid(const UriBatchColumnA & column, int row) {
+	return (column.validity[row / 8] & (1 << (row % 8))) != 0;
+}
+
+// Value of a row, "<null>" for null
+std::string value(const UriBatchA & batch, UriBatchColumnId id, int row) {
+	const UriBatchColumnA & column = batch.columns[id];
+	if (!isValid(column, row)) {
+		return "<null>";
+	}
+	const int index = (column.indices != NULL) ? column.indices[row] : row;
+	return std::string(column.values + column.offsets[index],
+			column.values + column.offsets[index + 1]);
+}
+
+void append(UriBatchA & batch, const char * text) {
+	ASSERT_EQ(uriParseIntoBatchA(&batch, text, NULL, NULL), URI_SUCCESS) << text;
+}
+
+// Hands out memory full of set bits, so uninitialized bytes show
+void * poisonedMalloc(UriMemoryManager * /*memory*/, size_t size) {
+	void * const buffer = malloc(size);
+	if (buffer != NULL) {
+		memset(buffer, 0xff, size);
+	}
+	return buffer;
+}
+
+void plainFree(UriMemoryManager * /*memory*/, void * ptr) {
+	free(ptr);
+}
+
+}  // namespace
+
+
+
+TEST(BatchSuite, Columns) {
+	UriBatchA batch;
+	ASSERT_EQ(uriInitBatchA(&batch, URI_BATCH_PLAIN), URI_SUCCESS);
+	append(batch, "http://user@example.com:8080/a/b?q=1#top");
+	append(batch, "mailto:someone@example.com");
+	append(batch, "//[::1]/?");
+	append(batch, "relative/path#");
+	append(batch, "file:///");
+	ASSERT_EQ(batch.count, 5);
+
+	EXPECT_EQ(value(batch, URI_COLUMN_SCHEME, 0), "http");
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 0), "example.com");
+	EXPECT_EQ(value(batch, URI_COLUMN_PORT, 0), "8080");
+	EXPECT_EQ(value(batch, URI_COLUMN_PATH, 0), "/a/b");
+	EXPECT_EQ(value(batch, URI_COLUMN_QUERY, 0), "q=1");
+	EXPECT_EQ(value(batch, URI_COLUMN_FRAGMENT, 0), "top");
+
+	EXPECT_EQ(value(batch, URI_COLUMN_SCHEME, 1), "mailto");
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 1), "<null>");
+	EXPECT_EQ(value(batch, URI_COLUMN_PATH, 1), "someone@example.com");
+
+	EXPECT_EQ(value(batch, URI_COLUMN_SCHEME, 2), "<null>");
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 2), "::1");
+	EXPECT_EQ(value(batch, URI_COLUMN_PORT, 2), "<null>");
+	EXPECT_EQ(value(batch, URI_COLUMN_PATH, 2), "/");
+	EXPECT_EQ(value(batch, URI_COLUMN_QUERY, 2), "");
+
+	EXPECT_EQ(value(batch, URI_COLUMN_PATH, 3), "relative/path");
+	EXPECT_EQ(value(batch, URI_COLUMN_QUERY, 3), "<null>");
+	EXPECT_EQ(value(batch, URI_COLUMN_FRAGMENT, 3), "");
+
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 4), "");
+	EXPECT_EQ(value(batch, URI_COLUMN_PATH, 4), "/");
+
+	EXPECT_EQ(batch.columns[URI_COLUMN_SCHEME].nullCount, 2);
+	EXPECT_EQ(batch.columns[URI_COLUMN_HOST].nullCount, 2);
+	EXPECT_EQ(batch.columns[URI_COLUMN_PORT].nullCount, 4);
+	EXPECT_EQ(batch.columns[URI_COLUMN_PATH].nullCount, 0);
+	EXPECT_EQ(batch.columns[URI_COLUMN_QUERY].nullCount, 3);
+	EXPECT_EQ(batch.columns[URI_COLUMN_FRAGMENT].nullCount, 3);
+
+	uriFreeBatchMembersA(&batch);
+}
+
+TEST(BatchSuite, ArrowLayout) {
+	UriBatchA batch;
+	ASSERT_EQ(uriInitBatchA(&batch, URI_BATCH_PLAIN), URI_SUCCESS);
+	append(batch, "https://a.example/");
+	append(batch, "/x");
+	append(batch, "https://bb.example/");
+
+	// Offsets of null values repeat, values are back to back
+	const UriBatchColumnA & host = batch.columns[URI_COLUMN_HOST];
+	EXPECT_EQ(host.offsets[0], 0);
+	EXPECT_EQ(host.offsets[1], 9);
+	EXPECT_EQ(host.offsets[2], 9);
+	EXPECT_EQ(host.offsets[3], 19);
+	EXPECT_EQ(std::string(host.values, host.values + 19), "a.examplebb.example");
+	EXPECT_EQ(host.validity[0] & 0x07, 0x05);
+	EXPECT_TRUE(host.indices == NULL);
+	EXPECT_EQ(host.dictionaryCount, 0);
+
+	uriFreeBatchMembersA(&batch);
+}
+
+TEST(BatchSuite, Dictionary) {
+	UriBatchA batch;
+	char text[64];
+	ASSERT_EQ(uriInitBatchA(&batch,
+			URI_BATCH_DICTIONARY_SCHEME | URI_BATCH_DICTIONARY_HOST), URI_SUCCESS);
+	for (int i = 0; i < 1000; i++) {
+		std::snprintf(text, sizeof(text), "%s://host%d.example/%d",
+				(i % 3 == 0) ? "http" : "https", i % 100, i);
+		append(batch, text);
+	}
+	append(batch, "/no/scheme/no/host");
+	ASSERT_EQ(batch.count, 1001);
+
+	const UriBatchColumnA & scheme = batch.columns[URI_COLUMN_SCHEME];
+	const UriBatchColumnA & host = batch.columns[URI_COLUMN_HOST];
+	EXPECT_EQ(scheme.dictionaryCount, 2);
+	EXPECT_EQ(host.dictionaryCount, 100);
+	EXPECT_EQ(scheme.nullCount, 1);
+	EXPECT_EQ(host.nullCount, 1);
+	EXPECT_EQ(scheme.indices[0], 0);
+	EXPECT_EQ(scheme.indices[1], 1);
+	EXPECT_EQ(scheme.indices[3], 0);
+	EXPECT_EQ(host.indices[100], host.indices[0]);
+	EXPECT_EQ(host.indices[1000], 0);
+	EXPECT_EQ(value(batch, URI_COLUMN_SCHEME, 3), "http");
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 357), "host57.example");
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 1000), "<null>");
+	EXPECT_EQ(value(batch, URI_COLUMN_PATH, 357), "/357");
+	EXPECT_TRUE(batch.columns[URI_COLUMN_PATH].indices == NULL);
+
+	uriFreeBatchMembersA(&batch);
+}
+
+TEST(BatchSuite, ClearKeepsMemory) {
+	UriBatchA batch;
+	ASSERT_EQ(uriInitBatchA(&batch, URI_BATCH_DICTIONARY_HOST), URI_SUCCESS);
+	append(batch, "http://a.example/1");
+	append(batch, "http://b.example/2");
+	const int * const offsets = batch.columns[URI_COLUMN_PATH].offsets;
+
+	uriClearBatchA(&batch);
+	EXPECT_EQ(batch.count, 0);
+	EXPECT_EQ(batch.columns[URI_COLUMN_HOST].dictionaryCount, 0);
+
+	append(batch, "http://b.example/3");
+	EXPECT_EQ(batch.columns[URI_COLUMN_PATH].offsets, offsets);
+	EXPECT_EQ(batch.columns[URI_COLUMN_HOST].dictionaryCount, 1);
+	EXPECT_EQ(batch.columns[URI_COLUMN_HOST].indices[0], 0);
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 0), "b.example");
+	EXPECT_EQ(value(batch, URI_COLUMN_PATH, 0), "/3");
+
+	uriFreeBatchMembersA(&batch);
+	EXPECT_EQ(batch.count, 0);
+	append(batch, "http://c.example/");  // reusable after freeing
+	EXPECT_EQ(value(batch, URI_COLUMN_HOST, 0), "c.example");
+	uriFreeBatchMembersA(&batch);
+}
+
+TEST(BatchSuite, GrownValidityIsZeroed) {
+	UriMemoryManager backend;
+	UriMemoryManager memory;
+	UriBatchA batch;
+	memset(&backend, 0, sizeof(UriMemoryManager));
+	backend.malloc = poisonedMalloc;
+	backend.free = plainFree;
+	ASSERT_EQ(uriCompleteMemoryManager(&memory, &backend), URI_SUCCESS);
+	ASSERT_EQ(uriInitBatchMmA(&batch, URI_BATCH_PLAIN, &memory), URI_SUCCESS);
+
+	// 64 rows fill the first allocation, row 64 grows it
+	for (int i = 0; i < 65; i++) {
+		append(batch, "/x");
+	}
+
+	// Padding bits past the last row stay clear, as Arrow expects
+	const UriBatchColumnA & host = batch.columns[URI_COLUMN_HOST];
+	const UriBatchColumnA & path = batch.columns[URI_COLUMN_PATH];
+	EXPECT_EQ(host.validity[8], 0x00);
+	EXPECT_EQ(path.validity[8], 0x01);
+	EXPECT_EQ(host.nullCount, 65);
+
+	uriFreeBatchMembersA(&batch);
+}
+
+TEST(BatchSuite, SyntaxError) {
+	UriBatchA batch;
+	const char * errorPos = NULL;
+	const char * const text = "http://a b/";
+	ASSERT_EQ(uriInitBatchA(&batch, URI_BATCH_PLAIN), URI_SUCCESS);
+	EXPECT_EQ(uriParseIntoBatchA(&batch, text, NULL, &errorPos), URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, text + 8);
+	EXPECT_EQ(batch.count, 0);
+	uriFreeBatchMembersA(&batch);
+}
+
+TEST(BatchSuite, Wide) {
+	UriBatchW batch;
+	ASSERT_EQ(uriInitBatchW(&batch, URI_BATCH_DICTIONARY_HOST), URI_SUCCESS);
+	ASSERT_EQ(uriParseIntoBatchW(&batch, L"http://example.com/a?b", NULL, NULL),
+			URI_SUCCESS);
+	const UriBatchColumnW & host = batch.columns[URI_COLUMN_HOST];
+	const UriBatchColumnW & query = batch.columns[URI_COLUMN_QUERY];
+	EXPECT_EQ(std::wstring(host.values + host.offsets[host.indices[0]],
+			host.values + host.offsets[host.indices[0] + 1]), L"example.com");
+	EXPECT_EQ(std::wstring(query.values + query.offsets[0],
+			query.values + query.offsets[1]), L"b");
+	uriFreeBatchMembersW(&batch);
+}
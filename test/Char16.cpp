@@ -0,0 +1,268 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstring>
+#include <string>
+#include <gtest/gtest.h>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+std::u16string widen(const char * text) {
+	std::u16string res;
+	for (; *text != '\0'; text++) {
+		res += static_cast<char16_t>(static_cast<unsigned char>(*text));
+	}
+	return res;
+}
+
+std::u16string toString(const UriTextRangeU16 & range) {
+	if (range.first == NULL) {
+		return std::u16string();
+	}
+	return std::u16string(range.first, range.afterLast);
+}
+
+std::string toString(const UriTextRangeA & range) {
+	if (range.first == NULL) {
+		return std::string();
+	}
+	return std::string(range.first, range.afterLast);
+}
+
+void expectSameRange(const UriTextRangeA & a, const UriTextRangeU16 & u16) {
+	EXPECT_EQ(a.first == NULL, u16.first == NULL);
+	EXPECT_EQ(widen(toString(a).c_str()), toString(u16));
+}
+
+}  // namespace
+
+
+
+TEST(Char16Suite, ParseSingleUri) {
+	const char16_t * const text = u"http://user@example.org:8080/one/two?q=1#frag";
+	UriUriU16 uri;
+
+	ASSERT_EQ(uriParseSingleUriU16(&uri, text, NULL), URI_SUCCESS);
+	EXPECT_EQ(toString(uri.scheme), u"http");
+	EXPECT_EQ(toString(uri.userInfo), u"user");
+	EXPECT_EQ(toString(uri.hostText), u"example.org");
+	EXPECT_EQ(toString(uri.portText), u"8080");
+	ASSERT_TRUE(uri.pathHead != NULL);
+	EXPECT_EQ(toString(uri.pathHead->text), u"one");
+	ASSERT_TRUE(uri.pathHead->next != NULL);
+	EXPECT_EQ(toString(uri.pathHead->next->text), u"two");
+	EXPECT_EQ(toString(uri.query), u"q=1");
+	EXPECT_EQ(toString(uri.fragment), u"frag");
+	uriFreeUriMembersU16(&uri);
+}
+
+
+
+TEST(Char16Suite, ParseMatchesAnsi) {
+	const char * const cases[] = {
+		"http://[2001:db8::1]:80/a/../b/./c",
+		"http://192.168.0.1/",
+		"http://[v7.future]/",
+		"mailto:user@example.org",
+		"//host/path?q#f",
+		"../relative/path",
+		"file:///C:/windows/path",
+		"http://example.org/%7Euser/a%20b",
+		"",
+		// Invalid ones, error positions need to match
+		"http://exa mple.org/",
+		"http://[::1/",
+		"http://example.org/%zz",
+		"1http:",
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		const char * const textA = cases[i];
+		const std::u16string textU16 = widen(textA);
+		UriUriA uriA;
+		UriUriU16 uriU16;
+		const char * errorPosA = NULL;
+		const char16_t * errorPosU16 = NULL;
+
+		const int resA = uriParseSingleUriA(&uriA, textA, &errorPosA);
+		const int resU16 = uriParseSingleUriU16(&uriU16, textU16.c_str(),
+				&errorPosU16);
+		ASSERT_EQ(resA, resU16) << textA;
+		if (resA != URI_SUCCESS) {
+			EXPECT_EQ(errorPosA - textA, errorPosU16 - textU16.c_str()) << textA;
+			continue;
+		}
+
+		expectSameRange(uriA.scheme, uriU16.scheme);
+		expectSameRange(uriA.userInfo, uriU16.userInfo);
+		expectSameRange(uriA.hostText, uriU16.hostText);
+		expectSameRange(uriA.portText, uriU16.portText);
+		expectSameRange(uriA.query, uriU16.query);
+		expectSameRange(uriA.fragment, uriU16.fragment);
+		EXPECT_EQ(uriA.absolutePath, uriU16.absolutePath);
+		EXPECT_EQ(uriA.hostData.ip4 != NULL, uriU16.hostData.ip4 != NULL);
+		EXPECT_EQ(uriA.hostData.ip6 != NULL, uriU16.hostData.ip6 != NULL);
+
+		const UriPathSegmentA * segA = uriA.pathHead;
+		const UriPathSegmentU16 * segU16 = uriU16.pathHead;
+		for (; (segA != NULL) && (segU16 != NULL);
+				segA = segA->next, segU16 = segU16->next) {
+			expectSameRange(segA->text, segU16->text);
+		}
+		EXPECT_TRUE((segA == NULL) && (segU16 == NULL)) << textA;
+
+		uriFreeUriMembersA(&uriA);
+		uriFreeUriMembersU16(&uriU16);
+	}
+}
+
+
+
+TEST(Char16Suite, NonAsciiIsRejected) {
+	// UTF-16 surrogates and other non-ASCII code units are not URI characters
+	const char16_t * const cases[] = {
+		u"http://example.org/\u00e4",
+		u"http://example.org/\xd83d\xde00",
+		u"http://\u4f8b.example/",
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		UriUriU16 uri;
+		const char16_t * errorPos = NULL;
+
+		ASSERT_EQ(uriParseSingleUriU16(&uri, cases[i], &errorPos),
+				URI_ERROR_SYNTAX);
+		ASSERT_TRUE(errorPos != NULL);
+		EXPECT_GT(static_cast<unsigned int>(*errorPos), 0x7fU);
+	}
+}
+
+
+
+TEST(Char16Suite, NormalizeResolveRecompose) {
+	UriUriU16 base;
+	UriUriU16 relative;
+	UriUriU16 resolved;
+	char16_t buffer[64];
+	int charsRequired = 0;
+
+	ASSERT_EQ(uriParseSingleUriU16(&base, u"HTTP://Example.ORG/a/b/c", NULL),
+			URI_SUCCESS);
+	ASSERT_EQ(uriParseSingleUriU16(&relative, u"../%7e/./d?q", NULL),
+			URI_SUCCESS);
+	ASSERT_EQ(uriAddBaseUriU16(&resolved, &relative, &base), URI_SUCCESS);
+	ASSERT_EQ(uriNormalizeSyntaxU16(&resolved), URI_SUCCESS);
+
+	ASSERT_EQ(uriToStringCharsRequiredU16(&resolved, &charsRequired),
+			URI_SUCCESS);
+	ASSERT_LT(charsRequired, 64);
+	ASSERT_EQ(uriToStringU16(buffer, &resolved, 64, NULL), URI_SUCCESS);
+	EXPECT_EQ(std::u16string(buffer), u"http://example.org/a/~/d?q");
+
+	uriFreeUriMembersU16(&base);
+	uriFreeUriMembersU16(&relative);
+	uriFreeUriMembersU16(&resolved);
+}
+
+
+
+TEST(Char16Suite, EscapeAndQuery) {
+	const std::u16string input = u"a b&c=d\u00e4";
+	char16_t escaped[3 * 16 + 1];
+	UriQueryListU16 * queryList = NULL;
+	int itemCount = 0;
+	char16_t * composed = NULL;
+
+	uriEscapeExU16(input.c_str(), input.c_str() + 7, escaped, URI_TRUE,
+			URI_FALSE);
+	EXPECT_EQ(std::u16string(escaped), u"a+b%26c%3Dd");
+
+	ASSERT_EQ(uriDissectQueryMallocU16(&queryList, &itemCount,
+			escaped, escaped + std::char_traits<char16_t>::length(escaped)),
+			URI_SUCCESS);
+	ASSERT_EQ(itemCount, 1);
+	EXPECT_EQ(std::u16string(queryList->key), u"a b&c=d");
+	EXPECT_TRUE(queryList->value == NULL);
+
+	ASSERT_EQ(uriComposeQueryMallocU16(&composed, queryList), URI_SUCCESS);
+	EXPECT_EQ(std::u16string(composed), u"a+b%26c%3Dd");
+	free(composed);
+	uriFreeQueryListU16(queryList);
+
+	char16_t unescaped[] = u"%41%20b";
+	uriUnescapeInPlaceU16(unescaped);
+	EXPECT_EQ(std::u16string(unescaped), u"A b");
+}
+
+
+
+TEST(Char16Suite, UnixFilename) {
+	char16_t uriString[7 + 3 * 16 + 1];
+	char16_t filename[16 + 1];
+
+	ASSERT_EQ(uriUnixFilenameToUriStringU16(u"/tmp/a b", uriString),
+			URI_SUCCESS);
+	EXPECT_EQ(std::u16string(uriString), u"file:///tmp/a%20b");
+	ASSERT_EQ(uriUriStringToUnixFilenameU16(uriString, filename),
+			URI_SUCCESS);
+	EXPECT_EQ(std::u16string(filename), u"/tmp/a b");
+}
+
+
+
+namespace {
+
+UriBool collectHost(void * userData, const UriUriU16 * uri,
+		const char16_t * /*first*/, const char16_t * /*afterLast*/,
+		int /*errorCode*/, const char16_t * /*errorPos*/) {
+	if (uri != NULL) {
+		static_cast<std::u16string *>(userData)->append(toString(uri->hostText))
+				.append(u",");
+	}
+	return URI_TRUE;
+}
+
+}  // namespace
+
+
+
+TEST(Char16Suite, ListAndFind) {
+	const std::u16string list = u"http://a.example/\r\n\nnot a uri\nhttp://b.example/";
+	std::u16string hosts;
+
+	ASSERT_EQ(uriParseUriListExU16(list.c_str(), list.c_str() + list.size(),
+			URI_LIST_LINES, collectHost, &hosts), URI_SUCCESS);
+	EXPECT_EQ(hosts, u"a.example,b.example,");
+
+	const std::u16string prose = u"See https://example.org/x. Thanks!";
+	UriTextRangeU16 found;
+	ASSERT_EQ(uriFindUriExU16(NULL, prose.c_str(), prose.c_str() + prose.size(),
+			&found), URI_SUCCESS);
+	EXPECT_EQ(toString(found), u"https://example.org/x");
+}
+
+
+
+TEST(Char16Suite, Version) {
+	EXPECT_EQ(widen(uriBaseRuntimeVersionA()),
+			std::u16string(uriBaseRuntimeVersionU16()));
+}
@@ -0,0 +1,300 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+// Sorted, more than one block of 16
+std::vector<std::string> sitemap() {
+	std::vector<std::string> uris;
+	for (char c = 'a'; c <= 'z'; c++) {
+		uris.push_back(std::string("https://example.com/docs/") + c);
+		uris.push_back(std::string("https://example.com/docs/") + c + "/index.html");
+	}
+	uris.push_back("https://example.org/");
+	return uris;
+}
+
+std::vector<UriTextRangeA> ranges(const std::vector<std::string> & uris) {
+	std::vector<UriTextRangeA> result(uris.size());
+	for (size_t i = 0; i < uris.size(); i++) {
+		result[i].first = uris[i].c_str();
+		result[i].afterLast = uris[i].c_str() + uris[i].size();
+	}
+	return result;
+}
+
+UriCompressedSetA * build(const std::vector<std::string> & uris) {
+	const std::vector<UriTextRangeA> input = ranges(uris);
+	UriCompressedSetA * set = NULL;
+	EXPECT_EQ(uriBuildCompressedSetA(&set, input.empty() ? NULL : &input[0],
+			static_cast<int>(input.size()), NULL), URI_SUCCESS);
+	return set;
+}
+
+std::string get(const UriCompressedSetA * set, int index) {
+	char dest[256];
+	int charsWritten = -1;
+	EXPECT_EQ(uriCompressedSetGetA(set, index, dest, sizeof(dest), &charsWritten),
+			URI_SUCCESS);
+	return std::string(dest, dest + charsWritten - 1);
+}
+
+UriBool collect(void * userData, const char * first, const char * afterLast,
+		int rank) {
+	std::vector<std::pair<std::string, int> > & found
+			= *static_cast<std::vector<std::pair<std::string, int> > *>(userData);
+	found.push_back(std::make_pair(std::string(first, afterLast), rank));
+	return (found.size() < 3 || found[0].first != "stop") ? URI_TRUE : URI_FALSE;
+}
+
+std::vector<std::pair<std::string, int> > enumerate(const UriCompressedSetA * set,
+		const char * prefix) {
+	std::vector<std::pair<std::string, int> > found;
+	EXPECT_EQ(uriCompressedSetEnumeratePrefixA(set, prefix, NULL, collect, &found),
+			URI_SUCCESS);
+	return found;
+}
+
+}  // namespace
+
+
+
+TEST(CompressedSetSuite, RankAndGet) {
+	const std::vector<std::string> uris = sitemap();
+	UriCompressedSetA * const set = build(uris);
+	ASSERT_TRUE(set != NULL);
+	ASSERT_EQ(uriCompressedSetCountA(set), static_cast<int>(uris.size()));
+
+	for (size_t i = 0; i < uris.size(); i++) {
+		int rank = -1;
+		UriBool contained = URI_FALSE;
+		ASSERT_EQ(uriCompressedSetRankA(set, uris[i].c_str(), NULL, &rank,
+				&contained), URI_SUCCESS);
+		EXPECT_EQ(rank, static_cast<int>(i)) << uris[i];
+		EXPECT_EQ(contained, URI_TRUE) << uris[i];
+		EXPECT_EQ(get(set, static_cast<int>(i)), uris[i]);
+	}
+
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, RankOfAbsent) {
+	const std::vector<std::string> uris = sitemap();
+	UriCompressedSetA * const set = build(uris);
+	ASSERT_TRUE(set != NULL);
+
+	struct {
+		const char * text;
+		int rank;
+	} const cases[] = {
+		{"", 0},
+		{"https://example.com/", 0},
+		{"https://example.com/docs/a/", 1},
+		{"https://example.com/docs/a/index.htm", 1},
+		{"https://example.com/docs/a/index.html5", 2},
+		{"https://example.com/docs/h0", 16},
+		{"https://example.com/docs/i/", 17},
+		{"https://example.com/docs/z/index.html/", 52},
+		{"https://example.net/", 52},
+		{"https://example.org", 52},
+		{"https://example.org/a", 53},
+		{"zzz", 53},
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		int rank = -1;
+		UriBool contained = URI_TRUE;
+		ASSERT_EQ(uriCompressedSetRankA(set, cases[i].text, NULL, &rank,
+				&contained), URI_SUCCESS);
+		EXPECT_EQ(rank, cases[i].rank) << cases[i].text;
+		EXPECT_EQ(contained, URI_FALSE) << cases[i].text;
+		EXPECT_EQ(uriCompressedSetContainsA(set, cases[i].text, NULL), URI_FALSE);
+	}
+
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, FrontCodingShrinks) {
+	const std::vector<std::string> uris = sitemap();
+	size_t plain = 0;
+	for (size_t i = 0; i < uris.size(); i++) {
+		plain += uris[i].size();
+	}
+	UriCompressedSetA * const set = build(uris);
+	ASSERT_TRUE(set != NULL);
+	EXPECT_LT(static_cast<size_t>(uriCompressedSetByteSizeA(set)), plain / 2);
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, DuplicatesStoredOnce) {
+	std::vector<std::string> uris;
+	uris.push_back("http://a/");
+	uris.push_back("http://a/");
+	uris.push_back("http://b/");
+	uris.push_back("http://b/");
+	UriCompressedSetA * const set = build(uris);
+	ASSERT_TRUE(set != NULL);
+	EXPECT_EQ(uriCompressedSetCountA(set), 2);
+	EXPECT_EQ(get(set, 1), "http://b/");
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, NotSorted) {
+	std::vector<std::string> uris;
+	uris.push_back("http://a/");
+	uris.push_back("http://b/x");
+	uris.push_back("http://b/");  // a prefix must come first
+	const std::vector<UriTextRangeA> input = ranges(uris);
+
+	UriCompressedSetA * set = NULL;
+	int errorIndex = -1;
+	EXPECT_EQ(uriBuildCompressedSetA(&set, &input[0], 3, &errorIndex),
+			URI_ERROR_COMPRESSEDSET_NOT_SORTED);
+	EXPECT_EQ(errorIndex, 2);
+	EXPECT_TRUE(set == NULL);
+
+	std::swap(uris[0], uris[1]);
+	const std::vector<UriTextRangeA> swapped = ranges(uris);
+	EXPECT_EQ(uriBuildCompressedSetA(&set, &swapped[0], 3, &errorIndex),
+			URI_ERROR_COMPRESSEDSET_NOT_SORTED);
+	EXPECT_EQ(errorIndex, 1);
+}
+
+TEST(CompressedSetSuite, UnsignedOrder) {
+	// Like strcmp, UTF-8 sequences sort after ASCII
+	std::vector<std::string> uris;
+	uris.push_back("http://example.com/z");
+	uris.push_back("http://example.com/\xC3\xA4");
+	UriCompressedSetA * const set = build(uris);
+	ASSERT_TRUE(set != NULL);
+	EXPECT_EQ(uriCompressedSetContainsA(set, "http://example.com/\xC3\xA4", NULL),
+			URI_TRUE);
+	int rank = -1;
+	ASSERT_EQ(uriCompressedSetRankA(set, "http://example.com/\xC3", NULL, &rank,
+			NULL), URI_SUCCESS);
+	EXPECT_EQ(rank, 1);
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, EnumeratePrefix) {
+	UriCompressedSetA * const set = build(sitemap());
+	ASSERT_TRUE(set != NULL);
+
+	std::vector<std::pair<std::string, int> > found
+			= enumerate(set, "https://example.com/docs/h");
+	ASSERT_EQ(found.size(), 2u);
+	EXPECT_EQ(found[0].first, "https://example.com/docs/h");
+	EXPECT_EQ(found[0].second, 14);
+	EXPECT_EQ(found[1].first, "https://example.com/docs/h/index.html");
+	EXPECT_EQ(found[1].second, 15);
+
+	// Across a block boundary
+	found = enumerate(set, "https://example.com/docs/i");
+	ASSERT_EQ(found.size(), 2u);
+	EXPECT_EQ(found[0].second, 16);
+	EXPECT_EQ(found[1].first, "https://example.com/docs/i/index.html");
+
+	EXPECT_EQ(enumerate(set, "").size(), 53u);
+	EXPECT_EQ(enumerate(set, "https://example.com/").size(), 52u);
+	EXPECT_EQ(enumerate(set, "https://example.org/").size(), 1u);
+	EXPECT_TRUE(enumerate(set, "https://example.com/docs/h/x").empty());
+	EXPECT_TRUE(enumerate(set, "zzz").empty());
+
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, EnumerateStops) {
+	std::vector<std::string> uris;
+	uris.push_back("stop");
+	uris.push_back("stop/1");
+	uris.push_back("stop/2");
+	uris.push_back("stop/3");
+	UriCompressedSetA * const set = build(uris);
+	ASSERT_TRUE(set != NULL);
+	EXPECT_EQ(enumerate(set, "stop").size(), 3u);
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, Empty) {
+	UriCompressedSetA * const set = build(std::vector<std::string>());
+	ASSERT_TRUE(set != NULL);
+	EXPECT_EQ(uriCompressedSetCountA(set), 0);
+	EXPECT_EQ(uriCompressedSetContainsA(set, "", NULL), URI_FALSE);
+	EXPECT_TRUE(enumerate(set, "").empty());
+	char dest[8];
+	EXPECT_EQ(uriCompressedSetGetA(set, 0, dest, sizeof(dest), NULL),
+			URI_ERROR_RANGE_INVALID);
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, GetTooSmall) {
+	const std::vector<std::string> uris = sitemap();
+	UriCompressedSetA * const set = build(uris);
+	ASSERT_TRUE(set != NULL);
+
+	char dest[27];
+	int charsWritten = -1;
+	EXPECT_EQ(uriCompressedSetGetA(set, 1, dest, 27, &charsWritten),
+			URI_ERROR_OUTPUT_TOO_LARGE);
+	EXPECT_EQ(charsWritten, 0);
+	EXPECT_EQ(uriCompressedSetGetA(set, 2, dest, 26, &charsWritten),
+			URI_ERROR_OUTPUT_TOO_LARGE);
+	ASSERT_EQ(uriCompressedSetGetA(set, 2, dest, 27, &charsWritten), URI_SUCCESS);
+	EXPECT_EQ(charsWritten, 27);
+	EXPECT_EQ(std::string(dest), "https://example.com/docs/b");
+
+	uriFreeCompressedSetA(set);
+}
+
+TEST(CompressedSetSuite, Wide) {
+	const wchar_t * const uris[] = {
+		L"http://example.com/\x00E4",
+		L"http://example.com/\x20AC",
+		L"http://example.com/\x20AC/x",
+	};
+	UriTextRangeW input[3];
+	for (int i = 0; i < 3; i++) {
+		input[i].first = uris[i];
+		input[i].afterLast = uris[i] + wcslen(uris[i]);
+	}
+	UriCompressedSetW * set = NULL;
+	ASSERT_EQ(uriBuildCompressedSetW(&set, input, 3, NULL), URI_SUCCESS);
+
+	int rank = -1;
+	UriBool contained = URI_FALSE;
+	ASSERT_EQ(uriCompressedSetRankW(set, uris[1], NULL, &rank, &contained),
+			URI_SUCCESS);
+	EXPECT_EQ(rank, 1);
+	EXPECT_EQ(contained, URI_TRUE);
+
+	wchar_t dest[32];
+	ASSERT_EQ(uriCompressedSetGetW(set, 2, dest, 32, NULL), URI_SUCCESS);
+	EXPECT_EQ(std::wstring(dest), uris[2]);
+
+	uriFreeCompressedSetW(set);
+}
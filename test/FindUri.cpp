@@ -0,0 +1,275 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uriparser/Uri.h>
+
+
+
+extern "C" {
+size_t uri_TESTING_ONLY_FindAllWorkA(const char * first, const char * afterLast);
+}
+
+
+
+namespace {
+
+std::vector<std::string> findAll(const char * text) {
+	std::vector<std::string> result;
+	const char * first = text;
+	const char * const afterLast = text + strlen(text);
+	for (;;) {
+		UriTextRangeA found;
+		UriUriA uri;
+		EXPECT_EQ(uriFindUriExA(&uri, first, afterLast, &found), URI_SUCCESS);
+		if (found.first == NULL) {
+			break;
+		}
+		result.push_back(std::string(found.first, found.afterLast));
+		uriFreeUriMembersA(&uri);
+		first = found.afterLast;
+	}
+	return result;
+}
+
+// Characters looked at to find all URIs
+size_t workToFindAll(const std::string & text) {
+	return uri_TESTING_ONLY_FindAllWorkA(text.c_str(), text.c_str() + text.size());
+}
+
+std::string repeat(const char * prefix, const char * part, size_t times) {
+	std::string text = prefix;
+	for (size_t i = 0; i < times; i++) {
+		text += part;
+	}
+	return text;
+}
+
+}  // namespace
+
+
+
+TEST(FindUriSuite, Basic) {
+	EXPECT_EQ(findAll("Visit http://example.org/a?b=c#d today"),
+			std::vector<std::string>({"http://example.org/a?b=c#d"}));
+	EXPECT_EQ(findAll("http://a.example/ and https://b.example/x"),
+			std::vector<std::string>({"http://a.example/", "https://b.example/x"}));
+	EXPECT_EQ(findAll("no links here: just text, 12:30 and a:b"),
+			std::vector<std::string>());
+	EXPECT_EQ(findAll(""), std::vector<std::string>());
+}
+
+
+
+TEST(FindUriSuite, TrailingPunctuation) {
+	EXPECT_EQ(findAll("See http://example.org/."),
+			std::vector<std::string>({"http://example.org/"}));
+	EXPECT_EQ(findAll("Really? http://example.org/?!"),
+			std::vector<std::string>({"http://example.org/"}));
+	EXPECT_EQ(findAll("(see http://example.org/a)"),
+			std::vector<std::string>({"http://example.org/a"}));
+	EXPECT_EQ(findAll("(http://en.wikipedia.org/wiki/C_(language))"),
+			std::vector<std::string>({"http://en.wikipedia.org/wiki/C_(language)"}));
+	EXPECT_EQ(findAll("'http://example.org/',"),
+			std::vector<std::string>({"http://example.org/"}));
+}
+
+
+
+TEST(FindUriSuite, Html) {
+	EXPECT_EQ(findAll("<a href=\"http://example.org/a&amp;b\">x</a>"
+			"<img src='https://cdn.example/i.png'><http://example.org>"),
+			std::vector<std::string>({
+				"http://example.org/a&amp;b",
+				"https://cdn.example/i.png",
+				"http://example.org",
+			}));
+}
+
+
+
+TEST(FindUriSuite, SchemeBoundaries) {
+	EXPECT_EQ(findAll("--http://example.org"),
+			std::vector<std::string>({"http://example.org"}));
+	EXPECT_EQ(findAll("1svn+ssh://example.org/repo"),
+			std::vector<std::string>({"svn+ssh://example.org/repo"}));
+	EXPECT_EQ(findAll("://example.org"), std::vector<std::string>());
+	EXPECT_EQ(findAll("http://"), std::vector<std::string>());
+	EXPECT_EQ(findAll("http://."), std::vector<std::string>());
+}
+
+
+
+TEST(FindUriSuite, InvalidPartsCutOff) {
+	EXPECT_EQ(findAll("http://example.org/a%zz"),
+			std::vector<std::string>({"http://example.org/a"}));
+	EXPECT_EQ(findAll("http://example.org/%4"),
+			std::vector<std::string>({"http://example.org/"}));
+	EXPECT_EQ(findAll("http://example.org:80x/"),
+			std::vector<std::string>({"http://example.org"}));
+	EXPECT_EQ(findAll("http://[::1/ http://[::1]/"),
+			std::vector<std::string>({"http://[::1]/"}));
+}
+
+
+
+TEST(FindUriSuite, LongRunsCutOff) {
+	EXPECT_EQ(findAll("http://a:1:1:1"),
+			std::vector<std::string>({"http://a:1"}));
+	EXPECT_EQ(findAll(repeat("http://a", ":1", 1000).c_str()),
+			std::vector<std::string>({"http://a"}));
+	EXPECT_EQ(findAll(repeat("(http://a/", ")", 1000).c_str()),
+			std::vector<std::string>({"http://a/"}));
+}
+
+
+
+TEST(FindUriSuite, LongRunsStayLinear) {
+	// Quadruple the text, expect about four times the work, not sixteen
+	const char * const parts[][2] = {
+		{"http://a", ":1"},
+		{"(http://a/", ")"},
+		{"http://a/", "]"},
+		{"", "see http://example.org/a.b.c.d.e.f.g.h x.y.z. "},
+		{"", "www.example.org/a www.example.org/b. "},
+		{"", "www.example.org, www.example.com; "},
+		{"", "www.example.org "},
+		{"", "www.example.org http://example.org/a "},
+		{"", "a.b.c. :// http:// x "},
+	};
+	for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++) {
+		SCOPED_TRACE(parts[i][1]);
+		const size_t shortWork = workToFindAll(repeat(parts[i][0], parts[i][1], 2000));
+		const size_t longWork = workToFindAll(repeat(parts[i][0], parts[i][1], 8000));
+		EXPECT_LT(longWork, 5 * shortWork);
+	}
+}
+
+
+
+TEST(FindUriSuite, Www) {
+	UriTextRangeA found;
+	UriUriA uri;
+	const char * const text = "Go to www.example.org/a?b, or WWW.example.com.";
+	ASSERT_EQ(uriFindUriExA(&uri, text, NULL, &found), URI_SUCCESS);
+	ASSERT_EQ(std::string(found.first, found.afterLast), "www.example.org/a?b");
+	EXPECT_TRUE(uri.scheme.first == NULL);
+	EXPECT_EQ(std::string(uri.hostText.first, uri.hostText.afterLast),
+			"www.example.org");
+	ASSERT_TRUE(uri.pathHead != NULL);
+	EXPECT_EQ(std::string(uri.pathHead->text.first,
+			uri.pathHead->text.afterLast), "a");
+	EXPECT_EQ(std::string(uri.query.first, uri.query.afterLast), "b");
+	uriFreeUriMembersA(&uri);
+
+	EXPECT_EQ(findAll(text), std::vector<std::string>({
+			"www.example.org/a?b", "WWW.example.com"}));
+	EXPECT_EQ(findAll("awww.example.org www. www.-"),
+			std::vector<std::string>({"www.-"}));
+	EXPECT_EQ(findAll("http://www.example.org/"),
+			std::vector<std::string>({"http://www.example.org/"}));
+
+	// A scheme starting with "www." wins, also past the first search window
+	for (size_t padding = 0; padding < 512; padding += 250) {
+		const std::string padded = std::string(padding, ' ') + "www.example+tag://x/";
+		ASSERT_EQ(uriFindUriExA(&uri, padded.c_str(), NULL, &found), URI_SUCCESS);
+		ASSERT_TRUE(found.first != NULL) << padding;
+		EXPECT_EQ(std::string(found.first, found.afterLast), "www.example+tag://x/");
+		EXPECT_EQ(std::string(uri.scheme.first, uri.scheme.afterLast),
+				"www.example+tag") << padding;
+		uriFreeUriMembersA(&uri);
+	}
+}
+
+
+
+TEST(FindUriSuite, WithoutUri) {
+	const char * const text = "x https://example.org/ y";
+	UriTextRangeA found;
+	ASSERT_EQ(uriFindUriExA(NULL, text, NULL, &found), URI_SUCCESS);
+	EXPECT_EQ(found.first, text + 2);
+	EXPECT_EQ(found.afterLast, text + 22);
+}
+
+
+
+TEST(FindUriSuite, NullParameters) {
+	UriTextRangeA found;
+	EXPECT_EQ(uriFindUriExA(NULL, NULL, NULL, &found), URI_ERROR_NULL);
+	EXPECT_EQ(uriFindUriExA(NULL, "", NULL, NULL), URI_ERROR_NULL);
+	EXPECT_EQ(uriFindUriExMmA(NULL, "", NULL, &found, NULL), URI_ERROR_NULL);
+}
+
+
+
+TEST(FindUriSuite, Wide) {
+	const wchar_t * const text = L"see http://example.org/ä now";
+	UriTextRangeW found;
+	UriUriW uri;
+	ASSERT_EQ(uriFindUriExW(&uri, text, NULL, &found), URI_SUCCESS);
+	EXPECT_EQ(found.first, text + 4);
+	EXPECT_EQ(found.afterLast, text + 23);
+	uriFreeUriMembersW(&uri);
+}
+
+
+
+TEST(FindUriSuite, FoundUrisParseRandom) {
+	const char * const tokens[] = {
+		"http://", "www.", "a", "0", ".", ",", ":", "/", "?", "#", "@",
+		"%", "%4", "%41", "[", "]", "::1", "(", ")", " ", "\"", "<", "\x80",
+	};
+	const size_t tokenCount = sizeof(tokens) / sizeof(tokens[0]);
+	std::mt19937 generator(20261018);
+	std::uniform_int_distribution<size_t> lengthDistribution(0, 16);
+	std::uniform_int_distribution<size_t> tokenDistribution(0, tokenCount - 1);
+
+	for (int i = 0; i < 20000; i++) {
+		std::string text;
+		const size_t length = lengthDistribution(generator);
+		for (size_t k = 0; k < length; k++) {
+			text += tokens[tokenDistribution(generator)];
+		}
+		SCOPED_TRACE(text);
+		const char * first = text.c_str();
+		const char * const afterLast = first + text.size();
+		for (;;) {
+			UriTextRangeA found;
+			ASSERT_EQ(uriFindUriExA(NULL, first, afterLast, &found), URI_SUCCESS);
+			if (found.first == NULL) {
+				break;
+			}
+			ASSERT_TRUE((found.first >= first) && (found.afterLast <= afterLast));
+			ASSERT_TRUE(found.first < found.afterLast);
+			if (strncmp(found.first, "http://", 7) == 0) {
+				UriUriA uri;
+				ASSERT_EQ(uriParseSingleUriExA(&uri, found.first,
+						found.afterLast, NULL), URI_SUCCESS);
+				uriFreeUriMembersA(&uri);
+			}
+			first = found.afterLast;
+		}
+	}
+}
@@ -0,0 +1,250 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+UriUint64 originHashA(const char * text, UriUint64 seed = 0) {
+	UriUriA uri;
+	UriUint64 hash = 0;
+	EXPECT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	EXPECT_EQ(uriOriginHashA(&uri, seed, &hash), URI_SUCCESS);
+	uriFreeUriMembersA(&uri);
+	return hash;
+}
+
+UriUint64 originHashW(const wchar_t * text, UriUint64 seed = 0) {
+	UriUriW uri;
+	UriUint64 hash = 0;
+	EXPECT_EQ(uriParseSingleUriW(&uri, text, NULL), URI_SUCCESS);
+	EXPECT_EQ(uriOriginHashW(&uri, seed, &hash), URI_SUCCESS);
+	uriFreeUriMembersW(&uri);
+	return hash;
+}
+
+int originHashErrorA(const char * text) {
+	UriUriA uri;
+	UriUint64 hash = 0;
+	EXPECT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	const int res = uriOriginHashA(&uri, 0, &hash);
+	uriFreeUriMembersA(&uri);
+	return res;
+}
+
+const char * const rules =
+		"com\n"
+		"uk\n"
+		"co.uk\n";
+
+class SiteHashSuite : public ::testing::Test {
+protected:
+	UriPublicSuffixList * psl;
+
+	SiteHashSuite() : psl(NULL) {}
+
+	void SetUp() {
+		ASSERT_EQ(uriCompilePublicSuffixList(&psl, rules, NULL, NULL),
+				URI_SUCCESS);
+	}
+
+	void TearDown() {
+		uriFreePublicSuffixList(psl);
+	}
+
+	UriUint64 siteHashA(const char * text, UriUint64 seed = 0) {
+		UriUriA uri;
+		UriUint64 hash = 0;
+		EXPECT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+		EXPECT_EQ(uriSiteHashA(&uri, psl, seed, &hash), URI_SUCCESS);
+		uriFreeUriMembersA(&uri);
+		return hash;
+	}
+};
+
+}  // namespace
+
+
+
+TEST(OriginHashSuite, IgnoresCaseAndNonOriginParts) {
+	EXPECT_EQ(originHashA("http://example.com/"),
+			originHashA("HTTP://user@Example.COM/path?query#fragment"));
+}
+
+TEST(OriginHashSuite, DefaultPorts) {
+	EXPECT_EQ(originHashA("http://example.com/"),
+			originHashA("http://example.com:80/"));
+	EXPECT_EQ(originHashA("https://example.com/"),
+			originHashA("https://example.com:443/"));
+	EXPECT_EQ(originHashA("wss://example.com/"),
+			originHashA("wss://example.com:443/"));
+	EXPECT_EQ(originHashA("ftp://example.com/"),
+			originHashA("ftp://example.com:021/"));
+	EXPECT_EQ(originHashA("http://example.com/"),
+			originHashA("http://example.com:/"));
+	EXPECT_NE(originHashA("http://example.com/"),
+			originHashA("http://example.com:8080/"));
+	EXPECT_NE(originHashA("http://example.com/"),
+			originHashA("https://example.com:80/"));
+}
+
+TEST(OriginHashSuite, DiffersByComponentAndSeed) {
+	const UriUint64 hash = originHashA("http://example.com/");
+	EXPECT_NE(hash, originHashA("https://example.com/"));
+	EXPECT_NE(hash, originHashA("http://example.org/"));
+	EXPECT_NE(hash, originHashA("http://example.com./"));
+	EXPECT_NE(hash, originHashA("http://example.com/", 1));
+	EXPECT_NE(originHashA("ab://c/"), originHashA("a://bc/"));
+}
+
+TEST(OriginHashSuite, IpHostsByValue) {
+	EXPECT_EQ(originHashA("http://[::1]/"),
+			originHashA("http://[0:0:0:0:0:0:0:1]:80/"));
+	EXPECT_EQ(originHashA("http://[v1.Ab]/"), originHashA("http://[V1.aB]/"));
+	EXPECT_NE(originHashA("http://127.0.0.1/"), originHashA("http://[::1]/"));
+}
+
+TEST(OriginHashSuite, Stable) {
+	// Shards must not move between releases or platforms
+	EXPECT_EQ(originHashA("http://example.com/"),
+			originHashW(L"HTTP://EXAMPLE.COM:80/"));
+	EXPECT_EQ(originHashA("https://[::1]:8443/", 42),
+			originHashW(L"https://[::1]:8443/", 42));
+	EXPECT_EQ(originHashA("http://example.com/"), UINT64_C(0x8DD766718CEB3B4A));
+}
+
+TEST(OriginHashSuite, WideCharactersHashedAsUtf8) {
+	// The parser rejects these hosts, other sources of URIs may not
+	UriUriA uriA;
+	UriUriW uriW;
+	const char * const schemeA = "http";
+	const char * const hostA = "b\xC3\xBC" "cher.de";
+	const wchar_t * const schemeW = L"http";
+	const wchar_t * const hostW = L"b\xFC" L"cher.de";
+	UriUint64 hashA = 0;
+	UriUint64 hashW = 1;
+	std::memset(&uriA, 0, sizeof(uriA));
+	std::memset(&uriW, 0, sizeof(uriW));
+	uriA.scheme.first = schemeA;
+	uriA.scheme.afterLast = schemeA + std::strlen(schemeA);
+	uriA.hostText.first = hostA;
+	uriA.hostText.afterLast = hostA + std::strlen(hostA);
+	uriW.scheme.first = schemeW;
+	uriW.scheme.afterLast = schemeW + std::wcslen(schemeW);
+	uriW.hostText.first = hostW;
+	uriW.hostText.afterLast = hostW + std::wcslen(hostW);
+	ASSERT_EQ(uriOriginHashA(&uriA, 0, &hashA), URI_SUCCESS);
+	ASSERT_EQ(uriOriginHashW(&uriW, 0, &hashW), URI_SUCCESS);
+	EXPECT_EQ(hashA, hashW);
+}
+
+TEST(OriginHashSuite, Errors) {
+	UriUriA uri;
+	UriUint64 hash;
+	EXPECT_EQ(originHashErrorA("mailto:someone@example.com"),
+			URI_ERROR_HASH_HOST_NOT_SET);
+	EXPECT_EQ(originHashErrorA("http://example.com:65536/"),
+			URI_ERROR_PORT_OUT_OF_RANGE);
+	EXPECT_EQ(uriOriginHashA(NULL, 0, &hash), URI_ERROR_NULL);
+	EXPECT_EQ(uriOriginHashA(&uri, 0, NULL), URI_ERROR_NULL);
+}
+
+TEST_F(SiteHashSuite, SameSiteAcrossSubdomainsAndPorts) {
+	EXPECT_EQ(siteHashA("https://a.example.co.uk/"),
+			siteHashA("https://B.Example.co.uk:8443/"));
+	EXPECT_EQ(siteHashA("https://example.co.uk/"),
+			siteHashA("https://www.example.co.uk./"));
+	EXPECT_NE(siteHashA("https://a.example.co.uk/"),
+			siteHashA("http://a.example.co.uk/"));
+	EXPECT_NE(siteHashA("https://a.example.co.uk/"),
+			siteHashA("https://a.other.co.uk/"));
+	EXPECT_NE(siteHashA("https://a.example.co.uk/"),
+			siteHashA("https://a.example.co.uk/", 1));
+}
+
+TEST_F(SiteHashSuite, PublicSuffixAndIpHosts) {
+	EXPECT_NE(siteHashA("https://co.uk/"), siteHashA("https://x.co.uk/"));
+	EXPECT_EQ(siteHashA("https://localhost/"),
+			siteHashA("https://LOCALHOST:8443/"));
+	EXPECT_EQ(siteHashA("https://[::1]/"),
+			siteHashA("https://[0::1]:8443/"));
+	EXPECT_NE(siteHashA("https://127.0.0.1/"),
+			siteHashA("https://127.0.0.2/"));
+}
+
+TEST_F(SiteHashSuite, Errors) {
+	UriUriA uri;
+	UriUint64 hash;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "urn:example:a", NULL), URI_SUCCESS);
+	EXPECT_EQ(uriSiteHashA(&uri, psl, 0, &hash), URI_ERROR_HASH_HOST_NOT_SET);
+	EXPECT_EQ(uriSiteHashA(&uri, NULL, 0, &hash), URI_ERROR_NULL);
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(JumpConsistentHashSuite, Range) {
+	EXPECT_EQ(uriJumpConsistentHash(0, 0), -1);
+	EXPECT_EQ(uriJumpConsistentHash(0, -1), -1);
+	for (UriUint64 key = 0; key < 100; key++) {
+		EXPECT_EQ(uriJumpConsistentHash(key, 1), 0);
+	}
+}
+
+TEST(JumpConsistentHashSuite, Reference) {
+	// Same as the C++ code of the paper
+	EXPECT_EQ(uriJumpConsistentHash(1, 1000), 549);
+	EXPECT_EQ(uriJumpConsistentHash(1, 7), 6);
+	EXPECT_EQ(uriJumpConsistentHash(0xDEADBEEF, 1000), 285);
+	EXPECT_EQ(uriJumpConsistentHash(0xDEADBEEF, 7), 5);
+	EXPECT_EQ(uriJumpConsistentHash(UINT64_C(0x123456789ABCDEF0), 1000), 399);
+	EXPECT_EQ(uriJumpConsistentHash(UINT64_C(0x123456789ABCDEF0), 7), 4);
+}
+
+TEST(JumpConsistentHashSuite, MinimalMovement) {
+	// Growing by one bucket moves keys to the new bucket only
+	for (UriUint64 seed = 0; seed < 500; seed++) {
+		const UriUint64 hash = originHashA("http://example.com/", seed);
+		for (int buckets = 1; buckets < 40; buckets++) {
+			const int before = uriJumpConsistentHash(hash, buckets);
+			const int after = uriJumpConsistentHash(hash, buckets + 1);
+			ASSERT_TRUE((after == before) || (after == buckets));
+		}
+	}
+}
+
+TEST(JumpConsistentHashSuite, Uniform) {
+	int counts[10] = {0};
+	char text[40];
+	for (int i = 0; i < 10000; i++) {
+		snprintf(text, sizeof(text), "http://host%d.example.com/", i);
+		counts[uriJumpConsistentHash(originHashA(text), 10)]++;
+	}
+	for (int i = 0; i < 10; i++) {
+		EXPECT_GT(counts[i], 850);
+		EXPECT_LT(counts[i], 1150);
+	}
+}
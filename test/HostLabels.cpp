@@ -0,0 +1,185 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+std::string label(const UriUriA & uri, const UriHostLabels & labels, int i) {
+	return std::string(uri.hostText.first + labels.offsets[i],
+			uri.hostText.first + labels.offsets[i + 1] - 1);
+}
+
+std::string reversedKey(const char * uriString, UriBool withPath) {
+	UriUriA uri;
+	EXPECT_EQ(uriParseSingleUriA(&uri, uriString, NULL), URI_SUCCESS);
+	int charsRequired = -1;
+	EXPECT_EQ(uriToReversedHostKeyCharsRequiredA(&uri, NULL, withPath,
+			&charsRequired), URI_SUCCESS);
+	char dest[128];
+	int charsWritten = -1;
+	EXPECT_EQ(uriToReversedHostKeyA(dest, &uri, NULL, withPath, sizeof(dest),
+			&charsWritten), URI_SUCCESS);
+	EXPECT_EQ(charsWritten, charsRequired + 1);
+	uriFreeUriMembersA(&uri);
+	return dest;
+}
+
+}  // namespace
+
+
+
+TEST(HostLabelsSuite, IndexLabels) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://www.example.com/", NULL),
+			URI_SUCCESS);
+	UriHostLabels labels;
+	ASSERT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_SUCCESS);
+	ASSERT_EQ(labels.count, 3);
+	EXPECT_EQ(label(uri, labels, 0), "www");
+	EXPECT_EQ(label(uri, labels, 1), "example");
+	EXPECT_EQ(label(uri, labels, 2), "com");
+	// Suffix of the last two labels
+	EXPECT_EQ(std::string(uri.hostText.first + labels.offsets[labels.count - 2],
+			uri.hostText.afterLast), "example.com");
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(HostLabelsSuite, IndexTrailingDotAndEmptyLabels) {
+	UriUriA uri;
+	UriHostLabels labels;
+
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://example.com./", NULL),
+			URI_SUCCESS);
+	ASSERT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_SUCCESS);
+	ASSERT_EQ(labels.count, 2);
+	EXPECT_EQ(label(uri, labels, 1), "com");
+	uriFreeUriMembersA(&uri);
+
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://a..b/", NULL), URI_SUCCESS);
+	ASSERT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_SUCCESS);
+	ASSERT_EQ(labels.count, 3);
+	EXPECT_EQ(label(uri, labels, 1), "");
+	uriFreeUriMembersA(&uri);
+
+	ASSERT_EQ(uriParseSingleUriA(&uri, "file:///etc", NULL), URI_SUCCESS);
+	ASSERT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_SUCCESS);
+	EXPECT_EQ(labels.count, 0);
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(HostLabelsSuite, IndexRejectsNonRegName) {
+	const char * const uriStrings[] = {
+		"http://192.0.2.1/",
+		"http://[2001:db8::1]/",
+		"http://[v7.x]/",
+		"mailto:someone@example.com",
+	};
+	for (size_t i = 0; i < sizeof(uriStrings) / sizeof(uriStrings[0]); i++) {
+		UriUriA uri;
+		UriHostLabels labels;
+		ASSERT_EQ(uriParseSingleUriA(&uri, uriStrings[i], NULL), URI_SUCCESS);
+		EXPECT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_ERROR_HOST_NOT_REGNAME)
+				<< uriStrings[i];
+		uriFreeUriMembersA(&uri);
+	}
+	EXPECT_EQ(uriIndexHostLabelsA(NULL, NULL), URI_ERROR_NULL);
+}
+
+TEST(HostLabelsSuite, IndexTooManyLabels) {
+	std::string uriString = "http://";
+	for (int i = 0; i < URI_HOST_LABELS_MAX; i++) {
+		uriString += "a.";
+	}
+	const std::string maxLabels = uriString + "/";
+	const std::string tooManyLabels = uriString + "b/";
+	UriUriA uri;
+	UriHostLabels labels;
+	ASSERT_EQ(uriParseSingleUriA(&uri, maxLabels.c_str(), NULL), URI_SUCCESS);
+	EXPECT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_SUCCESS);
+	EXPECT_EQ(labels.count, URI_HOST_LABELS_MAX);
+	uriFreeUriMembersA(&uri);
+
+	ASSERT_EQ(uriParseSingleUriA(&uri, tooManyLabels.c_str(), NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_ERROR_OUTPUT_TOO_LARGE);
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(HostLabelsSuite, ReversedKey) {
+	EXPECT_EQ(reversedKey("http://WWW.Example.com./a/b?q#f", URI_FALSE),
+			"com.example.www");
+	EXPECT_EQ(reversedKey("http://WWW.Example.com./a/b?q#f", URI_TRUE),
+			"com.example.www/a/b");
+	EXPECT_EQ(reversedKey("http://user@example.com:8080", URI_TRUE),
+			"com.example/");
+	EXPECT_EQ(reversedKey("http://example.com/", URI_TRUE), "com.example/");
+	EXPECT_EQ(reversedKey("http://example.com/dir/", URI_TRUE),
+			"com.example/dir/");
+	EXPECT_EQ(reversedKey("http://localhost/x", URI_TRUE), "localhost/x");
+}
+
+TEST(HostLabelsSuite, ReversedKeyWithIndex) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://a.b.c/x", NULL), URI_SUCCESS);
+	UriHostLabels labels;
+	ASSERT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_SUCCESS);
+	char dest[16];
+	ASSERT_EQ(uriToReversedHostKeyA(dest, &uri, &labels, URI_TRUE,
+			sizeof(dest), NULL), URI_SUCCESS);
+	EXPECT_EQ(std::string(dest), "c.b.a/x");
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(HostLabelsSuite, ReversedKeyTooSmall) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://www.example.com/x", NULL),
+			URI_SUCCESS);
+	char dest[8];
+	int charsWritten = -1;
+	EXPECT_EQ(uriToReversedHostKeyA(dest, &uri, NULL, URI_FALSE, sizeof(dest),
+			&charsWritten), URI_ERROR_OUTPUT_TOO_LARGE);
+	EXPECT_EQ(std::string(dest), "com.");
+	EXPECT_EQ(charsWritten, 5);
+	uriFreeUriMembersA(&uri);
+
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://192.0.2.1/", NULL), URI_SUCCESS);
+	EXPECT_EQ(uriToReversedHostKeyA(dest, &uri, NULL, URI_FALSE, sizeof(dest),
+			&charsWritten), URI_ERROR_HOST_NOT_REGNAME);
+	EXPECT_EQ(charsWritten, 0);
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(HostLabelsSuite, ReversedKeyWide) {
+	UriUriW uri;
+	ASSERT_EQ(uriParseSingleUriW(&uri, L"http://www.example.com/x", NULL),
+			URI_SUCCESS);
+	wchar_t dest[32];
+	ASSERT_EQ(uriToReversedHostKeyW(dest, &uri, NULL, URI_TRUE, 32, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(std::wstring(dest), L"com.example.www/x");
+	uriFreeUriMembersW(&uri);
+}
@@ -0,0 +1,198 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+std::string encode(const char * text) {
+	char dest[128];
+	int charsWritten = -1;
+	EXPECT_EQ(uriPunycodeEncodeA(dest, text, NULL, sizeof(dest), &charsWritten),
+			URI_SUCCESS);
+	EXPECT_EQ(charsWritten, static_cast<int>(strlen(dest)) + 1);
+	return dest;
+}
+
+std::string decode(const char * text) {
+	char dest[256];
+	EXPECT_EQ(uriPunycodeDecodeA(dest, text, NULL, sizeof(dest), NULL),
+			URI_SUCCESS);
+	return dest;
+}
+
+std::string normalizeHost(const char * uriString, bool iri = false,
+		bool normalizeSyntaxFirst = false) {
+	UriUriA uri;
+	if (iri) {
+		EXPECT_EQ(uriParseSingleIriExA(&uri, uriString, NULL, NULL), URI_SUCCESS);
+	} else {
+		EXPECT_EQ(uriParseSingleUriA(&uri, uriString, NULL), URI_SUCCESS);
+	}
+	if (normalizeSyntaxFirst) {
+		EXPECT_EQ(uriNormalizeSyntaxA(&uri), URI_SUCCESS);
+	}
+	EXPECT_EQ(uriNormalizeHostIdnaA(&uri), URI_SUCCESS);
+	const std::string host(uri.hostText.first, uri.hostText.afterLast);
+	uriFreeUriMembersA(&uri);
+	return host;
+}
+
+}  // namespace
+
+
+
+TEST(IdnaSuite, PunycodeRfc3492Samples) {
+	// (B) Chinese (simplified)
+	const char * const chinese = "\xE4\xBB\x96\xE4\xBB\xAC\xE4\xB8\xBA"
+			"\xE4\xBB\x80\xE4\xB9\x88\xE4\xB8\x8D\xE8\xAF\xB4"
+			"\xE4\xB8\xAD\xE6\x96\x87";
+	EXPECT_EQ(encode(chinese), "ihqwcrb4cv8a8dqg056pqjye");
+	EXPECT_EQ(decode("ihqwcrb4cv8a8dqg056pqjye"), chinese);
+
+	// (L) Japanese with basic code points
+	const char * const mixed = "3\xE5\xB9\xB4" "B\xE7\xB5\x84"
+			"\xE9\x87\x91\xE5\x85\xAB\xE5\x85\x88\xE7\x94\x9F";
+	EXPECT_EQ(encode(mixed), "3B-ww4c5e180e575a65lsy2b");
+	EXPECT_EQ(decode("3B-ww4c5e180e575a65lsy2b"), mixed);
+
+	// (S) Basic code points only
+	EXPECT_EQ(encode("-> $1.00 <-"), "-> $1.00 <--");
+	EXPECT_EQ(decode("-> $1.00 <--"), "-> $1.00 <-");
+}
+
+TEST(IdnaSuite, PunycodeSupplementaryPlane) {
+	// U+1F600
+	EXPECT_EQ(decode(encode("a\xF0\x9F\x98\x80").c_str()), "a\xF0\x9F\x98\x80");
+}
+
+TEST(IdnaSuite, PunycodeDecodeIsCaseInsensitive) {
+	EXPECT_EQ(decode("BCHER-KVA"), "B\xC3\xBC" "CHER");
+	EXPECT_EQ(decode("bcher-kva"), "b\xC3\xBC" "cher");
+}
+
+TEST(IdnaSuite, PunycodeDecodeRejectsInvalid) {
+	char dest[64];
+	const char * const invalid[] = {
+		"b\xC3\xBC-kva",  // non-basic before delimiter
+		"bcher-kv!",      // not a digit
+		"bcher-k",        // truncated variable-length integer
+		"99999999999",    // overflow
+	};
+	for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+		EXPECT_EQ(uriPunycodeDecodeA(dest, invalid[i], NULL, sizeof(dest), NULL),
+				URI_ERROR_SYNTAX) << invalid[i];
+	}
+}
+
+TEST(IdnaSuite, PunycodeEncodeRejectsInvalid) {
+	char dest[128];
+	// Ill-formed UTF-8
+	EXPECT_EQ(uriPunycodeEncodeA(dest, "b\xC3", NULL, sizeof(dest), NULL),
+			URI_ERROR_SYNTAX);
+	// More than 63 code points
+	const std::string tooLong(64, 'a');
+	EXPECT_EQ(uriPunycodeEncodeA(dest, tooLong.c_str(), NULL, sizeof(dest),
+			NULL), URI_ERROR_SYNTAX);
+	EXPECT_EQ(uriPunycodeEncodeA(NULL, "a", NULL, 2, NULL), URI_ERROR_NULL);
+}
+
+TEST(IdnaSuite, PunycodeOutputTooLarge) {
+	char dest[9];
+	int charsWritten = -1;
+	// "bcher-kva" needs 10 characters with terminator
+	EXPECT_EQ(uriPunycodeEncodeA(dest, "b\xC3\xBC" "cher", NULL, sizeof(dest),
+			&charsWritten), URI_ERROR_OUTPUT_TOO_LARGE);
+	EXPECT_EQ(std::string(dest), "");
+	EXPECT_EQ(charsWritten, 0);
+
+	char small[6];
+	EXPECT_EQ(uriPunycodeDecodeA(small, "bcher-kva", NULL, sizeof(small),
+			&charsWritten), URI_ERROR_OUTPUT_TOO_LARGE);
+	EXPECT_EQ(std::string(small), "b\xC3\xBC" "ch");
+	EXPECT_EQ(charsWritten, 6);
+}
+
+TEST(IdnaSuite, PunycodeWide) {
+	wchar_t dest[32];
+	ASSERT_EQ(uriPunycodeEncodeW(dest, L"b\x00FC" L"cher", NULL, 32, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(std::wstring(dest), L"bcher-kva");
+	ASSERT_EQ(uriPunycodeDecodeW(dest, L"bcher-kva", NULL, 32, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(std::wstring(dest), L"b\x00FC" L"cher");
+}
+
+TEST(IdnaSuite, NormalizePercentEncodedHost) {
+	EXPECT_EQ(normalizeHost("http://b%C3%BCcher.example/"),
+			"xn--bcher-kva.example");
+	// Lowercase percent-encoding and mixed case letters, before and after
+	// regular normalization
+	EXPECT_EQ(normalizeHost("http://WWW.B%c3%bcCHER.example./"),
+			"WWW.xn--bcher-kva.example.");
+	EXPECT_EQ(normalizeHost("http://WWW.B%c3%bcCHER.example./", false, true),
+			"www.xn--bcher-kva.example.");
+}
+
+TEST(IdnaSuite, NormalizeIriHost) {
+	EXPECT_EQ(normalizeHost("http://M\xC3\xBCnchen.example/", true),
+			"xn--mnchen-3ya.example");
+}
+
+TEST(IdnaSuite, NormalizeOwnerGrowing) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://\xC3\xBC.example/x", NULL),
+			URI_ERROR_SYNTAX);
+	ASSERT_EQ(uriParseSingleIriExA(&uri, "http://\xC3\xBC.example/x", NULL,
+			NULL), URI_SUCCESS);
+	ASSERT_EQ(uriMakeOwnerA(&uri), URI_SUCCESS);
+	ASSERT_EQ(uriNormalizeHostIdnaA(&uri), URI_SUCCESS);
+
+	char text[64];
+	ASSERT_EQ(uriToStringA(text, &uri, sizeof(text), NULL), URI_SUCCESS);
+	EXPECT_EQ(std::string(text), "http://xn--tda.example/x");
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(IdnaSuite, NormalizeSyntaxLeavesHostAlone) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://b%C3%BCcher.example/", NULL),
+			URI_SUCCESS);
+	ASSERT_EQ(uriNormalizeSyntaxA(&uri), URI_SUCCESS);
+	EXPECT_EQ(std::string(uri.hostText.first, uri.hostText.afterLast),
+			"b%C3%BCcher.example");
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(IdnaSuite, NormalizeLeavesOthersAlone) {
+	// Not UTF-8, left as is
+	EXPECT_EQ(normalizeHost("http://b%FCcher.example/"), "b%FCcher.example");
+	// IP literals
+	EXPECT_EQ(normalizeHost("http://[2001:db8::1]/"), "2001:db8::1");
+	EXPECT_EQ(normalizeHost("http://192.0.2.1/"), "192.0.2.1");
+	// No host
+	EXPECT_EQ(uriNormalizeHostIdnaA(NULL), URI_ERROR_NULL);
+}
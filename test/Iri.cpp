@@ -0,0 +1,206 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+int parseIri(const char * text, UriUriA * uri, const char ** errorPos) {
+	return uriParseSingleIriExA(uri, text, NULL, errorPos);
+}
+
+std::string toText(const UriTextRangeA & range) {
+	return std::string(range.first, range.afterLast);
+}
+
+}  // namespace
+
+
+
+TEST(IriSuite, ParseUcsCharInEveryComponent) {
+	// "http://üser@bücher.example/pfad/ä?q=é#frag-ö"
+	const char * const text = "http://\xC3\xBCser@b\xC3\xBC" "cher.example"
+			"/pfad/\xC3\xA4?q=\xC3\xA9#frag-\xC3\xB6";
+	UriUriA uri;
+	const char * errorPos = NULL;
+	ASSERT_EQ(parseIri(text, &uri, &errorPos), URI_SUCCESS);
+	EXPECT_EQ(toText(uri.userInfo), "\xC3\xBCser");
+	EXPECT_EQ(toText(uri.hostText), "b\xC3\xBC" "cher.example");
+	ASSERT_TRUE(uri.pathHead != NULL);
+	ASSERT_TRUE(uri.pathHead->next != NULL);
+	EXPECT_EQ(toText(uri.pathHead->next->text), "\xC3\xA4");
+	EXPECT_EQ(toText(uri.query), "q=\xC3\xA9");
+	EXPECT_EQ(toText(uri.fragment), "frag-\xC3\xB6");
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(IriSuite, ParseRelativeAndSupplementary) {
+	// "/日本/😀" followed by a relative reference starting with a ucschar
+	const char * const texts[] = {
+		"/\xE6\x97\xA5\xE6\x9C\xAC/\xF0\x9F\x98\x80",
+		"\xE6\x97\xA5/x",
+		"//\xE6\x97\xA5.example:80",
+	};
+	for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+		UriUriA uri;
+		EXPECT_EQ(parseIri(texts[i], &uri, NULL), URI_SUCCESS) << texts[i];
+		uriFreeUriMembersA(&uri);
+	}
+}
+
+TEST(IriSuite, PlainUriParserStillRejects) {
+	const char * const text = "http://example.org/\xC3\xA4";
+	UriUriA uri;
+	const char * errorPos = NULL;
+	ASSERT_EQ(uriParseSingleUriA(&uri, text, &errorPos), URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, text + 19);
+}
+
+TEST(IriSuite, PrivateUseOnlyInQuery) {
+	UriUriA uri;
+	const char * errorPos = NULL;
+
+	// U+E000 in the query
+	ASSERT_EQ(parseIri("http://example.org/?\xEE\x80\x80", &uri, &errorPos),
+			URI_SUCCESS);
+	EXPECT_EQ(toText(uri.query), "\xEE\x80\x80");
+	uriFreeUriMembersA(&uri);
+
+	// ... but neither in the fragment nor in the path
+	const char * const inFragment = "http://example.org/?q#\xEE\x80\x80";
+	EXPECT_EQ(parseIri(inFragment, &uri, &errorPos), URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, inFragment + 22);
+
+	const char * const inPath = "http://example.org/\xEE\x80\x80";
+	EXPECT_EQ(parseIri(inPath, &uri, &errorPos), URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, inPath + 19);
+}
+
+TEST(IriSuite, RejectsNonAsciiScheme) {
+	UriUriA uri;
+	const char * errorPos = NULL;
+	const char * const text = "h\xC3\xA4:x";
+	// Parsed as a relative path, whose first segment must not hold a colon
+	EXPECT_EQ(parseIri(text, &uri, &errorPos), URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, text + 3);
+}
+
+TEST(IriSuite, RejectsIllFormedUtf8) {
+	const char * const texts[] = {
+		"/\xC3",              // truncated
+		"/\xC0\xAF",          // overlong
+		"/\xED\xA0\x80",      // surrogate
+		"/\xF4\x90\x80\x80",  // beyond U+10FFFF
+		"/\x80",              // stray continuation byte
+	};
+	for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+		UriUriA uri;
+		const char * errorPos = NULL;
+		EXPECT_EQ(parseIri(texts[i], &uri, &errorPos), URI_ERROR_SYNTAX) << i;
+		EXPECT_EQ(errorPos, texts[i] + 1) << i;
+	}
+}
+
+TEST(IriSuite, RejectsNonUcsChar) {
+	// U+FFFE is not a ucschar
+	UriUriA uri;
+	EXPECT_EQ(parseIri("/\xEF\xBF\xBE", &uri, NULL), URI_ERROR_SYNTAX);
+}
+
+TEST(IriSuite, ParseIriExMmRejectsBadManager) {
+	UriMemoryManager memory;
+	memset(&memory, 0, sizeof(memory));
+	UriUriA uri;
+	const char * const text = "/x";
+	EXPECT_EQ(uriParseSingleIriExMmA(&uri, text, text + 2, NULL, &memory),
+			URI_ERROR_MEMORY_MANAGER_INCOMPLETE);
+}
+
+TEST(IriSuite, ToUriString) {
+	const char * const iri = "http://b\xC3\xBC" "cher.example/\xF0\x9F\x98\x80?q=%41";
+	const std::string expected = "http://b%C3%BCcher.example/%F0%9F%98%80?q=%41";
+	int charsRequired = -1;
+	ASSERT_EQ(uriIriToUriStringCharsRequiredA(iri, NULL, &charsRequired, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(charsRequired, static_cast<int>(expected.size()));
+
+	char dest[64];
+	int charsWritten = -1;
+	ASSERT_EQ(uriIriToUriStringA(dest, iri, NULL, sizeof(dest), &charsWritten,
+			NULL), URI_SUCCESS);
+	EXPECT_EQ(std::string(dest), expected);
+	EXPECT_EQ(charsWritten, charsRequired + 1);
+
+	// The result is a plain URI
+	UriUriA uri;
+	EXPECT_EQ(uriParseSingleUriA(&uri, dest, NULL), URI_SUCCESS);
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(IriSuite, ToUriStringTooSmall) {
+	const char * const iri = "/a\xC3\xA4";
+	char dest[6];
+	int charsWritten = -1;
+	// "/a%C3%A4" needs 9 characters with terminator; escapes are never split
+	ASSERT_EQ(uriIriToUriStringA(dest, iri, NULL, sizeof(dest), &charsWritten,
+			NULL), URI_ERROR_OUTPUT_TOO_LARGE);
+	EXPECT_EQ(std::string(dest), "/a");
+	EXPECT_EQ(charsWritten, 3);
+
+	char exact[9];
+	ASSERT_EQ(uriIriToUriStringA(exact, iri, NULL, sizeof(exact), &charsWritten,
+			NULL), URI_SUCCESS);
+	EXPECT_EQ(std::string(exact), "/a%C3%A4");
+}
+
+TEST(IriSuite, ToUriStringRejectsIllFormed) {
+	const char * const iri = "/ok/\xE2\x82";
+	char dest[32];
+	int charsRequired = -1;
+	const char * errorPos = NULL;
+	EXPECT_EQ(uriIriToUriStringCharsRequiredA(iri, NULL, &charsRequired,
+			&errorPos), URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, iri + 4);
+	errorPos = NULL;
+	EXPECT_EQ(uriIriToUriStringA(dest, iri, NULL, sizeof(dest), NULL,
+			&errorPos), URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, iri + 4);
+}
+
+TEST(IriSuite, WideParseAndConvert) {
+	// L"http://bücher.example/€"
+	const wchar_t * const iri = L"http://b\x00FC" L"cher.example/\x20AC";
+	UriUriW uri;
+	ASSERT_EQ(uriParseSingleIriExW(&uri, iri, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(std::wstring(uri.hostText.first, uri.hostText.afterLast),
+			L"b\x00FC" L"cher.example");
+	uriFreeUriMembersW(&uri);
+
+	wchar_t dest[64];
+	ASSERT_EQ(uriIriToUriStringW(dest, iri, NULL, 64, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(std::wstring(dest), L"http://b%C3%BCcher.example/%E2%82%AC");
+}
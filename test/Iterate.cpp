@@ -0,0 +1,219 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#undef NDEBUG  // because we rely on assert(3) further down
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <uriparser/Uri.h>
+#include <uriparser/Uri.hpp>
+
+
+
+namespace {
+
+std::vector<std::string> pathSegments(const char * path) {
+	std::vector<std::string> segments;
+	UriPathIteratorA iterator;
+	UriTextRangeA segment;
+
+	EXPECT_EQ(uriPathIteratorInitA(&iterator, path, path + strlen(path)),
+			URI_SUCCESS);
+	while (uriPathIteratorNextA(&iterator, &segment)) {
+		segments.push_back(std::string(segment.first, segment.afterLast));
+	}
+	return segments;
+}
+
+
+
+void assertSameAsDissectQuery(const char * query) {
+	const char * const first = query;
+	const char * const afterLast = first + strlen(first);
+	UriQueryListA * queryList = NULL;
+	int itemCount = -1;
+	UriQueryIteratorA iterator;
+	UriTextRangeA key;
+	UriTextRangeA value;
+	char keyScratch[64];
+	char valueScratch[64];
+	UriTextRangeA decodedKey;
+	UriTextRangeA decodedValue;
+	int pairCount = 0;
+
+	SCOPED_TRACE(query);
+	ASSERT_EQ(uriDissectQueryMallocA(&queryList, &itemCount, first, afterLast),
+			URI_SUCCESS);
+	ASSERT_EQ(uriQueryIteratorInitA(&iterator, first, afterLast), URI_SUCCESS);
+
+	const UriQueryListA * walk = queryList;
+	while (uriQueryIteratorNextA(&iterator, &key, &value)) {
+		ASSERT_TRUE(walk != NULL);
+		ASSERT_EQ(uriUnescapeRangeExA(&key, keyScratch, sizeof(keyScratch),
+				&decodedKey, URI_TRUE, URI_BR_DONT_TOUCH), URI_SUCCESS);
+		ASSERT_EQ(uriUnescapeRangeExA(&value, valueScratch, sizeof(valueScratch),
+				&decodedValue, URI_TRUE, URI_BR_DONT_TOUCH), URI_SUCCESS);
+		ASSERT_EQ(std::string(decodedKey.first, decodedKey.afterLast), walk->key);
+		if (walk->value == NULL) {
+			ASSERT_TRUE(decodedValue.first == NULL);
+		} else {
+			ASSERT_TRUE(decodedValue.first != NULL);
+			ASSERT_EQ(std::string(decodedValue.first, decodedValue.afterLast),
+					walk->value);
+		}
+		walk = walk->next;
+		pairCount++;
+	}
+	ASSERT_TRUE(walk == NULL);
+	ASSERT_EQ(pairCount, itemCount);
+
+	uriFreeQueryListA(queryList);
+}
+
+}  // namespace
+
+
+
+TEST(PathIteratorSuite, Segments) {
+	ASSERT_EQ(pathSegments(""), std::vector<std::string>());
+	ASSERT_EQ(pathSegments("/"), std::vector<std::string>());
+	ASSERT_EQ(pathSegments("a"), std::vector<std::string>({"a"}));
+	ASSERT_EQ(pathSegments("/a"), std::vector<std::string>({"a"}));
+	ASSERT_EQ(pathSegments("/a/"), std::vector<std::string>({"a", ""}));
+	ASSERT_EQ(pathSegments("//"), std::vector<std::string>({"", ""}));
+	ASSERT_EQ(pathSegments("a//b%2Fc"), std::vector<std::string>({"a", "", "b%2Fc"}));
+}
+
+
+
+TEST(PathIteratorSuite, InvalidArguments) {
+	UriPathIteratorA iterator;
+	UriTextRangeA segment;
+	const char * const path = "/a";
+
+	ASSERT_EQ(uriPathIteratorInitA(NULL, path, path + 2), URI_ERROR_NULL);
+	ASSERT_EQ(uriPathIteratorInitA(&iterator, path, NULL), URI_ERROR_NULL);
+	ASSERT_EQ(uriPathIteratorInitA(&iterator, path + 2, path),
+			URI_ERROR_RANGE_INVALID);
+
+	ASSERT_EQ(uriPathIteratorInitA(&iterator, NULL, NULL), URI_SUCCESS);
+	ASSERT_FALSE(uriPathIteratorNextA(&iterator, &segment));
+}
+
+
+
+TEST(QueryIteratorSuite, SameAsDissectQuery) {
+	const char * const queries[] = {
+		"", "&", "&&", "=", "==", "a", "a=", "a=b", "a=b=c", "=b",
+		"a&b", "a&&b&", "&a=1&b=2&", "k%20ey=v+a%2Bl&x", "a=%41%",
+	};
+	for (size_t i = 0; i < sizeof(queries) / sizeof(queries[0]); i++) {
+		assertSameAsDissectQuery(queries[i]);
+	}
+}
+
+
+
+TEST(QueryIteratorSuite, QueryOfParsedUri) {
+	UriUriA uri;
+	UriQueryIteratorA iterator;
+	UriTextRangeA key;
+	UriTextRangeA value;
+	const char * const text = "http://example.org/";
+
+	ASSERT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	ASSERT_EQ(uriQueryIteratorInitA(&iterator, uri.query.first,
+			uri.query.afterLast), URI_SUCCESS);
+	ASSERT_FALSE(uriQueryIteratorNextA(&iterator, &key, &value));
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(UnescapeRangeSuite, BufferTooSmall) {
+	const char * const text = "a%20b";
+	UriTextRangeA source;
+	UriTextRangeA decoded;
+	char dest[6];
+
+	source.first = text;
+	source.afterLast = text + strlen(text);
+
+	ASSERT_EQ(uriUnescapeRangeExA(&source, dest, 5, &decoded,
+			URI_FALSE, URI_BR_DONT_TOUCH), URI_ERROR_OUTPUT_TOO_LARGE);
+	ASSERT_EQ(uriUnescapeRangeExA(&source, dest, 6, &decoded,
+			URI_FALSE, URI_BR_DONT_TOUCH), URI_SUCCESS);
+	ASSERT_EQ(decoded.first, dest);
+	ASSERT_EQ(decoded.afterLast, dest + 3);
+	ASSERT_STREQ(dest, "a b");
+}
+
+
+
+TEST(UnescapeRangeSuite, Wide) {
+	const wchar_t * const text = L"k=a%2Fb";
+	UriQueryIteratorW iterator;
+	UriTextRangeW key;
+	UriTextRangeW value;
+	UriTextRangeW decoded;
+	wchar_t dest[8];
+
+	ASSERT_EQ(uriQueryIteratorInitW(&iterator, text, text + wcslen(text)),
+			URI_SUCCESS);
+	ASSERT_TRUE(uriQueryIteratorNextW(&iterator, &key, &value));
+	ASSERT_EQ(uriUnescapeRangeExW(&value, dest, 8, &decoded,
+			URI_TRUE, URI_BR_DONT_TOUCH), URI_SUCCESS);
+	ASSERT_EQ(std::wstring(decoded.first, decoded.afterLast), L"a/b");
+	ASSERT_FALSE(uriQueryIteratorNextW(&iterator, &key, &value));
+}
+
+
+
+TEST(IteratorRangesSuite, PathSegments) {
+	const char * const path = "/one/two/";
+	std::vector<std::string> segments;
+
+	for (const UriTextRangeA & segment : uriparser::PathSegments(path, path + strlen(path))) {
+		segments.push_back(std::string(segment.first, segment.afterLast));
+	}
+	ASSERT_EQ(segments, std::vector<std::string>({"one", "two", ""}));
+}
+
+
+
+TEST(IteratorRangesSuite, QueryPairs) {
+	UriUriA uri;
+	std::vector<std::string> keys;
+	int valueCount = 0;
+
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://example.org/?a=1&b&c=", NULL),
+			URI_SUCCESS);
+	for (const uriparser::QueryPair & pair : uriparser::QueryPairs(uri)) {
+		keys.push_back(std::string(pair.key.first, pair.key.afterLast));
+		valueCount += pair.hasValue() ? 1 : 0;
+	}
+	ASSERT_EQ(keys, std::vector<std::string>({"a", "b", "c"}));
+	ASSERT_EQ(valueCount, 2);
+	uriFreeUriMembersA(&uri);
+}
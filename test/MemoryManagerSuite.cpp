@@ -24,9 +24,12 @@
 #include <cassert>
 #include <cerrno>
 #include <cstring>  // memcpy
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <uriparser/Uri.h>
+#include <uriparser/Uri.hpp>
 
 // For defaultMemoryManager
 extern "C" {
@@ -326,6 +329,23 @@ TEST(FailingMemoryManagerSuite, ComposeQueryMallocExMm) {
 
 
 
+TEST(FailingMemoryManagerSuite, CopyUriMmPathSegments) {
+	UriUriA uri = parse("http://example.com/a/b/c");
+
+	// Host, then struct and text per segment; failing at any point leaks nothing
+	for (unsigned int failAllocAfterTimes = 0; failAllocAfterTimes < 8;
+			failAllocAfterTimes++) {
+		FailingMemoryManager failingMemoryManager(failAllocAfterTimes);
+		UriUriA copy;
+		ASSERT_EQ(uriCopyUriMmA(&copy, &uri, &failingMemoryManager), URI_ERROR_MALLOC);
+		EXPECT_EQ(failingMemoryManager.getCallCountFree(), failAllocAfterTimes);
+	}
+
+	uriFreeUriMembersA(&uri);
+}
+
+
+
 TEST(FailingMemoryManagerSuite, DissectQueryMallocExMm) {
 	UriQueryListA * queryList;
 	int itemCount;
@@ -495,6 +515,36 @@ TEST(FailingMemoryManagerSuite, NormalizeSyntaxExMmHostTextFuture) {  // issue #
 	testNormalizeSyntaxWithFailingMallocCallsFreeTimes("//[v7.X]:123" /* arbitrary IPvFuture */, URI_NORMALIZE_HOST, 1, 1);
 }
 
+TEST(FailingMemoryManagerSuite, NormalizeHostIdnaMm) {
+	UriUriA uri = parse("//b%C3%BCcher.test:123");
+	FailingMemoryManager failingMemoryManager;
+
+	ASSERT_EQ(uriNormalizeHostIdnaMmA(&uri, &failingMemoryManager),
+			URI_ERROR_MALLOC);
+	EXPECT_EQ(failingMemoryManager.getCallCountFree(), 0U);
+
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(FailingMemoryManagerSuite, NormalizeHostIdnaMmWithoutAllocation) {
+	const char * const uriStrings[] = {
+		"http://ascii.example/",  // nothing to convert
+		"http://%E4%BB%96%E4%BB%AC%E4%B8%BA.example/",  // shrinks
+	};
+	for (size_t i = 0; i < sizeof(uriStrings) / sizeof(uriStrings[0]); i++) {
+		UriUriA uri = parse(uriStrings[i]);
+		ASSERT_EQ(uriMakeOwnerA(&uri), URI_SUCCESS);
+		FailingMemoryManager failingMemoryManager;
+
+		ASSERT_EQ(uriNormalizeHostIdnaMmA(&uri, &failingMemoryManager),
+				URI_SUCCESS);
+		EXPECT_EQ(failingMemoryManager.getCallCountAlloc(), 0U);
+		EXPECT_EQ(failingMemoryManager.getCallCountFree(), 0U);
+
+		uriFreeUriMembersA(&uri);
+	}
+}
+
 
 
 TEST(FailingMemoryManagerSuite, ParseSingleUriExMm) {
@@ -510,6 +560,282 @@ TEST(FailingMemoryManagerSuite, ParseSingleUriExMm) {
 
 
 
+TEST(FailingMemoryManagerSuite, ParseSingleUriExMmFastPath) {
+	UriUriA uri;
+	const char * const first = "http://127.0.0.1/a/b";
+	const char * const afterLast = first + strlen(first);
+
+	// IPv4 host data, then one allocation per path segment
+	for (unsigned int failAllocAfterTimes = 0; failAllocAfterTimes < 3;
+			failAllocAfterTimes++) {
+		FailingMemoryManager failingMemoryManager(failAllocAfterTimes);
+
+		ASSERT_EQ(uriParseSingleUriExMmA(&uri, first, afterLast, NULL,
+				&failingMemoryManager),
+				URI_ERROR_MALLOC);
+		ASSERT_EQ(failingMemoryManager.getCallCountAlloc(), failAllocAfterTimes + 1);
+		ASSERT_EQ(failingMemoryManager.getCallCountFree(), failAllocAfterTimes);
+	}
+}
+
+
+
+TEST(FailingMemoryManagerSuite, BatchAppendUri) {
+	UriUriA uri = parse("http://example.com/a?b#c");
+
+	// Validity bitmaps, dictionary indices or offsets, hash tables
+	// and values, in order; failing at any point adds no row
+	bool succeeded = false;
+	for (unsigned int failAllocAfterTimes = 0; !succeeded && (failAllocAfterTimes < 64);
+			failAllocAfterTimes++) {
+		FailingMemoryManager failingMemoryManager(failAllocAfterTimes);
+		UriBatchA batch;
+		ASSERT_EQ(uriInitBatchMmA(&batch, URI_BATCH_DICTIONARY_HOST,
+				&failingMemoryManager), URI_SUCCESS);
+
+		const int res = uriBatchAppendUriA(&batch, &uri);
+		if (res == URI_SUCCESS) {
+			EXPECT_GT(failAllocAfterTimes, 10U);
+			EXPECT_EQ(batch.count, 1);
+			succeeded = true;
+		} else {
+			ASSERT_EQ(res, URI_ERROR_MALLOC);
+			EXPECT_EQ(batch.count, 0);
+		}
+
+		uriFreeBatchMembersA(&batch);
+		EXPECT_EQ(failingMemoryManager.getCallCountFree(),
+				failingMemoryManager.getCallCountAlloc()
+				- ((res == URI_SUCCESS) ? 0 : 1));
+	}
+	EXPECT_TRUE(succeeded);
+
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(FailingMemoryManagerSuite, DeserializeUriMm) {
+	UriUriA uri = parse("http://127.0.0.1/a/b");
+	std::vector<unsigned int> data(64);  // aligned
+	ASSERT_EQ(uriSerializeUriA(&data[0], &uri, 4 * 64, NULL), URI_SUCCESS);
+	uriFreeUriMembersA(&uri);
+
+	// IPv4 host data, then one allocation per path segment
+	for (unsigned int failAllocAfterTimes = 0; failAllocAfterTimes < 3;
+			failAllocAfterTimes++) {
+		FailingMemoryManager failingMemoryManager(failAllocAfterTimes);
+
+		ASSERT_EQ(uriDeserializeUriMmA(&uri, &data[0], 4 * 64, NULL,
+				&failingMemoryManager),
+				URI_ERROR_MALLOC);
+		ASSERT_EQ(failingMemoryManager.getCallCountAlloc(), failAllocAfterTimes + 1);
+		ASSERT_EQ(failingMemoryManager.getCallCountFree(), failAllocAfterTimes);
+	}
+}
+
+
+
+static UriBool countStrings(void * /*userData*/, const char * /*first*/,
+		const char * /*afterLast*/, int /*rank*/) {
+	return URI_TRUE;
+}
+
+
+
+TEST(FailingMemoryManagerSuite, BuildCompressedSetMm) {
+	UriTextRangeA uris[2];
+	uris[0].first = "http://a/";
+	uris[0].afterLast = uris[0].first + strlen(uris[0].first);
+	uris[1].first = "http://b/";
+	uris[1].afterLast = uris[1].first + strlen(uris[1].first);
+
+	// One allocation for the whole set
+	FailingMemoryManager failingMemoryManager(0);
+	UriCompressedSetA * set = NULL;
+	ASSERT_EQ(uriBuildCompressedSetMmA(&set, uris, 2, NULL, &failingMemoryManager),
+			URI_ERROR_MALLOC);
+	ASSERT_TRUE(set == NULL);
+
+	// Enumeration allocates its buffer from the same memory manager
+	FailingMemoryManager enumerateMemoryManager(1);
+	ASSERT_EQ(uriBuildCompressedSetMmA(&set, uris, 2, NULL, &enumerateMemoryManager),
+			URI_SUCCESS);
+	EXPECT_EQ(uriCompressedSetEnumeratePrefixA(set, "http://", NULL,
+			countStrings, NULL), URI_ERROR_MALLOC);
+	uriFreeCompressedSetA(set);
+	EXPECT_EQ(enumerateMemoryManager.getCallCountFree(), 1U);
+}
+
+
+
+TEST(FailingMemoryManagerSuite, CreateSeenFilterMm) {
+	FailingMemoryManager failingMemoryManager(0);
+	UriSeenFilter * filter = NULL;
+	ASSERT_EQ(uriCreateSeenFilterMm(&filter, 1000, 0.01, &failingMemoryManager),
+			URI_ERROR_MALLOC);
+	ASSERT_TRUE(filter == NULL);
+}
+
+
+
+TEST(FailingMemoryManagerSuite, NormalizedHashMm) {
+	UriUriA uri = parse("http://example.com/a/../b");
+	UriUint64 hash = 0;
+
+	// A copy to normalize, failing at any allocation
+	bool succeeded = false;
+	for (unsigned int failAllocAfterTimes = 0; !succeeded && (failAllocAfterTimes < 16);
+			failAllocAfterTimes++) {
+		FailingMemoryManager failingMemoryManager(failAllocAfterTimes);
+		const int res = uriNormalizedHashMmA(&uri, 0, &hash, &failingMemoryManager);
+		if (res == URI_SUCCESS) {
+			EXPECT_GT(failAllocAfterTimes, 0U);
+			succeeded = true;
+		} else {
+			ASSERT_EQ(res, URI_ERROR_MALLOC);
+		}
+		EXPECT_EQ(failingMemoryManager.getCallCountFree(),
+				failingMemoryManager.getCallCountAlloc()
+				- ((res == URI_SUCCESS) ? 0 : 1));
+	}
+	EXPECT_TRUE(succeeded);
+
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(FailingMemoryManagerSuite, NormalizedHashMmHostCaseWithoutCopy) {
+	UriUriA mixed = parse("HTTP://Example.COM/a");
+	UriUriA lower = parse("http://example.com/a");
+	UriUint64 mixedHash = 0;
+	UriUint64 lowerHash = 1;
+
+	// Host case is folded while hashing, so no copy is needed
+	FailingMemoryManager failingMemoryManager(0);
+	ASSERT_EQ(uriNormalizedHashMmA(&mixed, 0, &mixedHash, &failingMemoryManager),
+			URI_SUCCESS);
+	ASSERT_EQ(uriNormalizedHashMmA(&lower, 0, &lowerHash, &failingMemoryManager),
+			URI_SUCCESS);
+	EXPECT_EQ(mixedHash, lowerHash);
+	EXPECT_EQ(failingMemoryManager.getCallCountAlloc(), 0U);
+
+	uriFreeUriMembersA(&mixed);
+	uriFreeUriMembersA(&lower);
+}
+
+
+
+TEST(FailingMemoryManagerSuite, ParseOriginFormExMm) {
+	UriUriA uri;
+	const char * const first = "/a/b?c";
+	const char * const afterLast = first + strlen(first);
+
+	// One allocation per path segment
+	for (unsigned int failAllocAfterTimes = 0; failAllocAfterTimes < 2;
+			failAllocAfterTimes++) {
+		FailingMemoryManager failingMemoryManager(failAllocAfterTimes);
+
+		ASSERT_EQ(uriParseOriginFormExMmA(&uri, first, afterLast, NULL,
+				&failingMemoryManager),
+				URI_ERROR_MALLOC);
+		ASSERT_EQ(failingMemoryManager.getCallCountAlloc(), failAllocAfterTimes + 1);
+		ASSERT_EQ(failingMemoryManager.getCallCountFree(), failAllocAfterTimes);
+	}
+}
+
+
+
+TEST(FailingMemoryManagerSuite, ParseAuthorityExMm) {
+	const char * const cases[] = {
+		"user@example.org:80",
+		"127.0.0.1:80",
+		"[::1]:80",
+		"[v7.host]",
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		const char * const first = cases[i];
+		const char * const afterLast = first + strlen(first);
+		UriAuthorityA authority;
+		FailingMemoryManager failingMemoryManager;
+
+		ASSERT_EQ(uriParseAuthorityExMmA(&authority, first, afterLast, NULL,
+				&failingMemoryManager),
+				URI_SUCCESS);
+		ASSERT_EQ(failingMemoryManager.getCallCountAlloc(), 0U);
+		ASSERT_EQ(failingMemoryManager.getCallCountFree(), 0U);
+	}
+}
+
+
+
+static UriBool countUriListItem(void * userData, const UriUriA * uri,
+		const char * /*first*/, const char * /*afterLast*/,
+		int /*errorCode*/, const char * /*errorPos*/) {
+	if (uri != NULL) {
+		(*static_cast<int *>(userData))++;
+	}
+	return URI_TRUE;
+}
+
+
+
+TEST(FailingMemoryManagerSuite, ParseUriListExMm) {
+	const std::string text = "http://example.org/a/b/c?q#f\n"
+			"http://127.0.0.1/one/two/three\n"
+			"http://[::1]/\n";
+	int count = 0;
+	FailingMemoryManager failingMemoryManager;
+
+	ASSERT_EQ(uriParseUriListExMmA(text.c_str(), text.c_str() + text.size(),
+			URI_LIST_LINES, countUriListItem, &count, &failingMemoryManager),
+			URI_SUCCESS);
+	ASSERT_EQ(count, 3);
+	ASSERT_EQ(failingMemoryManager.getCallCountAlloc(), 0U);
+	ASSERT_EQ(failingMemoryManager.getCallCountFree(), 0U);
+}
+
+
+
+TEST(FailingMemoryManagerSuite, ParseUriListExMmManySegments) {
+	std::string text = "http://example.org";
+	for (int i = 0; i < 1000; i++) {
+		text += "/s";
+	}
+	text += "\nhttp://example.org/\n";
+
+	// More path segments than fit inline need the backend
+	{
+		int count = 0;
+		FailingMemoryManager failingMemoryManager(1000);
+
+		ASSERT_EQ(uriParseUriListExMmA(text.c_str(),
+				text.c_str() + text.size(), URI_LIST_LINES,
+				countUriListItem, &count, &failingMemoryManager),
+				URI_SUCCESS);
+		ASSERT_EQ(count, 2);
+		ASSERT_GT(failingMemoryManager.getCallCountAlloc(), 0U);
+		ASSERT_EQ(failingMemoryManager.getCallCountFree(),
+				failingMemoryManager.getCallCountAlloc());
+	}
+
+	// ..and report their failure
+	{
+		int count = 0;
+		FailingMemoryManager failingMemoryManager;
+
+		ASSERT_EQ(uriParseUriListExMmA(text.c_str(),
+				text.c_str() + text.size(), URI_LIST_LINES,
+				countUriListItem, &count, &failingMemoryManager),
+				URI_ERROR_MALLOC);
+		ASSERT_EQ(count, 0);
+		ASSERT_EQ(failingMemoryManager.getCallCountFree(), 0U);
+	}
+}
+
+
+
 TEST(FailingMemoryManagerSuite, RemoveBaseUriMm) {
 	UriUriA dest;
 	UriUriA absoluteSource = parse("http://example.org/a/b/c/");
@@ -524,3 +850,123 @@ TEST(FailingMemoryManagerSuite, RemoveBaseUriMm) {
 	uriFreeUriMembersA(&absoluteSource);
 	uriFreeUriMembersA(&absoluteBase);
 }
+
+
+
+#ifdef URI_HAVE_PMR
+
+namespace {
+
+class CountingMemoryResource : public std::pmr::memory_resource {
+private:
+	std::pmr::memory_resource * upstream;
+	size_t bytesInUse;
+	unsigned int callCountAllocate;
+
+public:
+	CountingMemoryResource()
+			: upstream(std::pmr::new_delete_resource()),
+			bytesInUse(0), callCountAllocate(0) { }
+
+	size_t getBytesInUse() const {
+		return this->bytesInUse;
+	}
+
+	unsigned int getCallCountAllocate() const {
+		return this->callCountAllocate;
+	}
+
+private:
+	void * do_allocate(size_t bytes, size_t alignment) override {
+		void * const buffer = this->upstream->allocate(bytes, alignment);
+		this->bytesInUse += bytes;
+		this->callCountAllocate++;
+		return buffer;
+	}
+
+	void do_deallocate(void * p, size_t bytes, size_t alignment) override {
+		assert(this->bytesInUse >= bytes);
+		this->bytesInUse -= bytes;
+		this->upstream->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+		return this == &other;
+	}
+};
+
+}  // namespace
+
+
+
+TEST(PmrMemoryManagerSuite, PassesMemoryManagerTest) {
+	uriparser::PmrMemoryManager pmrMemoryManager;
+	ASSERT_EQ(uriTestMemoryManagerEx(pmrMemoryManager.get(), URI_TRUE),
+			URI_SUCCESS);
+}
+
+
+
+TEST(PmrMemoryManagerSuite, DeallocatesWithMatchingSize) {
+	CountingMemoryResource resource;
+	uriparser::PmrMemoryManager pmrMemoryManager(&resource);
+	UriMemoryManager * const memory = pmrMemoryManager.get();
+	UriUriA uri;
+	UriQueryListA * queryList = NULL;
+	int itemCount = 0;
+	const char * const first = "HTTP://User@Example.ORG:0080/a/./b/../c?k1=v1&k2=%7e#frag";
+	const char * const afterLast = first + strlen(first);
+
+	ASSERT_EQ(uriParseSingleUriExMmA(&uri, first, afterLast, NULL, memory),
+			URI_SUCCESS);
+	ASSERT_EQ(uriNormalizeSyntaxExMmA(&uri, (unsigned int)-1, memory),
+			URI_SUCCESS);
+	ASSERT_EQ(uriDissectQueryMallocExMmA(&queryList, &itemCount,
+			uri.query.first, uri.query.afterLast,
+			URI_TRUE, URI_BR_DONT_TOUCH, memory),
+			URI_SUCCESS);
+	ASSERT_EQ(itemCount, 2);
+	ASSERT_GT(resource.getCallCountAllocate(), 0U);
+	ASSERT_GT(resource.getBytesInUse(), 0U);
+
+	uriFreeQueryListMmA(queryList, memory);
+	uriFreeUriMembersMmA(&uri, memory);
+
+	ASSERT_EQ(resource.getBytesInUse(), 0U);
+}
+
+
+
+TEST(PmrMemoryManagerSuite, MonotonicBufferWithoutHeap) {
+	alignas(std::max_align_t) char arena[4096];
+	std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena),
+			std::pmr::null_memory_resource());
+	uriparser::PmrMemoryManager pmrMemoryManager(&resource);
+	UriUriA uri;
+	const char * const first = "http://example.org/one/two/three?query#fragment";
+	const char * const afterLast = first + strlen(first);
+
+	ASSERT_EQ(uriParseSingleUriExMmA(&uri, first, afterLast, NULL,
+			pmrMemoryManager.get()),
+			URI_SUCCESS);
+	ASSERT_EQ(uri.pathHead->text.first, first + strlen("http://example.org/"));
+	uriFreeUriMembersMmA(&uri, pmrMemoryManager.get());
+}
+
+
+
+TEST(PmrMemoryManagerSuite, ExhaustedResourceReportsMalloc) {
+	alignas(std::max_align_t) char arena[64];
+	std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena),
+			std::pmr::null_memory_resource());
+	uriparser::PmrMemoryManager pmrMemoryManager(&resource);
+	UriUriA uri;
+	const char * const first = "http://example.org/one/two/three/four/five/six";
+	const char * const afterLast = first + strlen(first);
+
+	ASSERT_EQ(uriParseSingleUriExMmA(&uri, first, afterLast, NULL,
+			pmrMemoryManager.get()),
+			URI_ERROR_MALLOC);
+}
+
+#endif  // URI_HAVE_PMR
@@ -0,0 +1,223 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#undef NDEBUG  // because we rely on assert(3) further down
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include <uriparser/Uri.h>
+
+
+
+extern "C" {
+UriBool uri_TESTING_ONLY_ParseUriFastA(UriUriA * uri, const char * first,
+		const char * afterLast);
+int uri_TESTING_ONLY_ParseUriFullA(UriUriA * uri, const char * first,
+		const char * afterLast, const char ** errorPos);
+}
+
+
+
+namespace {
+
+void assertSameRange(const UriTextRangeA & actual,
+		const UriTextRangeA & expected, const char * component) {
+	EXPECT_EQ(actual.first, expected.first) << component;
+	EXPECT_EQ(actual.afterLast, expected.afterLast) << component;
+}
+
+
+
+void assertSameUri(const UriUriA & actual, const UriUriA & expected) {
+	assertSameRange(actual.scheme, expected.scheme, "scheme");
+	assertSameRange(actual.userInfo, expected.userInfo, "userInfo");
+	assertSameRange(actual.hostText, expected.hostText, "hostText");
+	assertSameRange(actual.portText, expected.portText, "portText");
+	assertSameRange(actual.query, expected.query, "query");
+	assertSameRange(actual.fragment, expected.fragment, "fragment");
+	assertSameRange(actual.hostData.ipFuture, expected.hostData.ipFuture, "ipFuture");
+
+	ASSERT_EQ(actual.hostData.ip4 == NULL, expected.hostData.ip4 == NULL);
+	if (actual.hostData.ip4 != NULL) {
+		EXPECT_EQ(0, memcmp(actual.hostData.ip4->data,
+				expected.hostData.ip4->data, sizeof(UriIp4)));
+	}
+	ASSERT_EQ(actual.hostData.ip6 == NULL, expected.hostData.ip6 == NULL);
+	if (actual.hostData.ip6 != NULL) {
+		EXPECT_EQ(0, memcmp(actual.hostData.ip6->data,
+				expected.hostData.ip6->data, sizeof(UriIp6)));
+	}
+
+	const UriPathSegmentA * actualSegment = actual.pathHead;
+	const UriPathSegmentA * expectedSegment = expected.pathHead;
+	while ((actualSegment != NULL) && (expectedSegment != NULL)) {
+		assertSameRange(actualSegment->text, expectedSegment->text, "segment");
+		if ((actualSegment->next == NULL) && (expectedSegment->next == NULL)) {
+			EXPECT_EQ(actual.pathTail, actualSegment);
+			EXPECT_EQ(expected.pathTail, expectedSegment);
+		}
+		actualSegment = actualSegment->next;
+		expectedSegment = expectedSegment->next;
+	}
+	EXPECT_TRUE(actualSegment == NULL) << "Extra path segments";
+	EXPECT_TRUE(expectedSegment == NULL) << "Missing path segments";
+
+	EXPECT_EQ(actual.absolutePath, expected.absolutePath);
+	EXPECT_EQ(actual.owner, expected.owner);
+}
+
+
+
+void assertSameAsFullParser(const std::string & text) {
+	const char * const first = text.c_str();
+	const char * const afterLast = first + text.size();
+	const char * errorPos = NULL;
+	const char * errorPosFull = NULL;
+	UriUriA uri;
+	UriUriA uriFull;
+
+	SCOPED_TRACE(text);
+	const int res = uriParseSingleUriExA(&uri, first, afterLast, &errorPos);
+	const int resFull = uri_TESTING_ONLY_ParseUriFullA(&uriFull, first,
+			afterLast, &errorPosFull);
+	ASSERT_EQ(res, resFull);
+	if (res != URI_SUCCESS) {
+		EXPECT_EQ(errorPos, errorPosFull);
+		return;
+	}
+
+	assertSameUri(uri, uriFull);
+
+	uriFreeUriMembersA(&uri);
+	uriFreeUriMembersA(&uriFull);
+}
+
+
+
+bool takesFastPath(const char * text) {
+	UriUriA uri;
+	const UriBool res = uri_TESTING_ONLY_ParseUriFastA(&uri, text,
+			text + strlen(text));
+	if (res == URI_TRUE) {
+		uriFreeUriMembersA(&uri);
+	}
+	return res == URI_TRUE;
+}
+
+}  // namespace
+
+
+
+TEST(ParseFastPathSuite, TakesFastPath) {
+	EXPECT_TRUE(takesFastPath("http://example.org"));
+	EXPECT_TRUE(takesFastPath("http://example.org/"));
+	EXPECT_TRUE(takesFastPath("https://www.example.org:8443/a/b.html?c=d&e#f"));
+	EXPECT_TRUE(takesFastPath("HTTP://EXAMPLE.ORG:/?#"));
+	EXPECT_TRUE(takesFastPath("http://127.0.0.1/"));
+	EXPECT_TRUE(takesFastPath("http://example.org/%7Euser/?q=%C3%A4"));
+	EXPECT_TRUE(takesFastPath("ws://example.org//a//"));
+}
+
+
+
+TEST(ParseFastPathSuite, BailsOut) {
+	EXPECT_FALSE(takesFastPath(""));
+	EXPECT_FALSE(takesFastPath("/path"));
+	EXPECT_FALSE(takesFastPath("//example.org/"));
+	EXPECT_FALSE(takesFastPath("mailto:user@example.org"));
+	EXPECT_FALSE(takesFastPath("file:///etc/hosts"));
+	EXPECT_FALSE(takesFastPath("http://user@example.org/"));
+	EXPECT_FALSE(takesFastPath("http://[::1]/"));
+	EXPECT_FALSE(takesFastPath("http://ex%41mple.org/"));
+	EXPECT_FALSE(takesFastPath("http://example.org:80x/"));
+	EXPECT_FALSE(takesFastPath("http://example.org/a b"));
+	EXPECT_FALSE(takesFastPath("http://example.org/%4"));
+	EXPECT_FALSE(takesFastPath("http://example.org/?#a#"));
+}
+
+
+
+TEST(ParseFastPathSuite, SameAsFullParserCorpus) {
+	const char * const corpus[] = {
+		"", "http:", "http:/", "http://", "http:///", "http://a", "http://a/",
+		"http://a:", "http://a:/", "http://a:80", "http://a:80/", "http://a::",
+		"http://a?", "http://a#", "http://a?#", "http://a#?", "http://a??",
+		"http://a##", "http://a/?/?", "http://a/#/#", "http://a//", "http://a/b/",
+		"http://a/b//c", "http://a/./../b", "http://a/%41%4a%4A",
+		"http://a/%", "http://a/%4", "http://a/%4g", "http://a?%", "http://a#%4",
+		"http://1.2.3.4", "http://1.2.3.04", "http://1.2.3.256",
+		"http://1.2.3", "http://1.2.3.4.", "http://0.0.0.0:0/", "http://1..2",
+		"http://a.b-c_d~e/", "http://a!b/", "http://a@b/", "http://a:b@c/",
+		"http://a:80@b/", "http://a:80x", "http://[::1]/", "http://a b",
+		"http://a/\x80", "http://\xc3\xa4/", "h+t.t-p://a/", "1http://a/",
+		"http:/a", "http:a", "http//a", "http://a/:@!$&'()*+,;=-._~",
+		"http://a?:@!$&'()*+,;=-._~/?", "http://a/<", "http://a?<",
+		"http://a#<", "http://a/[", "http://a/\\", "http://a/^",
+	};
+	for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+		assertSameAsFullParser(corpus[i]);
+	}
+}
+
+
+
+TEST(ParseFastPathSuite, SameAsFullParserRandom) {
+	const char * const tokens[] = {
+		"http://", "https://", "a", "Z", "0", "1", "255", "256", ".", "-",
+		"_", "~", ":", "/", "//", "?", "#", "@", "%", "%4", "%41", "[",
+		"]", "::1", "!", "+", " ", "<", "\x80",
+	};
+	const size_t tokenCount = sizeof(tokens) / sizeof(tokens[0]);
+	std::mt19937 generator(20261018);
+	std::uniform_int_distribution<size_t> lengthDistribution(1, 10);
+	std::uniform_int_distribution<size_t> tokenDistribution(1, tokenCount - 1);
+
+	for (int i = 0; i < 200000; i++) {
+		std::string text = tokens[i % 2];  // "http://" or "https://"
+		const size_t length = lengthDistribution(generator);
+		for (size_t k = 0; k < length; k++) {
+			text += tokens[tokenDistribution(generator)];
+		}
+		assertSameAsFullParser(text);
+		if (::testing::Test::HasFailure()) {
+			return;
+		}
+	}
+}
+
+
+
+TEST(ParseFastPathSuite, WideCharacters) {
+	const wchar_t * const text = L"http://example.org:80/a/b?c#d";
+	UriUriW uri;
+	ASSERT_EQ(uriParseSingleUriW(&uri, text, NULL), URI_SUCCESS);
+	EXPECT_EQ(uri.portText.first, text + 19);
+	EXPECT_EQ(uri.pathHead->next->text.first, text + 24);
+	EXPECT_EQ(uri.query.first, text + 26);
+	EXPECT_EQ(uri.fragment.first, text + 28);
+	uriFreeUriMembersW(&uri);
+
+	const wchar_t nonAscii[] = {L'h', L't', L't', L'p', L':', L'/', L'/',
+			L'a', L'/', static_cast<wchar_t>(0x12f), 0};
+	ASSERT_EQ(uriParseSingleUriW(&uri, nonAscii, NULL), URI_ERROR_SYNTAX);
+}
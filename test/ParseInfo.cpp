@@ -0,0 +1,330 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#undef NDEBUG  // because we rely on assert(3) further down
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+UriScheme identifySchemeA(const char * text) {
+	return uriIdentifySchemeA(text, text + strlen(text));
+}
+
+
+
+UriParseInfo parseInfoA(const char * text, int expectedResult = URI_SUCCESS) {
+	UriUriA uri;
+	UriParseInfo info;
+	memset(&info, 0xff, sizeof(info));
+	EXPECT_EQ(uriParseSingleUriInfoExA(&uri, text, NULL, NULL, &info),
+			expectedResult) << text;
+	if (expectedResult == URI_SUCCESS) {
+		uriFreeUriMembersA(&uri);
+	}
+	return info;
+}
+
+}  // namespace
+
+
+
+TEST(ParseInfoSuite, IdentifyScheme) {
+	EXPECT_EQ(identifySchemeA("http"), URI_SCHEME_HTTP);
+	EXPECT_EQ(identifySchemeA("https"), URI_SCHEME_HTTPS);
+	EXPECT_EQ(identifySchemeA("ws"), URI_SCHEME_WS);
+	EXPECT_EQ(identifySchemeA("wss"), URI_SCHEME_WSS);
+	EXPECT_EQ(identifySchemeA("ftp"), URI_SCHEME_FTP);
+	EXPECT_EQ(identifySchemeA("file"), URI_SCHEME_FILE);
+	EXPECT_EQ(identifySchemeA("mailto"), URI_SCHEME_MAILTO);
+	EXPECT_EQ(identifySchemeA("data"), URI_SCHEME_DATA);
+	EXPECT_EQ(identifySchemeA("urn"), URI_SCHEME_URN);
+
+	EXPECT_EQ(identifySchemeA("HtTpS"), URI_SCHEME_HTTPS);
+	EXPECT_EQ(identifySchemeA("MAILTO"), URI_SCHEME_MAILTO);
+
+	EXPECT_EQ(identifySchemeA(""), URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(identifySchemeA("h"), URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(identifySchemeA("htt"), URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(identifySchemeA("httpx"), URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(identifySchemeA("http+unix"), URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(identifySchemeA("wsx"), URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(identifySchemeA("h\x01tp"), URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(uriIdentifySchemeA(NULL, NULL), URI_SCHEME_NONE);
+}
+
+
+
+TEST(ParseInfoSuite, IdentifySchemeWide) {
+	const wchar_t * const text = L"HTTPS";
+	EXPECT_EQ(uriIdentifySchemeW(text, text + 5), URI_SCHEME_HTTPS);
+	EXPECT_EQ(uriIdentifySchemeW(text, text + 4), URI_SCHEME_HTTP);
+	EXPECT_EQ(uriIdentifySchemeW(text, text + 3), URI_SCHEME_UNKNOWN);
+}
+
+
+
+TEST(ParseInfoSuite, SchemeFastPath) {
+	EXPECT_EQ(parseInfoA("http://example.org/").scheme, URI_SCHEME_HTTP);
+	EXPECT_EQ(parseInfoA("HTTPS://example.org:443").scheme, URI_SCHEME_HTTPS);
+	EXPECT_EQ(parseInfoA("wss://example.org/chat").scheme, URI_SCHEME_WSS);
+	EXPECT_EQ(parseInfoA("gopher://example.org/").scheme, URI_SCHEME_UNKNOWN);
+}
+
+
+
+TEST(ParseInfoSuite, SchemeFullGrammar) {
+	EXPECT_EQ(parseInfoA("http://user@example.org/").scheme, URI_SCHEME_HTTP);
+	EXPECT_EQ(parseInfoA("Ftp://[::1]/").scheme, URI_SCHEME_FTP);
+	EXPECT_EQ(parseInfoA("file:///etc/hosts").scheme, URI_SCHEME_FILE);
+	EXPECT_EQ(parseInfoA("mailto:user@example.org").scheme, URI_SCHEME_MAILTO);
+	EXPECT_EQ(parseInfoA("urn:isbn:0451450523").scheme, URI_SCHEME_URN);
+	EXPECT_EQ(parseInfoA("data:,").scheme, URI_SCHEME_DATA);
+	EXPECT_EQ(parseInfoA("x-y:z").scheme, URI_SCHEME_UNKNOWN);
+	EXPECT_EQ(parseInfoA("http:").scheme, URI_SCHEME_HTTP);
+}
+
+
+
+TEST(ParseInfoSuite, SchemeRelativeReference) {
+	EXPECT_EQ(parseInfoA("").scheme, URI_SCHEME_NONE);
+	EXPECT_EQ(parseInfoA("//example.org/").scheme, URI_SCHEME_NONE);
+	EXPECT_EQ(parseInfoA("http/a:b").scheme, URI_SCHEME_NONE);
+	EXPECT_EQ(parseInfoA("?http:").scheme, URI_SCHEME_NONE);
+}
+
+
+
+TEST(ParseInfoSuite, NullInfo) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriInfoExA(&uri, "http://example.org/", NULL,
+			NULL, NULL), URI_SUCCESS);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ParseInfoSuite, SyntaxError) {
+	UriUriA uri;
+	UriParseInfo info;
+	const char * const text = "http://a b/";
+	const char * errorPos = NULL;
+	ASSERT_EQ(uriParseSingleUriInfoExA(&uri, text, NULL, &errorPos, &info),
+			URI_ERROR_SYNTAX);
+	EXPECT_EQ(errorPos, text + 8);
+}
+
+
+
+TEST(ParseInfoSuite, Port) {
+	// Fast path
+	EXPECT_EQ(parseInfoA("http://example.org:8080/").port, 8080u);
+	EXPECT_EQ(parseInfoA("http://example.org:08080").port, 8080u);
+	EXPECT_EQ(parseInfoA("http://example.org:65535").port, 65535u);
+	EXPECT_EQ(parseInfoA("http://example.org:").port, 0u);
+	EXPECT_EQ(parseInfoA("http://example.org/").port, 0u);
+	EXPECT_FALSE(parseInfoA("http://example.org:65535").portOverflow);
+	EXPECT_FALSE(parseInfoA("http://example.org/").portOverflow);
+
+	// Full grammar, after reg-name, IPv4 and IPv6 hosts
+	EXPECT_EQ(parseInfoA("http://user@example.org:8080/").port, 8080u);
+	EXPECT_EQ(parseInfoA("//example.org:8080").port, 8080u);
+	EXPECT_EQ(parseInfoA("//1.2.3.4:8080").port, 8080u);
+	EXPECT_EQ(parseInfoA("//[::1]:8080").port, 8080u);
+	EXPECT_EQ(parseInfoA("//[::1]").port, 0u);
+
+	// Not a port
+	EXPECT_EQ(parseInfoA("//user:123@example.org").port, 0u);
+}
+
+
+
+TEST(ParseInfoSuite, PortOverflow) {
+	const char * const texts[] = {
+		"http://example.org:65536/",
+		"http://user@example.org:65536/",
+		"//[::1]:65536",
+		"//a:99999999999999999999",
+	};
+	for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+		const UriParseInfo info = parseInfoA(texts[i]);
+		EXPECT_EQ(info.port, 0u) << texts[i];
+		EXPECT_TRUE(info.portOverflow) << texts[i];
+	}
+}
+
+
+
+TEST(ParseInfoSuite, ComponentFlags) {
+	const UriParseInfo info = parseInfoA(
+			"HTTP://us%65r@Example.ORG/a/./%C3%A4//../b?q=%7e#Frag");
+	EXPECT_EQ(info.schemeFlags, (unsigned int)URI_HAS_UPPERCASE);
+	EXPECT_EQ(info.userInfoFlags, (unsigned int)URI_HAS_PERCENT);
+	EXPECT_EQ(info.hostFlags, (unsigned int)URI_HAS_UPPERCASE);
+	EXPECT_EQ(info.pathFlags, (unsigned int)(URI_HAS_PERCENT | URI_HAS_UPPERCASE
+			| URI_HAS_NON_ASCII | URI_HAS_DOT_SEGMENT | URI_HAS_EMPTY_SEGMENT));
+	EXPECT_EQ(info.queryFlags, (unsigned int)URI_HAS_PERCENT);
+	EXPECT_EQ(info.fragmentFlags, (unsigned int)URI_HAS_UPPERCASE);
+}
+
+
+
+TEST(ParseInfoSuite, ComponentFlagsNothing) {
+	const UriParseInfo info = parseInfoA("http://example.org/a/b?c#d");
+	EXPECT_EQ(info.schemeFlags, (unsigned int)URI_HAS_NOTHING);
+	EXPECT_EQ(info.userInfoFlags, (unsigned int)URI_HAS_NOTHING);
+	EXPECT_EQ(info.hostFlags, (unsigned int)URI_HAS_NOTHING);
+	EXPECT_EQ(info.pathFlags, (unsigned int)URI_HAS_NOTHING);
+	EXPECT_EQ(info.queryFlags, (unsigned int)URI_HAS_NOTHING);
+	EXPECT_EQ(info.fragmentFlags, (unsigned int)URI_HAS_NOTHING);
+}
+
+
+
+TEST(ParseInfoSuite, ComponentFlagsIpHost) {
+	EXPECT_EQ(parseInfoA("//1.2.3.4").hostFlags, (unsigned int)URI_HAS_IP_HOST);
+	EXPECT_EQ(parseInfoA("//[::A]").hostFlags,
+			(unsigned int)(URI_HAS_IP_HOST | URI_HAS_UPPERCASE));
+	EXPECT_EQ(parseInfoA("//[v1.x]").hostFlags, (unsigned int)URI_HAS_IP_HOST);
+	EXPECT_EQ(parseInfoA("//1.2.3.256").hostFlags, (unsigned int)URI_HAS_NOTHING);
+}
+
+
+
+TEST(ParseInfoSuite, ComponentFlagsEmptySegment) {
+	EXPECT_EQ(parseInfoA("http://example.org/").pathFlags,
+			(unsigned int)URI_HAS_EMPTY_SEGMENT);
+	EXPECT_EQ(parseInfoA("a//b").pathFlags, (unsigned int)URI_HAS_EMPTY_SEGMENT);
+	EXPECT_EQ(parseInfoA("http://example.org").pathFlags,
+			(unsigned int)URI_HAS_NOTHING);
+}
+
+
+
+TEST(ParseInfoSuite, CollectComponentFlagsAfterSetPath) {
+	UriUriA uri;
+	UriParseInfo info;
+	const char * const path = "/%4A/..";
+	ASSERT_EQ(uriParseSingleUriInfoExA(&uri, "http://example.org/", NULL,
+			NULL, &info), URI_SUCCESS);
+	ASSERT_EQ(uriSetPathA(&uri, path, path + strlen(path)), URI_SUCCESS);
+
+	ASSERT_EQ(uriCollectComponentFlagsA(&uri, &info), URI_SUCCESS);
+	EXPECT_EQ(info.scheme, URI_SCHEME_HTTP);  // untouched
+	EXPECT_EQ(info.pathFlags, (unsigned int)(URI_HAS_PERCENT | URI_HAS_UPPERCASE
+			| URI_HAS_DOT_SEGMENT));
+	EXPECT_EQ(uriNormalizeSyntaxMaskFromInfoA(&uri, &info),
+			(unsigned int)URI_NORMALIZE_PATH);
+	uriFreeUriMembersA(&uri);
+
+	EXPECT_EQ(uriCollectComponentFlagsA(NULL, &info), URI_ERROR_NULL);
+	EXPECT_EQ(uriCollectComponentFlagsA(&uri, NULL), URI_ERROR_NULL);
+}
+
+
+
+TEST(ParseInfoSuite, NormalizeSyntaxMaskFromInfoIsSuperset) {
+	const char * const tokens[] = {
+		"http://", "HTTP://", "//", "/", ".", "..", "a", "B", "%41", "%7e",
+		"%7E", "%20", "%c3%a4", "@", ":", "0", "08", "[::A]", "1.2.3.4", "?", "#",
+	};
+	const size_t tokenCount = sizeof(tokens) / sizeof(tokens[0]);
+	std::mt19937 generator(20261018);
+	std::uniform_int_distribution<size_t> lengthDistribution(1, 8);
+	std::uniform_int_distribution<size_t> tokenDistribution(0, tokenCount - 1);
+	int checked = 0;
+
+	for (int i = 0; i < 50000; i++) {
+		std::string text;
+		const size_t length = lengthDistribution(generator);
+		for (size_t k = 0; k < length; k++) {
+			text += tokens[tokenDistribution(generator)];
+		}
+
+		UriUriA uri;
+		UriParseInfo info;
+		if (uriParseSingleUriInfoExA(&uri, text.c_str(), NULL, NULL, &info)
+				!= URI_SUCCESS) {
+			continue;
+		}
+		unsigned int required = 0;
+		ASSERT_EQ(uriNormalizeSyntaxMaskRequiredExA(&uri, &required), URI_SUCCESS);
+		const unsigned int fromInfo = uriNormalizeSyntaxMaskFromInfoA(&uri, &info);
+		ASSERT_EQ(required & ~fromInfo, 0u) << "Text: \"" << text << "\"";
+		if (fromInfo == URI_NORMALIZED) {
+			checked++;
+		}
+		uriFreeUriMembersA(&uri);
+	}
+	EXPECT_GT(checked, 0);
+}
+
+
+
+TEST(ParseInfoSuite, NormalizeSyntaxInfoSkipsNormalized) {
+	UriUriA uri;
+	UriParseInfo info;
+	ASSERT_EQ(uriParseSingleUriInfoExA(&uri, "http://example.org/a?b#c", NULL,
+			NULL, &info), URI_SUCCESS);
+	ASSERT_EQ(uriNormalizeSyntaxInfoA(&uri, &info), URI_SUCCESS);
+	EXPECT_EQ(uri.owner, URI_FALSE);  // nothing was touched
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ParseInfoSuite, NormalizeSyntaxInfoMatchesNormalizeSyntax) {
+	const char * const texts[] = {
+		"HTTP://Example.ORG:080/a/./b/../%7e?%2f#%3a",
+		"//@:123",
+		"a/../../b",
+		"http://[::A]/",
+	};
+	for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+		UriUriA expected;
+		ASSERT_EQ(uriParseSingleUriA(&expected, texts[i], NULL), URI_SUCCESS);
+		ASSERT_EQ(uriNormalizeSyntaxA(&expected), URI_SUCCESS);
+
+		UriUriA uri;
+		UriParseInfo info;
+		ASSERT_EQ(uriParseSingleUriInfoExA(&uri, texts[i], NULL, NULL, &info),
+				URI_SUCCESS);
+		ASSERT_EQ(uriNormalizeSyntaxInfoA(&uri, &info), URI_SUCCESS);
+		EXPECT_EQ(uriEqualsUriA(&uri, &expected), URI_TRUE) << texts[i];
+
+		// Flags were collected anew
+		EXPECT_EQ(info.schemeFlags & URI_HAS_UPPERCASE, 0u) << texts[i];
+		EXPECT_EQ(info.hostFlags & URI_HAS_UPPERCASE, 0u) << texts[i];
+
+		uriFreeUriMembersA(&expected);
+		uriFreeUriMembersA(&uri);
+	}
+
+	UriParseInfo info;
+	EXPECT_EQ(uriNormalizeSyntaxInfoA(NULL, &info), URI_ERROR_NULL);
+}
@@ -0,0 +1,168 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+struct Item {
+	std::string text;
+	std::string host;
+	int errorCode;
+	std::ptrdiff_t errorOffset;
+};
+
+
+
+struct Collector {
+	std::vector<Item> items;
+	size_t stopAfter;
+
+	Collector() : stopAfter((size_t)-1) {}
+};
+
+
+
+UriBool collect(void * userData, const UriUriA * uri, const char * first,
+		const char * afterLast, int errorCode, const char * errorPos) {
+	Collector * const collector = static_cast<Collector *>(userData);
+	Item item;
+	item.text = std::string(first, afterLast);
+	item.errorCode = errorCode;
+	item.errorOffset = -1;
+	if (errorCode == URI_SUCCESS) {
+		EXPECT_TRUE(uri != NULL);
+		EXPECT_TRUE(errorPos == NULL);
+		if ((uri != NULL) && (uri->hostText.first != NULL)) {
+			item.host = std::string(uri->hostText.first, uri->hostText.afterLast);
+		}
+	} else {
+		EXPECT_TRUE(uri == NULL);
+		item.errorOffset = errorPos - first;
+	}
+	collector->items.push_back(item);
+	return (collector->items.size() < collector->stopAfter) ? URI_TRUE : URI_FALSE;
+}
+
+}  // namespace
+
+
+
+TEST(ParseUriListSuite, Lines) {
+	const char * const text = "http://a.example/x\r\n"
+			"\n"
+			"  http://b.example/y \t\n"
+			"not a uri\n"
+			"/relative?q";
+	Collector collector;
+	ASSERT_EQ(uriParseUriListExA(text, NULL, URI_LIST_LINES, collect,
+			&collector), URI_SUCCESS);
+	ASSERT_EQ(collector.items.size(), 4U);
+	EXPECT_EQ(collector.items[0].text, "http://a.example/x");
+	EXPECT_EQ(collector.items[0].host, "a.example");
+	EXPECT_EQ(collector.items[1].text, "http://b.example/y");
+	EXPECT_EQ(collector.items[1].host, "b.example");
+	EXPECT_EQ(collector.items[2].text, "not a uri");
+	EXPECT_EQ(collector.items[2].errorCode, URI_ERROR_SYNTAX);
+	EXPECT_EQ(collector.items[2].errorOffset, 3);
+	EXPECT_EQ(collector.items[3].text, "/relative?q");
+	EXPECT_EQ(collector.items[3].errorCode, URI_SUCCESS);
+}
+
+
+
+TEST(ParseUriListSuite, Whitespace) {
+	const char * const text = " http://a.example\t\thttp://b.example\n\v"
+			"http://c.example%zz\fhttp://d.example ";
+	Collector collector;
+	ASSERT_EQ(uriParseUriListExA(text, NULL, URI_LIST_WHITESPACE, collect,
+			&collector), URI_SUCCESS);
+	ASSERT_EQ(collector.items.size(), 4U);
+	EXPECT_EQ(collector.items[0].host, "a.example");
+	EXPECT_EQ(collector.items[1].host, "b.example");
+	EXPECT_EQ(collector.items[2].errorCode, URI_ERROR_SYNTAX);
+	EXPECT_EQ(collector.items[2].errorOffset, 17);  // at "zz"
+	EXPECT_EQ(collector.items[3].host, "d.example");
+}
+
+
+
+TEST(ParseUriListSuite, Empty) {
+	Collector collector;
+	ASSERT_EQ(uriParseUriListExA("", NULL, URI_LIST_LINES, collect,
+			&collector), URI_SUCCESS);
+	ASSERT_EQ(uriParseUriListExA("\n\r\n \n", NULL, URI_LIST_LINES, collect,
+			&collector), URI_SUCCESS);
+	ASSERT_EQ(uriParseUriListExA(" \t\n", NULL, URI_LIST_WHITESPACE, collect,
+			&collector), URI_SUCCESS);
+	EXPECT_TRUE(collector.items.empty());
+}
+
+
+
+TEST(ParseUriListSuite, CallbackStops) {
+	Collector collector;
+	collector.stopAfter = 2;
+	ASSERT_EQ(uriParseUriListExA("a\nb\nc\nd", NULL, URI_LIST_LINES, collect,
+			&collector), URI_SUCCESS);
+	EXPECT_EQ(collector.items.size(), 2U);
+}
+
+
+
+TEST(ParseUriListSuite, NullParameters) {
+	Collector collector;
+	EXPECT_EQ(uriParseUriListExA(NULL, NULL, URI_LIST_LINES, collect,
+			&collector), URI_ERROR_NULL);
+	EXPECT_EQ(uriParseUriListExA("a", NULL, URI_LIST_LINES, NULL,
+			&collector), URI_ERROR_NULL);
+	EXPECT_EQ(uriParseUriListExMmA("a", NULL, URI_LIST_LINES, collect,
+			&collector, NULL), URI_ERROR_NULL);
+}
+
+
+
+namespace {
+
+UriBool countWide(void * userData, const UriUriW * uri, const wchar_t *,
+		const wchar_t *, int errorCode, const wchar_t *) {
+	if ((errorCode == URI_SUCCESS) && (uri->scheme.first != NULL)) {
+		(*static_cast<int *>(userData))++;
+	}
+	return URI_TRUE;
+}
+
+}  // namespace
+
+
+
+TEST(ParseUriListSuite, Wide) {
+	int count = 0;
+	ASSERT_EQ(uriParseUriListExW(L"http://a\nhttp://b\r\n", NULL,
+			URI_LIST_LINES, countWide, &count), URI_SUCCESS);
+	EXPECT_EQ(count, 2);
+}
@@ -0,0 +1,205 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+const char * const rules =
+		"// Excerpt in the format of https://publicsuffix.org/list/\n"
+		"\n"
+		"com\n"
+		"biz\n"
+		"uk\n"
+		"co.uk\n"
+		"jp\n"
+		"ac.jp\n"
+		"*.kobe.jp\n"
+		"!city.kobe.jp\n"
+		"*.ck\n"
+		"!www.ck\n"
+		"cn\n"
+		"\xE5\x85\xAC\xE5\x8F\xB8.cn\n"  // U+516C U+53F8
+		"// ===BEGIN PRIVATE DOMAINS===\n"
+		"  blogspot.com   trailing words are ignored\r\n"
+		"CO.UK\n";  // duplicate
+
+class PublicSuffixSuite : public ::testing::Test {
+protected:
+	UriPublicSuffixList * psl;
+
+	PublicSuffixSuite() : psl(NULL) {}
+
+	void SetUp() {
+		ASSERT_EQ(uriCompilePublicSuffixList(&psl, rules, NULL, NULL),
+				URI_SUCCESS);
+	}
+
+	void TearDown() {
+		uriFreePublicSuffixList(psl);
+	}
+
+	std::string registrableDomain(const char * host,
+			std::string * publicSuffix = NULL) {
+		const std::string uriString = std::string("http://") + host + "/";
+		UriUriA uri;
+		EXPECT_EQ(uriParseSingleIriExA(&uri, uriString.c_str(), NULL, NULL),
+				URI_SUCCESS);
+		UriTextRangeA domain;
+		UriTextRangeA suffix;
+		EXPECT_EQ(uriRegistrableDomainA(&uri, NULL, psl, &domain, &suffix),
+				URI_SUCCESS);
+		std::string result = "(none)";
+		if (domain.first != NULL) {
+			result = std::string(domain.first, domain.afterLast);
+		}
+		if (publicSuffix != NULL) {
+			*publicSuffix = (suffix.first != NULL)
+					? std::string(suffix.first, suffix.afterLast)
+					: "(none)";
+		}
+		uriFreeUriMembersA(&uri);
+		return result;
+	}
+};
+
+}  // namespace
+
+
+
+TEST_F(PublicSuffixSuite, NormalRules) {
+	std::string suffix;
+	EXPECT_EQ(registrableDomain("com"), "(none)");
+	EXPECT_EQ(registrableDomain("example.com", &suffix), "example.com");
+	EXPECT_EQ(suffix, "com");
+	EXPECT_EQ(registrableDomain("b.example.com"), "example.com");
+	EXPECT_EQ(registrableDomain("a.b.example.com"), "example.com");
+	EXPECT_EQ(registrableDomain("www.example.co.uk", &suffix), "example.co.uk");
+	EXPECT_EQ(suffix, "co.uk");
+	EXPECT_EQ(registrableDomain("co.uk"), "(none)");
+	EXPECT_EQ(registrableDomain("test.ac.jp"), "test.ac.jp");
+	EXPECT_EQ(registrableDomain("www.test.jp"), "test.jp");
+	EXPECT_EQ(registrableDomain("foo.blogspot.com"), "foo.blogspot.com");
+}
+
+TEST_F(PublicSuffixSuite, UnlistedTopLevelDomain) {
+	std::string suffix;
+	EXPECT_EQ(registrableDomain("example", &suffix), "(none)");
+	EXPECT_EQ(suffix, "example");
+	EXPECT_EQ(registrableDomain("b.example.example"), "example.example");
+}
+
+TEST_F(PublicSuffixSuite, WildcardAndExceptionRules) {
+	std::string suffix;
+	EXPECT_EQ(registrableDomain("kobe.jp"), "kobe.jp");
+	EXPECT_EQ(registrableDomain("c.kobe.jp"), "(none)");
+	EXPECT_EQ(registrableDomain("b.c.kobe.jp", &suffix), "b.c.kobe.jp");
+	EXPECT_EQ(suffix, "c.kobe.jp");
+	EXPECT_EQ(registrableDomain("city.kobe.jp", &suffix), "city.kobe.jp");
+	EXPECT_EQ(suffix, "kobe.jp");
+	EXPECT_EQ(registrableDomain("www.city.kobe.jp"), "city.kobe.jp");
+	EXPECT_EQ(registrableDomain("ck"), "(none)");
+	EXPECT_EQ(registrableDomain("test.ck"), "(none)");
+	EXPECT_EQ(registrableDomain("b.test.ck"), "b.test.ck");
+	EXPECT_EQ(registrableDomain("www.ck"), "www.ck");
+	EXPECT_EQ(registrableDomain("www.www.ck"), "www.ck");
+}
+
+TEST_F(PublicSuffixSuite, CaseTrailingDotAndUtf8) {
+	EXPECT_EQ(registrableDomain("WWW.Example.COM"), "Example.COM");
+	EXPECT_EQ(registrableDomain("www.example.com."), "example.com");
+	EXPECT_EQ(registrableDomain("\xE5\x85\xAC\xE5\x8F\xB8.cn"), "(none)");
+	EXPECT_EQ(registrableDomain("www.shishi.\xE5\x85\xAC\xE5\x8F\xB8.cn"),
+			"shishi.\xE5\x85\xAC\xE5\x8F\xB8.cn");
+}
+
+TEST_F(PublicSuffixSuite, WithLabelIndex) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "https://a.b.example.co.uk/", NULL),
+			URI_SUCCESS);
+	UriHostLabels labels;
+	ASSERT_EQ(uriIndexHostLabelsA(&uri, &labels), URI_SUCCESS);
+	UriTextRangeA domain;
+	ASSERT_EQ(uriRegistrableDomainA(&uri, &labels, psl, &domain, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(std::string(domain.first, domain.afterLast), "example.co.uk");
+	uriFreeUriMembersA(&uri);
+}
+
+TEST_F(PublicSuffixSuite, NonRegName) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://192.0.2.1/", NULL), URI_SUCCESS);
+	UriTextRangeA domain;
+	EXPECT_EQ(uriRegistrableDomainA(&uri, NULL, psl, &domain, NULL),
+			URI_ERROR_HOST_NOT_REGNAME);
+	EXPECT_EQ(uriRegistrableDomainA(&uri, NULL, NULL, &domain, NULL),
+			URI_ERROR_NULL);
+	uriFreeUriMembersA(&uri);
+}
+
+TEST_F(PublicSuffixSuite, Wide) {
+	UriUriW uri;
+	ASSERT_EQ(uriParseSingleUriW(&uri, L"http://www.Example.co.uk/", NULL),
+			URI_SUCCESS);
+	UriTextRangeW domain;
+	ASSERT_EQ(uriRegistrableDomainW(&uri, NULL, psl, &domain, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(std::wstring(domain.first, domain.afterLast), L"Example.co.uk");
+	uriFreeUriMembersW(&uri);
+}
+
+TEST(PublicSuffixCompileSuite, RejectsMalformedRules) {
+	const char * const malformed[] = {
+		"com\nfoo..bar\n",
+		"com\na.*.b\n",
+		"com\n!*.b\n",
+		"com\n.com\n",
+	};
+	for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+		UriPublicSuffixList * psl = NULL;
+		const char * errorPos = NULL;
+		EXPECT_EQ(uriCompilePublicSuffixList(&psl, malformed[i], NULL, &errorPos),
+				URI_ERROR_SYNTAX) << i;
+		EXPECT_EQ(errorPos, malformed[i] + 4) << i;
+		EXPECT_TRUE(psl == NULL);
+	}
+	EXPECT_EQ(uriCompilePublicSuffixList(NULL, "com", NULL, NULL),
+			URI_ERROR_NULL);
+}
+
+TEST(PublicSuffixCompileSuite, EmptyList) {
+	UriPublicSuffixList * psl = NULL;
+	ASSERT_EQ(uriCompilePublicSuffixList(&psl, "", NULL, NULL), URI_SUCCESS);
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://www.example.com/", NULL),
+			URI_SUCCESS);
+	UriTextRangeA domain;
+	ASSERT_EQ(uriRegistrableDomainA(&uri, NULL, psl, &domain, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(std::string(domain.first, domain.afterLast), "example.com");
+	uriFreeUriMembersA(&uri);
+	uriFreePublicSuffixList(psl);
+}
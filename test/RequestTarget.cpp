@@ -0,0 +1,667 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+void assertSegments(const UriUriA & uri,
+		const std::vector<std::string> & expected) {
+	std::vector<std::string> actual;
+	for (const UriPathSegmentA * walker = uri.pathHead; walker != NULL;
+			walker = walker->next) {
+		actual.push_back(std::string(walker->text.first,
+				walker->text.afterLast));
+	}
+	EXPECT_EQ(actual, expected);
+}
+
+
+
+void assertSameAsSingleUri(const std::string & text) {
+	const char * const first = text.c_str();
+	const char * const afterLast = first + text.size();
+	const char * errorPos = NULL;
+	UriUriA uri;
+	UriUriA uriSingle;
+
+	SCOPED_TRACE(text);
+	const int res = uriParseOriginFormExA(&uri, first, afterLast, &errorPos);
+	const int resSingle = uriParseSingleUriExA(&uriSingle, first, afterLast,
+			NULL);
+	const bool hasFragment = (text.find('#') != std::string::npos);
+	ASSERT_EQ(res == URI_SUCCESS, (resSingle == URI_SUCCESS) && !hasFragment);
+	if (res != URI_SUCCESS) {
+		EXPECT_EQ(res, URI_ERROR_SYNTAX);
+		EXPECT_TRUE((errorPos >= first) && (errorPos < afterLast));
+		if (resSingle == URI_SUCCESS) {
+			uriFreeUriMembersA(&uriSingle);
+		}
+		return;
+	}
+
+	EXPECT_EQ(uri.absolutePath, uriSingle.absolutePath);
+	EXPECT_EQ(uri.query.first, uriSingle.query.first);
+	EXPECT_EQ(uri.query.afterLast, uriSingle.query.afterLast);
+	EXPECT_TRUE(uri.scheme.first == NULL);
+	EXPECT_TRUE(uri.hostText.first == NULL);
+	EXPECT_TRUE(uri.fragment.first == NULL);
+
+	const UriPathSegmentA * segment = uri.pathHead;
+	const UriPathSegmentA * segmentSingle = uriSingle.pathHead;
+	while ((segment != NULL) && (segmentSingle != NULL)) {
+		EXPECT_EQ(segment->text.first, segmentSingle->text.first);
+		EXPECT_EQ(segment->text.afterLast, segmentSingle->text.afterLast);
+		if (segment->next == NULL) {
+			EXPECT_EQ(uri.pathTail, segment);
+		}
+		segment = segment->next;
+		segmentSingle = segmentSingle->next;
+	}
+	EXPECT_TRUE(segment == NULL);
+	EXPECT_TRUE(segmentSingle == NULL);
+
+	uriFreeUriMembersA(&uri);
+	uriFreeUriMembersA(&uriSingle);
+}
+
+void assertSameAsUriAuthority(const std::string & text) {
+	const std::string uriText = "http://" + text;
+	const char * const first = text.c_str();
+	const char * const afterLast = first + text.size();
+	const char * const uriFirst = uriText.c_str();
+	const char * errorPos = NULL;
+	UriAuthorityA authority;
+	UriUriA uri;
+
+	SCOPED_TRACE(text);
+	const int res = uriParseAuthorityExA(&authority, first, afterLast, &errorPos);
+	const int resUri = uriParseSingleUriExA(&uri, uriFirst,
+			uriFirst + uriText.size(), NULL);
+	const bool followedByPathEtc
+			= (text.find_first_of("/?#") != std::string::npos);
+	ASSERT_EQ(res == URI_SUCCESS, (resUri == URI_SUCCESS) && !followedByPathEtc);
+	if (res != URI_SUCCESS) {
+		EXPECT_EQ(res, URI_ERROR_SYNTAX);
+		EXPECT_TRUE((errorPos >= first) && (errorPos <= afterLast));
+		if (resUri == URI_SUCCESS) {
+			uriFreeUriMembersA(&uri);
+		}
+		return;
+	}
+
+	const std::ptrdiff_t shift = uriFirst + 7 - first;
+	if (text.empty()) {
+		EXPECT_EQ(authority.hostText.first, first);
+		EXPECT_EQ(authority.hostText.afterLast, first);
+	} else {
+		EXPECT_EQ(authority.hostText.first + shift, uri.hostText.first);
+		EXPECT_EQ(authority.hostText.afterLast + shift, uri.hostText.afterLast);
+	}
+	if (uri.userInfo.first == NULL) {
+		EXPECT_TRUE(authority.userInfo.first == NULL);
+	} else {
+		EXPECT_EQ(authority.userInfo.first + shift, uri.userInfo.first);
+		EXPECT_EQ(authority.userInfo.afterLast + shift, uri.userInfo.afterLast);
+	}
+	if (uri.portText.first == NULL) {
+		EXPECT_TRUE(authority.portText.first == NULL);
+	} else {
+		EXPECT_EQ(authority.portText.first + shift, uri.portText.first);
+		EXPECT_EQ(authority.portText.afterLast + shift, uri.portText.afterLast);
+	}
+	EXPECT_EQ(authority.hostType == URI_HOST_TYPE_IP4, uri.hostData.ip4 != NULL);
+	EXPECT_EQ(authority.hostType == URI_HOST_TYPE_IP6, uri.hostData.ip6 != NULL);
+	EXPECT_EQ(authority.hostType == URI_HOST_TYPE_IPFUTURE,
+			uri.hostData.ipFuture.first != NULL);
+
+	uriFreeUriMembersA(&uri);
+}
+
+}  // namespace
+
+
+
+TEST(ParseOriginFormSuite, Basic) {
+	const char * const text = "/a/b.html?c=d&e=/f?";
+	UriUriA uri;
+	ASSERT_EQ(uriParseOriginFormExA(&uri, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_TRUE(uri.absolutePath);
+	assertSegments(uri, {"a", "b.html"});
+	EXPECT_EQ(std::string(uri.query.first, uri.query.afterLast), "c=d&e=/f?");
+	EXPECT_TRUE(uri.fragment.first == NULL);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ParseOriginFormSuite, RootAndEmptySegments) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseOriginFormExA(&uri, "/", NULL, NULL), URI_SUCCESS);
+	EXPECT_TRUE(uri.absolutePath);
+	EXPECT_TRUE(uri.pathHead == NULL);
+	EXPECT_TRUE(uri.query.first == NULL);
+	uriFreeUriMembersA(&uri);
+
+	ASSERT_EQ(uriParseOriginFormExA(&uri, "/?", NULL, NULL), URI_SUCCESS);
+	EXPECT_TRUE(uri.pathHead == NULL);
+	EXPECT_TRUE(uri.query.first != NULL);
+	EXPECT_EQ(uri.query.first, uri.query.afterLast);
+	uriFreeUriMembersA(&uri);
+
+	ASSERT_EQ(uriParseOriginFormExA(&uri, "/a//b/", NULL, NULL), URI_SUCCESS);
+	assertSegments(uri, {"a", "", "b", ""});
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ParseOriginFormSuite, DoubleSlashIsPathNotAuthority) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseOriginFormExA(&uri, "//example.org/a", NULL, NULL),
+			URI_SUCCESS);
+	EXPECT_TRUE(uri.hostText.first == NULL);
+	EXPECT_TRUE(uri.absolutePath);
+	assertSegments(uri, {"", "example.org", "a"});
+	uriFreeUriMembersA(&uri);
+
+	ASSERT_EQ(uriParseOriginFormExA(&uri, "//", NULL, NULL), URI_SUCCESS);
+	assertSegments(uri, {"", ""});
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ParseOriginFormSuite, AsteriskForm) {
+	UriUriA uri;
+	ASSERT_EQ(uriParseOriginFormExA(&uri, "*", NULL, NULL), URI_SUCCESS);
+	EXPECT_FALSE(uri.absolutePath);
+	assertSegments(uri, {"*"});
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ParseOriginFormSuite, SyntaxErrors) {
+	const char * const cases[][2] = {
+		// text, expected error position (suffix of text)
+		{"", ""},
+		{"a/b", "a/b"},
+		{"http://example.org/", "http://example.org/"},
+		{"**", "**"},
+		{"*/", "*/"},
+		{"/a#b", "#b"},
+		{"/a?b#c", "#c"},
+		{"/a b", " b"},
+		{"/a?b c", " c"},
+		{"/%4g", "%4g"},
+		{"/%", "%"},
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		const char * const text = cases[i][0];
+		const char * errorPos = NULL;
+		UriUriA uri;
+		SCOPED_TRACE(text);
+		ASSERT_EQ(uriParseOriginFormExA(&uri, text, NULL, &errorPos),
+				URI_ERROR_SYNTAX);
+		EXPECT_STREQ(errorPos, cases[i][1]);
+	}
+}
+
+
+
+TEST(ParseOriginFormSuite, NullParameters) {
+	const char * const text = "/";
+	UriUriA uri;
+	EXPECT_EQ(uriParseOriginFormExA(NULL, text, NULL, NULL), URI_ERROR_NULL);
+	EXPECT_EQ(uriParseOriginFormExA(&uri, NULL, NULL, NULL), URI_ERROR_NULL);
+	EXPECT_EQ(uriParseOriginFormExMmA(&uri, text, NULL, NULL, NULL),
+			URI_ERROR_NULL);
+}
+
+
+
+TEST(ParseOriginFormSuite, Wide) {
+	const wchar_t * const text = L"/a?b";
+	UriUriW uri;
+	ASSERT_EQ(uriParseOriginFormExW(&uri, text, NULL, NULL), URI_SUCCESS);
+	ASSERT_TRUE(uri.pathHead != NULL);
+	EXPECT_EQ(uri.pathHead->text.first, text + 1);
+	EXPECT_EQ(uri.query.first, text + 3);
+	uriFreeUriMembersW(&uri);
+}
+
+
+
+TEST(ParseOriginFormSuite, SameAsSingleUriRandom) {
+	const char * const tokens[] = {
+		"a", "Z", "0", ".", "-", "_", "~", ":", "/", "?", "#", "@", "%",
+		"%4", "%41", "[", "]", "!", "+", "*", " ", "<", "\x80",
+	};
+	const size_t tokenCount = sizeof(tokens) / sizeof(tokens[0]);
+	std::mt19937 generator(20261018);
+	std::uniform_int_distribution<size_t> lengthDistribution(0, 8);
+	std::uniform_int_distribution<size_t> tokenDistribution(0, tokenCount - 1);
+
+	for (int i = 0; i < 100000; i++) {
+		std::string text = "/";
+		const size_t length = lengthDistribution(generator);
+		for (size_t k = 0; k < length; k++) {
+			text += tokens[tokenDistribution(generator)];
+		}
+		if (text.compare(0, 2, "//") == 0) {
+			continue;  // path for origin-form, authority for URI references
+		}
+		assertSameAsSingleUri(text);
+		if (HasFatalFailure()) {
+			return;
+		}
+	}
+}
+
+
+
+TEST(ParseAuthoritySuite, RegName) {
+	const char * const text = "user:pass@www.example.org:8080";
+	UriAuthorityA authority;
+	ASSERT_EQ(uriParseAuthorityExA(&authority, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(std::string(authority.userInfo.first, authority.userInfo.afterLast),
+			"user:pass");
+	EXPECT_EQ(std::string(authority.hostText.first, authority.hostText.afterLast),
+			"www.example.org");
+	EXPECT_EQ(std::string(authority.portText.first, authority.portText.afterLast),
+			"8080");
+	EXPECT_EQ(authority.hostType, URI_HOST_TYPE_REGNAME);
+}
+
+
+
+TEST(ParseAuthoritySuite, HostOnly) {
+	const char * const text = "example.org";
+	UriAuthorityA authority;
+	ASSERT_EQ(uriParseAuthorityExA(&authority, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_TRUE(authority.userInfo.first == NULL);
+	EXPECT_EQ(authority.hostText.first, text);
+	EXPECT_EQ(authority.hostText.afterLast, text + strlen(text));
+	EXPECT_TRUE(authority.portText.first == NULL);
+}
+
+
+
+TEST(ParseAuthoritySuite, Empty) {
+	const char * const text = "";
+	UriAuthorityA authority;
+	ASSERT_EQ(uriParseAuthorityExA(&authority, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(authority.hostType, URI_HOST_TYPE_REGNAME);
+	EXPECT_EQ(authority.hostText.first, text);
+	EXPECT_EQ(authority.hostText.afterLast, text);
+}
+
+
+
+TEST(ParseAuthoritySuite, Ip4) {
+	const char * const text = "127.0.0.1:443";
+	UriAuthorityA authority;
+	ASSERT_EQ(uriParseAuthorityExA(&authority, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(authority.hostType, URI_HOST_TYPE_IP4);
+	EXPECT_EQ(authority.ip4.data[0], 127);
+	EXPECT_EQ(authority.ip4.data[3], 1);
+	EXPECT_EQ(authority.hostText.afterLast, text + 9);
+	EXPECT_EQ(authority.portText.first, text + 10);
+}
+
+
+
+TEST(ParseAuthoritySuite, Ip6) {
+	const char * const text = "[::1]:443";
+	UriAuthorityA authority;
+	ASSERT_EQ(uriParseAuthorityExA(&authority, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(authority.hostType, URI_HOST_TYPE_IP6);
+	EXPECT_EQ(authority.ip6.data[15], 1);
+	EXPECT_EQ(std::string(authority.hostText.first, authority.hostText.afterLast),
+			"::1");
+	EXPECT_EQ(authority.portText.first, text + 6);
+}
+
+
+
+TEST(ParseAuthoritySuite, IpFuture) {
+	const char * const text = "[v7.host]";
+	UriAuthorityA authority;
+	ASSERT_EQ(uriParseAuthorityExA(&authority, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(authority.hostType, URI_HOST_TYPE_IPFUTURE);
+	EXPECT_EQ(std::string(authority.hostText.first, authority.hostText.afterLast),
+			"v7.host");
+}
+
+
+
+TEST(ParseAuthoritySuite, SyntaxErrors) {
+	const char * const cases[][2] = {
+		// text, expected error position (suffix of text)
+		{"example.org/", "/"},
+		{"example.org?", "?"},
+		{"example.org#", "#"},
+		{"exa mple.org", " mple.org"},
+		{"example.org:8x", ""},  // could still have been user info
+		{"a@b@c", "@c"},
+		{"[::1", ""},
+		{"[::1]x", "x"},
+		{"[zz]", "zz]"},
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		const char * const text = cases[i][0];
+		const char * errorPos = NULL;
+		UriAuthorityA authority;
+		SCOPED_TRACE(text);
+		ASSERT_EQ(uriParseAuthorityExA(&authority, text, NULL, &errorPos),
+				URI_ERROR_SYNTAX);
+		EXPECT_STREQ(errorPos, cases[i][1]);
+	}
+}
+
+
+
+TEST(ParseAuthoritySuite, NullParameters) {
+	const char * const text = "example.org";
+	UriAuthorityA authority;
+	EXPECT_EQ(uriParseAuthorityExA(NULL, text, NULL, NULL), URI_ERROR_NULL);
+	EXPECT_EQ(uriParseAuthorityExA(&authority, NULL, NULL, NULL), URI_ERROR_NULL);
+	EXPECT_EQ(uriParseAuthorityExMmA(&authority, text, NULL, NULL, NULL),
+			URI_ERROR_NULL);
+}
+
+
+
+TEST(ParseAuthoritySuite, Wide) {
+	const wchar_t * const text = L"example.org:80";
+	UriAuthorityW authority;
+	ASSERT_EQ(uriParseAuthorityExW(&authority, text, NULL, NULL), URI_SUCCESS);
+	EXPECT_EQ(authority.hostText.afterLast, text + 11);
+	EXPECT_EQ(authority.portText.first, text + 12);
+}
+
+
+
+TEST(ParseAuthoritySuite, SameAsUriAuthorityRandom) {
+	const char * const tokens[] = {
+		"a", "Z", "0", "1", "255", "256", ".", "-", "_", "~", ":", "@",
+		"[", "]", "::1", "v1.x", "%", "%41", "!", " ", "/", "?", "#",
+	};
+	const size_t tokenCount = sizeof(tokens) / sizeof(tokens[0]);
+	std::mt19937 generator(20261018);
+	std::uniform_int_distribution<size_t> lengthDistribution(0, 8);
+	std::uniform_int_distribution<size_t> tokenDistribution(0, tokenCount - 1);
+
+	for (int i = 0; i < 100000; i++) {
+		std::string text;
+		const size_t length = lengthDistribution(generator);
+		for (size_t k = 0; k < length; k++) {
+			text += tokens[tokenDistribution(generator)];
+		}
+		assertSameAsUriAuthority(text);
+		if (HasFatalFailure()) {
+			return;
+		}
+	}
+}
+
+
+
+namespace {
+
+struct OriginForm {
+	std::string requestTarget;
+	std::string host;
+	bool inPlace;
+	int charsWritten;
+};
+
+
+
+OriginForm toOriginForm(const UriUriA & uri, const char * text,
+		char * buffer, int maxChars) {
+	OriginForm result;
+	UriTextRangeA requestTarget;
+	UriTextRangeA host;
+	result.charsWritten = -1;
+	EXPECT_EQ(uriToOriginFormA(&uri, &requestTarget, &host, buffer, maxChars,
+			&result.charsWritten), URI_SUCCESS);
+	result.requestTarget = std::string(requestTarget.first,
+			requestTarget.afterLast);
+	result.host = std::string(host.first, host.afterLast);
+	result.inPlace = (host.first == strstr(text, result.host.c_str()))
+			&& (result.charsWritten == 0);
+	return result;
+}
+
+}  // namespace
+
+
+
+TEST(ToOriginFormSuite, InPlace) {
+	const char * const cases[][3] = {
+		// URI, request-target, host
+		{"http://user@www.example.org:8080/a/b?q=1#f", "/a/b?q=1", "www.example.org:8080"},
+		{"http://example.org/", "/", "example.org"},
+		{"http://example.org//?", "//?", "example.org"},
+		{"http://example.org/a//#", "/a//", "example.org"},
+		{"http://example.org//a", "//a", "example.org"},
+		{"http://example.org", "/", "example.org"},
+		{"http://example.org:/a", "/a", "example.org:"},
+		{"http://[::1]:80/a", "/a", "[::1]:80"},
+		{"http://[v7.x]/a", "/a", "[v7.x]"},
+		{"http://127.0.0.1/a", "/a", "127.0.0.1"},
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		const char * const text = cases[i][0];
+		char buffer[64];
+		UriUriA uri;
+		SCOPED_TRACE(text);
+		ASSERT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+		const OriginForm originForm = toOriginForm(uri, text, buffer,
+				sizeof(buffer));
+		EXPECT_EQ(originForm.requestTarget, cases[i][1]);
+		EXPECT_EQ(originForm.host, cases[i][2]);
+		EXPECT_TRUE(originForm.inPlace);
+		EXPECT_EQ(originForm.charsWritten, 0);
+		uriFreeUriMembersA(&uri);
+	}
+}
+
+
+
+TEST(ToOriginFormSuite, InPlaceWithoutBuffer) {
+	const char * const text = "http://example.org/a?b";
+	UriUriA uri;
+	UriTextRangeA requestTarget;
+	UriTextRangeA host;
+	ASSERT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	EXPECT_EQ(uriToOriginFormA(&uri, &requestTarget, &host, NULL, 0, NULL),
+			URI_SUCCESS);
+	EXPECT_EQ(requestTarget.first, text + 18);
+	EXPECT_EQ(requestTarget.afterLast, text + strlen(text));
+	EXPECT_EQ(host.first, text + 7);
+	EXPECT_EQ(host.afterLast, text + 18);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ToOriginFormSuite, UnanchoredEmptySegments) {
+	const char * const text = "http://example.org/a/";
+	char buffer[32];
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	const OriginForm originForm = toOriginForm(uri, text, buffer,
+			sizeof(buffer));
+	EXPECT_EQ(originForm.requestTarget, "/a/");
+	EXPECT_EQ(originForm.host, "example.org");
+	EXPECT_EQ(originForm.charsWritten, 14);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ToOriginFormSuite, QueryWithoutPath) {
+	const char * const text = "http://example.org?q";
+	char buffer[32];
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	const OriginForm originForm = toOriginForm(uri, text, buffer,
+			sizeof(buffer));
+	EXPECT_EQ(originForm.requestTarget, "/?q");
+	EXPECT_EQ(originForm.host, "example.org");
+	EXPECT_FALSE(originForm.inPlace);
+	EXPECT_EQ(originForm.charsWritten, 14);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ToOriginFormSuite, Normalized) {
+	const char * const text = "HTTP://[::A]:8080/%7e/./b?%7e#f";
+	char buffer[64];
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	ASSERT_EQ(uriNormalizeSyntaxA(&uri), URI_SUCCESS);
+	const OriginForm originForm = toOriginForm(uri, text, buffer,
+			sizeof(buffer));
+	EXPECT_EQ(originForm.requestTarget, "/~/b?~");
+	EXPECT_EQ(originForm.host, "[::a]:8080");
+	EXPECT_FALSE(originForm.inPlace);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ToOriginFormSuite, ResolvedAgainstBase) {
+	const char * const baseText = "http://example.org/a/";
+	const char * const relativeText = "b?c";
+	char buffer[64];
+	UriUriA base;
+	UriUriA relative;
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&base, baseText, NULL), URI_SUCCESS);
+	ASSERT_EQ(uriParseSingleUriA(&relative, relativeText, NULL), URI_SUCCESS);
+	ASSERT_EQ(uriAddBaseUriA(&uri, &relative, &base), URI_SUCCESS);
+	const OriginForm originForm = toOriginForm(uri, baseText, buffer,
+			sizeof(buffer));
+	EXPECT_EQ(originForm.requestTarget, "/a/b?c");
+	EXPECT_EQ(originForm.host, "example.org");
+	EXPECT_FALSE(originForm.inPlace);
+	uriFreeUriMembersA(&uri);
+	uriFreeUriMembersA(&relative);
+	uriFreeUriMembersA(&base);
+}
+
+
+
+TEST(ToOriginFormSuite, BufferTooSmall) {
+	const char * const text = "http://example.org?q";
+	UriUriA uri;
+	UriTextRangeA requestTarget;
+	UriTextRangeA host;
+	char buffer[32];
+	int charsRequired = 0;
+	ASSERT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS);
+	ASSERT_EQ(uriToStringCharsRequiredA(&uri, &charsRequired), URI_SUCCESS);
+	EXPECT_EQ(uriToOriginFormA(&uri, &requestTarget, &host, NULL, 0, NULL),
+			URI_ERROR_OUTPUT_TOO_LARGE);
+	EXPECT_EQ(uriToOriginFormA(&uri, &requestTarget, &host, buffer, 13, NULL),
+			URI_ERROR_OUTPUT_TOO_LARGE);
+	EXPECT_EQ(uriToOriginFormA(&uri, &requestTarget, &host, buffer, 14, NULL),
+			URI_SUCCESS);
+	EXPECT_LE(14, charsRequired + 1);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ToOriginFormSuite, Errors) {
+	UriUriA uri;
+	UriTextRangeA requestTarget;
+	UriTextRangeA host;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "/a?b", NULL), URI_SUCCESS);
+	EXPECT_EQ(uriToOriginFormA(&uri, &requestTarget, &host, NULL, 0, NULL),
+			URI_ERROR_TOORIGINFORM_HOST_NOT_SET);
+	EXPECT_EQ(uriToOriginFormA(NULL, &requestTarget, &host, NULL, 0, NULL),
+			URI_ERROR_NULL);
+	EXPECT_EQ(uriToOriginFormA(&uri, NULL, &host, NULL, 0, NULL),
+			URI_ERROR_NULL);
+	EXPECT_EQ(uriToOriginFormA(&uri, &requestTarget, NULL, NULL, 0, NULL),
+			URI_ERROR_NULL);
+	uriFreeUriMembersA(&uri);
+}
+
+
+
+TEST(ToOriginFormSuite, InPlaceSameAsCopyRandom) {
+	const char * const tokens[] = {
+		"a", "0", "1.2.3.4", "[::1]", "[v7.x]", ":", ":80", "@", "/", "//",
+		"?", "#", ".", "..", "%41",
+	};
+	const size_t tokenCount = sizeof(tokens) / sizeof(tokens[0]);
+	std::mt19937 generator(20261018);
+	std::uniform_int_distribution<size_t> lengthDistribution(0, 8);
+	std::uniform_int_distribution<size_t> tokenDistribution(0, tokenCount - 1);
+
+	for (int i = 0; i < 20000; i++) {
+		std::string text = "http://";
+		const size_t length = lengthDistribution(generator);
+		for (size_t k = 0; k < length; k++) {
+			text += tokens[tokenDistribution(generator)];
+		}
+		UriUriA uri;
+		if (uriParseSingleUriA(&uri, text.c_str(), NULL) != URI_SUCCESS) {
+			continue;
+		}
+		SCOPED_TRACE(text);
+		UriUriA copy;
+		ASSERT_EQ(uriCopyUriA(&copy, &uri), URI_SUCCESS);
+		ASSERT_TRUE(copy.owner);
+		int charsRequired = 0;
+		ASSERT_EQ(uriToStringCharsRequiredA(&uri, &charsRequired), URI_SUCCESS);
+
+		std::vector<char> buffer(charsRequired + 1);
+		std::vector<char> copyBuffer(charsRequired + 1);
+		const OriginForm originForm = toOriginForm(uri, text.c_str(),
+				buffer.data(), (int)buffer.size());
+		const OriginForm copyOriginForm = toOriginForm(copy, text.c_str(),
+				copyBuffer.data(), (int)copyBuffer.size());
+		EXPECT_EQ(originForm.requestTarget, copyOriginForm.requestTarget);
+		EXPECT_EQ(originForm.host, copyOriginForm.host);
+		EXPECT_EQ(originForm.requestTarget[0], '/');
+
+		uriFreeUriMembersA(&copy);
+		uriFreeUriMembersA(&uri);
+		if (HasFailure()) {
+			return;
+		}
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+bool sameOrigin(const char * a, const char * b) {
+	UriUriA uriA;
+	UriUriA uriB;
+	EXPECT_EQ(uriParseSingleUriA(&uriA, a, NULL), URI_SUCCESS);
+	EXPECT_EQ(uriParseSingleUriA(&uriB, b, NULL), URI_SUCCESS);
+	const UriBool res = uriSameOriginA(&uriA, &uriB);
+	EXPECT_EQ(uriSameOriginA(&uriB, &uriA), res);
+	uriFreeUriMembersA(&uriA);
+	uriFreeUriMembersA(&uriB);
+	return res == URI_TRUE;
+}
+
+bool isUnderBase(const char * uri, const char * base) {
+	UriUriA uriUri;
+	UriUriA uriBase;
+	EXPECT_EQ(uriParseSingleUriA(&uriUri, uri, NULL), URI_SUCCESS);
+	EXPECT_EQ(uriParseSingleUriA(&uriBase, base, NULL), URI_SUCCESS);
+	const UriBool res = uriIsUnderBaseA(&uriUri, &uriBase);
+	uriFreeUriMembersA(&uriUri);
+	uriFreeUriMembersA(&uriBase);
+	return res == URI_TRUE;
+}
+
+}  // namespace
+
+
+
+TEST(SameOriginSuite, IgnoresCaseAndNonOriginParts) {
+	EXPECT_TRUE(sameOrigin("http://example.com/a?b#c",
+			"HTTP://user@EXAMPLE.com/x"));
+	EXPECT_TRUE(sameOrigin("http://[v1.Ab]/", "http://[V1.aB]/"));
+}
+
+TEST(SameOriginSuite, DefaultPorts) {
+	EXPECT_TRUE(sameOrigin("http://example.com/", "http://example.com:80/"));
+	EXPECT_TRUE(sameOrigin("https://example.com:0443/", "https://example.com/"));
+	EXPECT_TRUE(sameOrigin("ws://example.com:/", "ws://example.com/"));
+	EXPECT_FALSE(sameOrigin("http://example.com/", "http://example.com:8080/"));
+	EXPECT_FALSE(sameOrigin("http://example.com:443/", "https://example.com/"));
+	EXPECT_FALSE(sameOrigin("http://example.com:65616/", "http://example.com:80/"));
+}
+
+TEST(SameOriginSuite, Hosts) {
+	EXPECT_TRUE(sameOrigin("http://[::1]/", "http://[0:0::1]/"));
+	EXPECT_TRUE(sameOrigin("http://127.0.0.1/", "http://127.0.0.1:80/"));
+	EXPECT_FALSE(sameOrigin("http://127.0.0.1/", "http://127.0.0.2/"));
+	EXPECT_FALSE(sameOrigin("http://127.0.0.1/", "http://[::ffff:127.0.0.1]/"));
+	EXPECT_FALSE(sameOrigin("http://example.com/", "http://example.com./"));
+	EXPECT_FALSE(sameOrigin("http://example.com/", "http://www.example.com/"));
+	EXPECT_FALSE(sameOrigin("http://example.com/", "https://example.com/"));
+}
+
+TEST(SameOriginSuite, OpaqueOrigins) {
+	UriUriA uri;
+	EXPECT_FALSE(sameOrigin("mailto:a@example.com", "mailto:a@example.com"));
+	EXPECT_FALSE(sameOrigin("/relative", "/relative"));
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://example.com/", NULL), URI_SUCCESS);
+	EXPECT_EQ(uriSameOriginA(&uri, NULL), URI_FALSE);
+	EXPECT_EQ(uriSameOriginA(NULL, NULL), URI_FALSE);
+	uriFreeUriMembersA(&uri);
+}
+
+TEST(IsUnderBaseSuite, Segments) {
+	EXPECT_TRUE(isUnderBase("https://example.com/docs", "https://example.com/docs"));
+	EXPECT_TRUE(isUnderBase("https://example.com/docs/a", "https://example.com/docs"));
+	EXPECT_FALSE(isUnderBase("https://example.com/docsx", "https://example.com/docs"));
+	EXPECT_TRUE(isUnderBase("https://example.com/docs/", "https://example.com/docs/"));
+	EXPECT_TRUE(isUnderBase("https://example.com/docs/a/b?q#f", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com/docs", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com/Docs/a", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com/", "https://example.com/docs/"));
+}
+
+TEST(IsUnderBaseSuite, Root) {
+	EXPECT_TRUE(isUnderBase("https://example.com", "https://example.com/"));
+	EXPECT_TRUE(isUnderBase("https://example.com/a/b", "https://example.com/"));
+	EXPECT_TRUE(isUnderBase("https://example.com/a", "https://example.com"));
+}
+
+TEST(IsUnderBaseSuite, RequiresSameOrigin) {
+	EXPECT_TRUE(isUnderBase("HTTPS://Example.com:443/docs/a", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("http://example.com/docs/a", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com.evil/docs/a", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com:8443/docs/a", "https://example.com/docs/"));
+}
+
+TEST(IsUnderBaseSuite, DotSegments) {
+	EXPECT_FALSE(isUnderBase("https://example.com/docs/../admin", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com/docs/%2E%2e/admin", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com/docs/./a", "https://example.com/docs/"));
+	EXPECT_FALSE(isUnderBase("https://example.com/docs/a", "https://example.com/x/../docs/"));
+	EXPECT_TRUE(isUnderBase("https://example.com/docs/...", "https://example.com/docs/"));
+	EXPECT_TRUE(isUnderBase("https://example.com/docs/.a", "https://example.com/docs/"));
+}
@@ -0,0 +1,221 @@
+/*
+ * uriparser - RFC 3986 URI parsing library
+ *
+ * Copyright (C) 2026, Sebastian Pipping <sebastian@pipping.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <uriparser/Uri.h>
+
+
+
+namespace {
+
+UriUint64 hashOf(const char * text, UriUint64 seed = 0) {
+	UriUriA uri;
+	UriUint64 hash = 0;
+	EXPECT_EQ(uriParseSingleUriA(&uri, text, NULL), URI_SUCCESS) << text;
+	EXPECT_EQ(uriNormalizedHashA(&uri, seed, &hash), URI_SUCCESS) << text;
+	uriFreeUriMembersA(&uri);
+	return hash;
+}
+
+// SplitMix64, to get well-distributed keys for the filter
+UriUint64 key(UriUint64 index) {
+	UriUint64 value = index + 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+}  // namespace
+
+
+
+TEST(NormalizedHashSuite, EquivalentUrisAgree) {
+	const char * const pairs[][2] = {
+		{"HTTP://Example.COM/a", "http://example.com/a"},
+		{"http://Ex%61mple.COM/a", "http://example.com/a"},
+		{"http://example.com:80/a", "http://example.com/a"},
+		{"http://example.com:/a", "http://example.com/a"},
+		{"http://example.com", "http://example.com/"},
+		{"http://example.com/a#top", "http://example.com/a"},
+		{"http://example.com/a/./b/../c", "http://example.com/a/c"},
+		{"http://example.com/%7e?%2f", "http://example.com/%7E?%2F"},
+		{"http://[0::1]/", "http://[::1]/"},
+		{"mailto:Someone@example.com", "MAILTO:Someone@example.com"},
+	};
+	for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+		EXPECT_EQ(hashOf(pairs[i][0]), hashOf(pairs[i][1])) << pairs[i][0];
+	}
+}
+
+TEST(NormalizedHashSuite, DifferentUrisDiffer) {
+	const char * const uris[] = {
+		"http://example.com/",
+		"https://example.com/",
+		"http://example.com:8080/",
+		"http://example.org/",
+		"http://user@example.com/",
+		"http://example.com/A",
+		"http://example.com/a",
+		"http://example.com/a/",
+		"http://example.com//a",
+		"http://example.com/?",
+		"http://example.com/?a",
+		"http://example.com/?A",
+		"/a",
+		"a",
+		"//a",
+		"",
+	};
+	const size_t count = sizeof(uris) / sizeof(uris[0]);
+	std::vector<UriUint64> hashes;
+	for (size_t i = 0; i < count; i++) {
+		hashes.push_back(hashOf(uris[i]));
+	}
+	for (size_t i = 0; i < count; i++) {
+		for (size_t k = i + 1; k < count; k++) {
+			EXPECT_NE(hashes[i], hashes[k]) << uris[i] << " vs " << uris[k];
+		}
+	}
+}
+
+TEST(NormalizedHashSuite, SeedAndInputUnchanged) {
+	EXPECT_NE(hashOf("http://example.com/", 0), hashOf("http://example.com/", 1));
+
+	UriUriA uri;
+	ASSERT_EQ(uriParseSingleUriA(&uri, "http://example.com/a/../b?%7e", NULL),
+			URI_SUCCESS);
+	UriUint64 hash = 0;
+	ASSERT_EQ(uriNormalizedHashA(&uri, 0, &hash), URI_SUCCESS);
+	EXPECT_EQ(hash, hashOf("http://example.com/b?%7E"));
+	EXPECT_EQ(uri.pathHead->next->next->text.first[0], 'b');  // still there
+	EXPECT_EQ(uri.query.first[1], '7');
+	EXPECT_EQ(uri.query.first[2], 'e');
+	uriFreeUriMembersA(&uri);
+
+	EXPECT_EQ(uriNormalizedHashA(NULL, 0, &hash), URI_ERROR_NULL);
+}
+
+TEST(NormalizedHashSuite, WideAgrees) {
+	UriUriW uri;
+	ASSERT_EQ(uriParseSingleUriW(&uri, L"HTTP://example.com/a/./b?q#f", NULL),
+			URI_SUCCESS);
+	UriUint64 hash = 0;
+	ASSERT_EQ(uriNormalizedHashW(&uri, 0, &hash), URI_SUCCESS);
+	EXPECT_EQ(hash, hashOf("http://example.com/a/b?q"));
+	uriFreeUriMembersW(&uri);
+}
+
+
+
+TEST(SeenFilterSuite, InsertAndContains) {
+	UriSeenFilter * filter = NULL;
+	ASSERT_EQ(uriCreateSeenFilter(&filter, 1000, 0.01), URI_SUCCESS);
+
+	const UriUint64 hash = hashOf("http://example.com/");
+	EXPECT_EQ(uriSeenFilterContains(filter, hash), URI_FALSE);
+	EXPECT_EQ(uriSeenFilterInsert(filter, hash), URI_FALSE);
+	EXPECT_EQ(uriSeenFilterInsert(filter, hash), URI_TRUE);
+	EXPECT_EQ(uriSeenFilterContains(filter, hash), URI_TRUE);
+	EXPECT_EQ(uriSeenFilterContains(filter, hashOf("HTTP://EXAMPLE.COM:80")),
+			URI_TRUE);
+
+	uriFreeSeenFilter(filter);
+}
+
+TEST(SeenFilterSuite, FalsePositiveRate) {
+	const double rates[] = {0.1, 0.01, 0.001};
+	const int count = 20000;
+	size_t previousSize = 0;
+	for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+		UriSeenFilter * filter = NULL;
+		ASSERT_EQ(uriCreateSeenFilter(&filter, count, rates[r]), URI_SUCCESS);
+		EXPECT_GT(uriSeenFilterByteSize(filter), previousSize);
+		previousSize = uriSeenFilterByteSize(filter);
+
+		for (int i = 0; i < count; i++) {
+			uriSeenFilterInsert(filter, key(i));
+		}
+		for (int i = 0; i < count; i++) {
+			ASSERT_EQ(uriSeenFilterContains(filter, key(i)), URI_TRUE);
+		}
+
+		const int probes = 200000;
+		int falsePositives = 0;
+		for (int i = 0; i < probes; i++) {
+			falsePositives += uriSeenFilterContains(filter, key(count + i));
+		}
+		const double measured = static_cast<double>(falsePositives) / probes;
+		EXPECT_LT(measured, rates[r] * 1.5) << rates[r];
+		EXPECT_GT(measured, rates[r] / 4) << rates[r];  // not oversized
+
+		uriFreeSeenFilter(filter);
+	}
+}
+
+TEST(SeenFilterSuite, ConcurrentInserts) {
+	const int threadCount = 4;
+	const int perThread = 10000;
+	UriSeenFilter * filter = NULL;
+	ASSERT_EQ(uriCreateSeenFilter(&filter, threadCount * perThread, 0.01),
+			URI_SUCCESS);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; t++) {
+		threads.push_back(std::thread([filter, t, perThread]() {
+			for (int i = 0; i < perThread; i++) {
+				uriSeenFilterInsert(filter, key(t * perThread + i));
+			}
+		}));
+	}
+	for (size_t t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+
+	for (int i = 0; i < threadCount * perThread; i++) {
+		ASSERT_EQ(uriSeenFilterContains(filter, key(i)), URI_TRUE) << i;
+	}
+	uriFreeSeenFilter(filter);
+}
+
+TEST(SeenFilterSuite, InvalidArguments) {
+	UriSeenFilter * filter = NULL;
+	EXPECT_EQ(uriCreateSeenFilter(NULL, 10, 0.01), URI_ERROR_NULL);
+	EXPECT_EQ(uriCreateSeenFilter(&filter, 10, 0.0), URI_ERROR_SEENFILTER_RATE_INVALID);
+	EXPECT_EQ(uriCreateSeenFilter(&filter, 10, 1.0), URI_ERROR_SEENFILTER_RATE_INVALID);
+	EXPECT_EQ(uriCreateSeenFilter(&filter, 10, std::nan("")),
+			URI_ERROR_SEENFILTER_RATE_INVALID);
+	EXPECT_TRUE(filter == NULL);
+	EXPECT_EQ(uriCreateSeenFilter(&filter, 0xFFFFFFFFFFFFULL, 0.01),
+			URI_ERROR_OUTPUT_TOO_LARGE);
+
+	// Tiny rates are capped rather than refused
+	ASSERT_EQ(uriCreateSeenFilter(&filter, 0, 1e-30), URI_SUCCESS);
+	EXPECT_EQ(uriSeenFilterInsert(filter, 1), URI_FALSE);
+	uriFreeSeenFilter(filter);
+
+	EXPECT_EQ(uriSeenFilterInsert(NULL, 1), URI_FALSE);
+	EXPECT_EQ(uriSeenFilterContains(NULL, 1), URI_FALSE);
+	EXPECT_EQ(uriSeenFilterByteSize(NULL), 0u);
+}
@@ -78,6 +78,58 @@ TEST(IsWellFormedPort, ForbiddenCharacters) {
 	testIsWellFormedPort(" ", false);
 }
 
+static void testParsePortValue(const char * candidate, int expectedResult,
+		unsigned int expectedValue) {
+	unsigned int value = 12345;
+
+	ASSERT_EQ(uriParsePortValueA(&value, candidate, candidate + strlen(candidate)),
+			expectedResult);
+
+	ASSERT_EQ(value, expectedValue);
+}
+
+TEST(ParsePortValue, Null) {
+	unsigned int value;
+	const char * const text = "80";
+	EXPECT_EQ(uriParsePortValueA(NULL, text, text + 2), URI_ERROR_NULL);
+	EXPECT_EQ(uriParsePortValueA(&value, NULL, text + 2), URI_ERROR_NULL);
+	EXPECT_EQ(uriParsePortValueA(&value, text, NULL), URI_ERROR_NULL);
+}
+
+TEST(ParsePortValue, Values) {
+	testParsePortValue("", URI_SUCCESS, 0);
+	testParsePortValue("0", URI_SUCCESS, 0);
+	testParsePortValue("80", URI_SUCCESS, 80);
+	testParsePortValue("0080", URI_SUCCESS, 80);
+	testParsePortValue("65535", URI_SUCCESS, 65535);
+	testParsePortValue("000000000000000000000065535", URI_SUCCESS, 65535);
+}
+
+TEST(ParsePortValue, OutOfRange) {
+	testParsePortValue("65536", URI_ERROR_PORT_OUT_OF_RANGE, 0);
+	testParsePortValue("99999999999999999999999", URI_ERROR_PORT_OUT_OF_RANGE, 0);
+}
+
+TEST(ParsePortValue, ForbiddenCharacters) {
+	testParsePortValue("8o", URI_ERROR_SYNTAX, 0);
+	testParsePortValue("99999999999x", URI_ERROR_SYNTAX, 0);
+	testParsePortValue("-1", URI_ERROR_SYNTAX, 0);
+}
+
+TEST(ParsePortValue, AfterSetPortText) {
+	UriUriA uri = parseWellFormedUri("https://host:443/");
+	const char * const first = "8443";
+	unsigned int value = 0;
+
+	ASSERT_EQ(uriSetPortTextA(&uri, first, first + strlen(first)), URI_SUCCESS);
+
+	EXPECT_EQ(uriParsePortValueA(&value, uri.portText.first, uri.portText.afterLast),
+			URI_SUCCESS);
+	EXPECT_EQ(value, 8443u);
+
+	uriFreeUriMembersA(&uri);
+}
+
 TEST(SetPortText, NullUriOnly) {
 	UriUriA * const uri = NULL;
 	const char * const first = "443";